@@ -390,7 +390,14 @@ $gM->addDepUnit("testMain", ["test","build","visit","chip","t1Upgrade",
                              "simMC","transport","scatMat","crystal","endf",
 			     "mersenne","src","work","xml","poly","support",
 			     "world","weights","md5","global","attachComp",
-			     "insertUnit","visit","poly","essConstruct"]);
+			     "insertUnit","visit","poly","essConstruct",
+			     "essBuild","beamline","instrument","constructVar",
+                             "beer","bifrost","cspec","dream","estia",
+			     "freia","heimdal","loki","magic","miracles",
+			     "nmx","nnbar","odin","skadi","testBeam",
+			     "trex","vor","vespa","common",
+			     "shortDream","shortNmx","shortOdin","longLoki",
+			     "commonVar","simpleItem"]);
 
 $gM->writeCMake();
 
@@ -195,6 +195,7 @@ sub setParameters
 	  $self->{optimise}.=" -O2 " if ($Ostr eq "-O");
 	  push(@{$self->{definitions}},"NO_REGEX") if ($Ostr eq "-NR");
 	  $self->{noregex}=1 if ($Ostr eq "-NR");
+	  push(@{$self->{definitions}},"MEMSTACK") if ($Ostr eq "-MS");
 	  $self->{optimise}.=" -pg " if ($Ostr eq "-p"); ## Gprof
 	  $self->{gcov}=1 if ($Ostr eq "-C");
 	  $self->{gtk}=1 if ($Ostr eq "-gtk");
@@ -325,6 +326,7 @@ sub writeExcutables
       print $DX "target_link_libraries(",$item," gsl)\n";
       print $DX "target_link_libraries(",$item," gslcblas)\n";
       print $DX "target_link_libraries(",$item," m)\n";
+      print $DX "target_link_libraries(",$item," pthread)\n";
     }
   
   
@@ -116,6 +116,7 @@
 #include "testDBMaterial.h"
 #include "testDoubleErr.h"
 #include "testElement.h"
+#include "testENDF.h"
 #include "testEllipticCyl.h"
 #include "testExtControl.h"
 #include "testFace.h"
@@ -131,6 +132,7 @@
 #include "testLog.h"
 #include "testMapRange.h"
 #include "testMapSupport.h"
+#include "testMarkovProcess.h"
 #include "testMasterRotate.h"
 #include "testMaterial.h"
 #include "testMathSupport.h"
@@ -176,6 +178,7 @@
 #include "testTally.h"
 #include "testVarNameOrder.h"
 #include "testVec3D.h"
+#include "testVisit.h"
 #include "testVolumes.h"
 #include "testWorkData.h"
 #include "testWrapper.h"
@@ -904,6 +907,7 @@ physicsTest(const int type,const int extra)
     {
       TestFunc::Instance().reportTest(std::cout);
       std::cout<<"testExtControl    (1)"<<std::endl;
+      std::cout<<"testENDF          (2)"<<std::endl;
     }
   if(type==1 || type<0)
     {
@@ -911,6 +915,12 @@ physicsTest(const int type,const int extra)
       const int X=A.applyTest(extra);
       if (X) return X;
     }
+  if(type==2 || type<0)
+    {
+      testENDF A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
   return 0;
 
 }
@@ -930,22 +940,24 @@ processTest(const int type,const int extra)
       std::cout<<"testBoxLine          (1)"<<std::endl;
       std::cout<<"testInputParam       (2)"<<std::endl;
       std::cout<<"testLineTrack        (3)"<<std::endl;
-      std::cout<<"testObjectRegister   (4)"<<std::endl;
-      std::cout<<"testObjectTrackAct   (5)"<<std::endl;
-      std::cout<<"testObjSurfMap       (6)"<<std::endl;
-      std::cout<<"testObjTrackItem     (7)"<<std::endl;
-      std::cout<<"testPairFactory      (8)"<<std::endl;
-      std::cout<<"testPairItem         (9)"<<std::endl;
-      std::cout<<"testPipeLine        (10)"<<std::endl;
-      std::cout<<"testPipeUnit        (11)"<<std::endl;
-      std::cout<<"testSimpleObj       (12)"<<std::endl;
-      std::cout<<"testSurfDIter       (13)"<<std::endl;
-      std::cout<<"testSurfDivide      (14)"<<std::endl;
-      std::cout<<"testSurfEqual       (15)"<<std::endl;
-      std::cout<<"testSurfExpand      (16)"<<std::endl;
-      std::cout<<"testSurfRegister    (17)"<<std::endl;
-      std::cout<<"testVolumes         (18)"<<std::endl;
-      std::cout<<"testWrapper         (19)"<<std::endl;
+      std::cout<<"testMarkovProcess    (4)"<<std::endl;
+      std::cout<<"testObjectRegister   (5)"<<std::endl;
+      std::cout<<"testObjectTrackAct   (6)"<<std::endl;
+      std::cout<<"testObjSurfMap       (7)"<<std::endl;
+      std::cout<<"testObjTrackItem     (8)"<<std::endl;
+      std::cout<<"testPairFactory      (9)"<<std::endl;
+      std::cout<<"testPairItem        (10)"<<std::endl;
+      std::cout<<"testPipeLine        (11)"<<std::endl;
+      std::cout<<"testPipeUnit        (12)"<<std::endl;
+      std::cout<<"testSimpleObj       (13)"<<std::endl;
+      std::cout<<"testSurfDIter       (14)"<<std::endl;
+      std::cout<<"testSurfDivide      (15)"<<std::endl;
+      std::cout<<"testSurfEqual       (16)"<<std::endl;
+      std::cout<<"testSurfExpand      (17)"<<std::endl;
+      std::cout<<"testSurfRegister    (18)"<<std::endl;
+      std::cout<<"testVisit           (19)"<<std::endl;
+      std::cout<<"testVolumes         (20)"<<std::endl;
+      std::cout<<"testWrapper         (21)"<<std::endl;
     }
   int index(1);
   if(type==index || type<0)
@@ -972,6 +984,14 @@ processTest(const int type,const int extra)
     }
   index++;
   
+  if(type==index || type<0)
+    {
+      testMarkovProcess A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+  index++;
+  
   if(type==index || type<0)
     {
       testObjectRegister A;
@@ -1084,6 +1104,14 @@ processTest(const int type,const int extra)
     }
   index++;
   
+  if(type==index || type<0)
+    {
+      testVisit A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+  index++;
+  
   if(type==index || type<0)
     {
       testVolumes A;
@@ -669,6 +669,21 @@ Reflector::getExclude() const
   return Out;
 }
 
+HeadRule
+Reflector::getExcludeRule() const 
+  /*!
+    Virtual function to add the cooling pads
+    \return Full Exlcude rule
+  */
+{
+  ELog::RegMethod RegA("Reflector","getExcludeRule");
+
+  HeadRule Out=ContainedComp::getExcludeRule();
+  for(const CoolPad& PD : Pads)
+    Out.addIntersection(PD.getExclude());
+  return Out;
+}
+
 void
 Reflector::createAll(Simulation& System,
 		     const mainSystem::inputParam& IParam)
@@ -45,6 +45,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "support.h"
 #include "Surface.h"
 #include "Quadratic.h"
@@ -339,7 +340,7 @@ addToInsertControl(Simulation& System,
                        "addToInsertControl(CM,string,FC,CC)");
 
   const std::vector<Geometry::Vec3D> linkPts=FC.getAllLinkPts();
-  const std::string excludeStr=CC.getExclude();
+  const HeadRule excludeRule=CC.getExcludeRule();
 
   for(const int cN : BaseObj.getCells(cellName))
     {
@@ -351,7 +352,7 @@ addToInsertControl(Simulation& System,
 	    {
 	      if (CRPtr->isValid(IP))
 		{
-		  CRPtr->addSurfString(excludeStr);
+		  CRPtr->addSurfRule(excludeRule);
 		  break;
 		}
 	    }
@@ -381,7 +382,7 @@ addToInsertControl(Simulation& System,
   ELog::RegMethod RegA("AttachSupport","addToInsertControl");
 
   const std::vector<Geometry::Vec3D> linkPts=FC.getAllLinkPts();
-  const std::string excludeStr=CC.getExclude();
+  const HeadRule excludeRule=CC.getExcludeRule();
 
   for(int i=cellA+1;i<=cellB;i++)
     {
@@ -393,7 +394,7 @@ addToInsertControl(Simulation& System,
 	    {
 	      if (CRPtr->isValid(IP))
 		{
-		  CRPtr->addSurfString(excludeStr);
+		  CRPtr->addSurfRule(excludeRule);
 		  break;
 		}
 	    }
@@ -594,7 +595,13 @@ bool
 checkIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
 	       const std::vector<const Geometry::Surface*>& CellSVec)
    /*
-     Determine if the surface group is in the Contained Component
+     Determine if the surface group is in the Contained Component.
+     Only points within both the cell box and the ContainedComp
+     box can be valid : disjoint boxes are rejected and surfaces 
+     that miss the overlap box are not used. The vertex test of
+     the ContainedComp surfaces only needs the cell box.
+     [Boxes are only bounded by exactly axis aligned surfaces
+     (HeadRule::calcBoundBox) so no part of a cell is pruned].
      \param CC :: Contained Component
      \param CellObj :: Cell Object
      \param CellSVec :: Cell vector
@@ -603,48 +610,73 @@ checkIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
 {
   ELog::RegMethod RegA("AttachSupport","checkInsert");
   //  ELog::debugMethod DegA;
-  const std::vector<Geometry::Surface*>& SVec=CC.getSurfaces(); 
+
+  // padding for the surface tolerance in the valid tests
+  const double boxPad(1e-3);
+  Geometry::BoundBox OBox=CC.getBoundBox();
+  Geometry::BoundBox CellBox=CellObj.getBoundBox();
+  OBox.pad(boxPad);
+  CellBox.pad(boxPad);
+  OBox.intersect(CellBox);
+
+  std::vector<const Geometry::Surface*> SVec;
+  std::vector<const Geometry::Surface*> SCellVec;
+  for(const Geometry::Surface* SPtr : CC.getSurfaces())
+    {
+      if (OBox.isCut(*SPtr))
+	SVec.push_back(SPtr);
+      if (CellBox.isCut(*SPtr))
+	SCellVec.push_back(SPtr);
+    }
+  std::vector<const Geometry::Surface*> CVec;
+  for(const Geometry::Surface* SPtr : CellSVec)
+    if (OBox.isCut(*SPtr))
+      CVec.push_back(SPtr);
+  
   std::vector<Geometry::Vec3D> Out;
   std::vector<Geometry::Vec3D>::const_iterator vc;
 
   for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=0;iB<CellSVec.size();iB++)
-      for(size_t iC=iB+1;iC<CellSVec.size();iC++)
+    for(size_t iB=0;iB<CVec.size();iB++)
+      for(size_t iC=iB+1;iC<CVec.size();iC++)
 	{	      
-	  Out=SurInter::processPoint(SVec[iA],CellSVec[iB],CellSVec[iC]);
+	  Out=SurInter::processPoint(SVec[iA],CVec[iB],CVec[iC]);
 	  for(vc=Out.begin();vc!=Out.end();vc++)
 	    {
+	      if (!OBox.isValid(*vc)) continue;
 	      std::set<int> boundarySet;
-	      boundarySet.insert(CellSVec[iB]->getName());
-	      boundarySet.insert(CellSVec[iC]->getName());		  
+	      boundarySet.insert(CVec[iB]->getName());
+	      boundarySet.insert(CVec[iC]->getName());		  
 	      // Outer valid returns true if out of object
 	      if (CellObj.isValid(*vc,boundarySet) &&
 		  !CC.isOuterValid(*vc,SVec[iA]->getName()))
 		return 1;
 	    }
 	}
-  for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=iA+1;iB<SVec.size();iB++)
-      for(size_t iC=iB+1;iC<SVec.size();iC++)
+  for(size_t iA=0;iA<SCellVec.size();iA++)
+    for(size_t iB=iA+1;iB<SCellVec.size();iB++)
+      for(size_t iC=iB+1;iC<SCellVec.size();iC++)
 	{
-	  Out=SurInter::processPoint(SVec[iA],SVec[iB],SVec[iC]);
+	  Out=SurInter::processPoint(SCellVec[iA],SCellVec[iB],
+				     SCellVec[iC]);
 	  for(vc=Out.begin();vc!=Out.end();vc++)
 	    {
-	      if (CellObj.isValid(*vc))
+	      if (CellBox.isValid(*vc) && CellObj.isValid(*vc))
 		return 1;
 	    }
 	}
   for(size_t iA=0;iA<SVec.size();iA++)
     for(size_t iB=iA+1;iB<SVec.size();iB++)
-      for(size_t iC=0;iC<CellSVec.size();iC++)
+      for(size_t iC=0;iC<CVec.size();iC++)
 	{
-	  Out=SurInter::processPoint(SVec[iA],SVec[iB],CellSVec[iC]);
+	  Out=SurInter::processPoint(SVec[iA],SVec[iB],CVec[iC]);
 	  for(vc=Out.begin();vc!=Out.end();vc++)
 	    {
+	      if (!OBox.isValid(*vc)) continue;
 	      std::set<int> boundarySet;
 	      boundarySet.insert(SVec[iA]->getName());
 	      boundarySet.insert(SVec[iB]->getName());
-	      if (CellObj.isValid(*vc,CellSVec[iC]->getName()) &&
+	      if (CellObj.isValid(*vc,CVec[iC]->getName()) &&
 		  !CC.isOuterValid(*vc,boundarySet))
 		{
 		  return 1;
@@ -270,10 +270,7 @@ addToInsertLineCtrl(Simulation& System,
 
 
   if (CRPtr && checkLineIntersect(InsertFC,*CRPtr))
-    {
-      const std::string excludeStr=CC.getExclude();
-      CRPtr->addSurfString(excludeStr);
-    }
+    CRPtr->addSurfRule(CC.getExcludeRule());
   return;
 }
 
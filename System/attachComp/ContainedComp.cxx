@@ -49,6 +49,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Surface.h"
 #include "SurInter.h"
 #include "Rules.h"
@@ -328,6 +329,32 @@ ContainedComp::getExclude() const
   return "";
 }
 
+Geometry::BoundBox
+ContainedComp::getBoundBox() const
+  /*!
+    Calculate a conservative box round the outer surface
+    \return bounding box [unbounded if not determined]
+  */
+{
+  return outerSurf.calcBoundBox();
+}
+
+HeadRule
+ContainedComp::getExcludeRule() const
+  /*!
+    Calculate the excluded rule [getExclude as a rule]
+    so that it can be added to a cell without going
+    through the cell string.
+    \return Exclude rule [empty if no outer surface]
+  */
+{
+  ELog::RegMethod RegA("ContainedComp","getExcludeRule");
+  
+  if (outerSurf.hasRule())
+    return outerSurf.complement();
+  return HeadRule();
+}
+
 std::string
 ContainedComp::getContainer() const
   /*!
@@ -637,11 +664,12 @@ ContainedComp::insertObjects(Simulation& System)
   ELog::RegMethod RegA("ContainedComp","insertObjects");
   if (!hasOuterSurf()) return;
 
+  const HeadRule excludeRule=getExcludeRule();
   for(const int CN : insertCells)
     {
       MonteCarlo::Qhull* outerObj=System.findQhull(CN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	outerObj->addSurfRule(excludeRule);
       else
 	ELog::EM<<"Failed to find outerObject: "<<CN<<ELog::endErr;
     }
@@ -664,7 +692,7 @@ ContainedComp::insertInCell(Simulation& System,
 
   MonteCarlo::Qhull* outerObj=System.findQhull(cellN);
   if (outerObj)
-    outerObj->addSurfString(getExclude());
+    outerObj->addSurfRule(getExcludeRule());
   else
     throw ColErr::InContainerError<int>(cellN,"Cell not in Simulation");
   return;
@@ -682,11 +710,13 @@ ContainedComp::insertInCell(Simulation& System,
   ELog::RegMethod RegA("ContainedComp","insertInCell(Vec)");
   
   if (!hasOuterSurf()) return;
+
+  const HeadRule excludeRule=getExcludeRule();
   for(const int cellN : cellVec)
     {
       MonteCarlo::Qhull* outerObj=System.findQhull(cellN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	outerObj->addSurfRule(excludeRule);
       else
 	throw ColErr::InContainerError<int>(cellN,"Cell not in Simulation");
     }
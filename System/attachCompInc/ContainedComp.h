@@ -27,6 +27,7 @@ class Simulation;
 namespace Geometry
 {
   class Line;
+  class BoundBox;
 }
 
 namespace attachSystem
@@ -64,6 +65,7 @@ class ContainedComp
   virtual ~ContainedComp();
   
   virtual std::string getExclude() const;
+  virtual HeadRule getExcludeRule() const;
   virtual std::string getCompExclude() const;
   virtual std::string getContainer() const;
   virtual std::string getCompContainer() const;
@@ -79,6 +81,7 @@ class ContainedComp
 
   /// Test if has outer rule
   bool hasOuterSurf() const { return outerSurf.hasRule(); }
+  Geometry::BoundBox getBoundBox() const;
   /// Test if has boundary rule
   bool hasBoundary() const { return boundary.hasRule(); }
   int isBoundaryValid(const Geometry::Vec3D&) const;
@@ -30,6 +30,8 @@
 #include <stack>
 #include <string>
 #include <algorithm>
+#include <functional>
+#include <cstdio>
 #include <boost/multi_array.hpp>
 
 #include "Exception.h"
@@ -42,20 +44,24 @@
 #include "OutputLog.h"
 #include "Triple.h"
 #include "support.h"
+#include "fileSupport.h"
+#include "MD5hash.h"
+#include "ThreadControl.h"
 #include "RefCon.h"
-#include "Simpson.h"
 #include "ENDF.h"
 #include "SQWtable.h"
 #include "SEtable.h"
 #include "ENDFmaterial.h"
-#include "ePrimeFunc.h"
 
 namespace ENDF
 {
 
+/// Version of the SEcache : change with the SE integration or format
+const int SECacheVersion(2);
+
 ENDFmaterial::ENDFmaterial() :
   mat(0),tmpIndex(0),tempActual(300),
-  ZA(0)
+  useCache(0),ZA(0)
   /*!
     Constructor
   */
@@ -63,7 +69,7 @@ ENDFmaterial::ENDFmaterial() :
 
 ENDFmaterial::ENDFmaterial(const std::string& FName) :
   mat(0),tmpIndex(0),tempActual(300),
-  ZA(0)
+  useCache(0),ZA(0)
   /*!
     Constructor for values
     \param FName :: Endf file
@@ -74,7 +80,7 @@ ENDFmaterial::ENDFmaterial(const std::string& FName) :
 
 ENDFmaterial::ENDFmaterial(const ENDFmaterial& A) : 
   mat(A.mat),tmpIndex(A.tmpIndex),tempActual(A.tempActual),
-  ZA(A.ZA),AWR(A.AWR),LAT(A.LAT),LASYM(A.LASYM),LLN(A.LLN),
+  useCache(A.useCache),ZA(A.ZA),AWR(A.AWR),LAT(A.LAT),LASYM(A.LASYM),LLN(A.LLN),
   NS(A.NS),NI(A.NI),NT(A.NT),Sn(A.Sn),SE(A.SE),Teff(A.Teff),
   B(A.B)
   /*!
@@ -96,6 +102,7 @@ ENDFmaterial::operator=(const ENDFmaterial& A)
       mat=A.mat;
       tmpIndex=A.tmpIndex;
       tempActual=A.tempActual;
+      useCache=A.useCache;
       ZA=A.ZA;
       AWR=A.AWR;
       LAT=A.LAT;
@@ -347,7 +354,7 @@ ENDFmaterial::ENDF7file(const std::string& FName)
       procTeff(IX);
 
       // Populate SEtable:
-      populateSETable();
+      populateSETable(FName);
     }
   catch (ColErr::ExBase& A)
     {
@@ -360,6 +367,37 @@ ENDFmaterial::ENDF7file(const std::string& FName)
 }
 
 
+double
+ENDFmaterial::SabAtom(const size_t atomIndex,const double alpha,
+		      const double beta) const
+  /*!
+    Calculate S(alpha,beta) for a non-principle atom 
+    [SCT / free gas approximation]
+    \param atomIndex :: Atom index [>0]
+    \param alpha :: momentum transfer
+    \param beta :: energy transfer
+    \return S(alpha,beta)
+  */
+{
+  if (B.size()<6*(atomIndex+1))
+    return 0.0;
+
+  // SCT approximation:
+  if (B[6*atomIndex]<0.1 || fabs(B[6*atomIndex]-1.0)<1e-5)
+    {
+      const double sF=4*M_PI*alpha*Teff[atomIndex]/tempActual;
+      double eP=pow((alpha-fabs(beta)),2.0)*tempActual/
+	(Teff[atomIndex]*4*alpha);
+      eP+=fabs(beta)/2.0;
+      return exp(-eP)/sqrt(sF);
+    }
+  // CASE: FREE GAS:
+  if (fabs(B[6*atomIndex]-1.0)<1e-5)
+    return exp(-(alpha*alpha+beta*beta)/(4*alpha))/sqrt(4*M_PI*alpha);
+
+  return 0.0;
+}
+
 double
 ENDFmaterial::Sab(const size_t atomIndex,const double E,
 		  const double Eprime,const double mu) const
@@ -383,26 +421,9 @@ ENDFmaterial::Sab(const size_t atomIndex,const double E,
   if (atomIndex==0) 
     return Sn.Sab(alpha,beta);
   
-  if (B.size()<6*(atomIndex+1))
-    return 0.0;
-
-  // SCT approximation:
-  if (B[6*atomIndex]<0.1 || fabs(B[6*atomIndex]-1.0)<1e-5)
-    {
-      const double sF=4*M_PI*alpha*Teff[atomIndex]/tempActual;
-      double eP=pow((alpha-fabs(beta)),2.0)*tempActual/
-	(Teff[atomIndex]*4*alpha);
-      eP+=fabs(beta)/2.0;
-      return exp(-eP)/sqrt(sF);
-    }
-  // CASE: FREE GAS:
-  if (fabs(B[6*atomIndex]-1.0)<1e-5)
-    return exp(-(alpha*alpha+beta*beta)/(4*alpha))/sqrt(4*M_PI*alpha);
-
-  return 0.0;
+  return SabAtom(atomIndex,alpha,beta);
 }
 
-
 double
 ENDFmaterial::dSdOdE(const double E,const double Eprime,
 		     const double mu) const
@@ -431,31 +452,199 @@ ENDFmaterial::dSdOdE(const double E,const double Eprime,
 }
 
 void
-ENDFmaterial::populateSETable()
+ENDFmaterial::dSdOdE(const double E,const double mu,
+		     const std::vector<double>& Eprime,
+		     std::vector<double>& DS) const
   /*!
-    Create table of sigma(E)
+    Calculate do/dOde for a set of final energies. Gives the
+    same values as the single point dSdOdE but the principle 
+    atom table is evaluated as one batch.
+    \param E :: Energy of neutron [eV]
+    \param mu :: cos(angle)
+    \param Eprime :: Final Energies of neutron [eV]
+    \param DS :: do/dOde=S(Q,w) at each Eprime [resized]
+  */
+{
+  const size_t NPts(Eprime.size());
+  std::vector<double> alpha(NPts);
+  std::vector<double> beta(NPts);
+  for(size_t j=0;j<NPts;j++)
+    {
+      alpha[j]=(Eprime[j]+E-2*mu*sqrt(Eprime[j]*E))/
+	(AWR*RefCon::k_bev*tempActual);
+      beta[j]=(Eprime[j]-E)/(tempActual*RefCon::k_bev);
+    }
+
+  std::vector<double> SAB;
+  Sn.Sab(alpha,beta,SAB);
+
+  // same operation order as the single point form
+  DS.resize(NPts);
+  const double scaleA=pow((B[2]+1.0)/B[2],2.0);
+  for(size_t j=0;j<NPts;j++)
+    DS[j]=SAB[j]*B[0]*scaleA;
+
+  for(size_t i=1;i<=static_cast<size_t>(NS);i++)
+    {
+      const size_t bI(i*6);
+      const double scale=pow((B[bI+2]+1.0)/B[bI+2],2.0);
+      for(size_t j=0;j<NPts;j++)
+	DS[j]+=SabAtom(i,alpha[j],beta[j])*B[bI]*scale;
+    }
+
+  for(size_t j=0;j<NPts;j++)
+    {
+      const double fact=sqrt(Eprime[j]/E)/
+	(4.0*M_PI*RefCon::k_bev*tempActual);
+      const double symFactor=(LASYM) ? exp(-beta[j]/2) : 1.0;
+      DS[j]=DS[j]*fact*symFactor;
+    }
+  return;
+}
+
+double
+ENDFmaterial::integrateSigma(const double E) const
+  /*!
+    Integrate do/dOde over final energy [E/51 -> 4E] and angle
+    for a single incident energy. The Simpson rule is
+    the same as Simpson::integrate [250 points].
+    \param E :: Energy of neutron [eV]
+    \return sigma(E)
+  */
+{
+  const int NSimp(250);
+  const double AE(E/51);
+  const double BE(4*E);
+  const double hStep=(BE-AE)/(2*NSimp);
+
+  std::vector<double> Eprime(2*NSimp+1);
+  Eprime[0]=AE;
+  for(int i=1;i<2*NSimp;i++)
+    Eprime[static_cast<size_t>(i)]=AE+hStep*i;
+  Eprime[2*NSimp]=BE;
+
+  std::vector<double> DS;
+  double sigma(0.0);
+  for(int i=-10;i<10;i++)
+    {
+      const double mu(i*0.1);
+      dSdOdE(E,mu,Eprime,DS);
+      double sum(0.0);
+      for(size_t j=1;j<2*NSimp;j++)
+	sum+= (j % 2) ? 4.0*DS[j] : 2.0*DS[j];
+      sum+=DS[0];
+      sum+=DS[2*NSimp];
+      sigma+=(hStep*sum)/3.0;
+    }
+  sigma*=0.1;     // step size:
+  sigma*=2*M_PI;  // Integral of theta
+  return sigma;
+}
+
+std::string
+ENDFmaterial::cacheKey(const std::string& FName) const
+  /*!
+    Key of the SE table cache : cache format version,
+    md5 of the ENDF file content and the mat/temperature 
+    \param FName :: ENDF file
+    \return key string [empty if the file cannot be read]
+  */
+{
+  std::ifstream IX(FName.c_str(),std::ios::binary);
+  if (!IX.good()) return "";
+  std::ostringstream FX;
+  FX<<IX.rdbuf();
+
+  MD5hash sum;
+  std::ostringstream cx;
+  cx.precision(17);
+  cx<<"ENDF:SEtable:"<<SECacheVersion<<":"<<sum.processMessage(FX.str())
+    <<":"<<mat<<":"<<tmpIndex<<":"<<tempActual;
+  return cx.str();
+}
+
+bool
+ENDFmaterial::readSECache(const std::string& FName,
+			  const std::string& Key)
+  /*!
+    Read the SE table from the cache of the ENDF file
+    \param FName :: ENDF file
+    \param Key :: Key of the current file
+    \return true if the cache was valid
+  */
+{
+  std::ifstream IX((FName+".SEcache").c_str(),std::ios::binary);
+  if (!IX.good()) return 0;
+
+  std::string fileKey;
+  if (!StrFunc::readBinary(IX,fileKey) || fileKey!=Key)
+    return 0;
+  return SE.readBinary(IX);
+}
+
+void
+ENDFmaterial::writeSECache(const std::string& FName,
+			   const std::string& Key) const
+  /*!
+    Write the SE table to the cache of the ENDF file.
+    The table is written to a temporary file and moved
+    into place, so a concurrent reader never sees a partial
+    cache. Failure to write is not an error.
+    \param FName :: ENDF file
+    \param Key :: Key of the current file
+  */
+{
+  const std::string CName(FName+".SEcache");
+  const std::string TName(StrFunc::tempFileName(CName));
+  std::ofstream OX(TName.c_str(),std::ios::binary);
+  if (!OX.good()) return;
+  
+  StrFunc::writeBinary(OX,Key);
+  SE.writeBinary(OX);
+  OX.close();
+  if (OX.fail())
+    std::remove(TName.c_str());
+  else
+    StrFunc::replaceFile(TName,CName);
+  return;
+}
+
+void
+ENDFmaterial::populateSETable(const std::string& FName)
+  /*!
+    Create table of sigma(E). If the cache is in use the 
+    table is read from the cache of the ENDF file if valid, 
+    otherwise the energies are integrated over the threads and 
+    the cache written.
+    \param FName :: ENDF file [for cache]
   */
 {
   ELog::RegMethod RegA("ENDFmaterial","populateSETable");
+
+  const std::string Key((useCache) ? cacheKey(FName) : "");
+  if (!Key.empty() && readSECache(FName,Key))
+    return;
   
   const double Eend(4.0);
   const double NSteps(500);
-  SE.clear();
+  std::vector<double> EVec;
   for(int i=1;i<NSteps;i++)
-    {
-      const double E=(exp(i/NSteps)-1.0)*Eend/(exp(1)-1.0);
-      double sigma(0.0);
-      for(int i=-10;i<10;i++)
-	{
-	  const double mu(i*0.1);
-	  ePrimeFunc XX=ePrimeFunc(*this,E,mu);
-	  sigma+=Simpson::integrate<ePrimeFunc>(250,E/51,4*E,XX);
-	}
-      sigma*=0.1;     // step size:
-      sigma*=2*M_PI;  // Integral of theta
-      SE.addEnergy(E,sigma);
-    }
+    EVec.push_back((exp(i/NSteps)-1.0)*Eend/(exp(1)-1.0));
+
+  std::vector<double> SVec(EVec.size());
+  ModelSupport::ThreadControl::runBlocks
+    (EVec.size(),[&](const size_t A,const size_t B)
+     {
+       for(size_t i=A;i<B;i++)
+	 SVec[i]=integrateSigma(EVec[i]);
+     });
   
+  SE.clear();
+  for(size_t i=0;i<EVec.size();i++)
+    SE.addEnergy(EVec[i],SVec[i]);
+
+  if (!Key.empty())
+    writeSECache(FName,Key);
   return;
 }
 
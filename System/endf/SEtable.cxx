@@ -43,6 +43,7 @@
 #include "Triple.h"
 #include "support.h"
 #include "mathSupport.h"
+#include "fileSupport.h"
 #include "RefCon.h"
 #include "ENDF.h"
 #include "SEtable.h"
@@ -126,14 +127,56 @@ SEtable::STotal(const double energy) const
     return sTot.front();
   if (energy>=E.back())
     return sTot.back();
+  // E[eInt] < energy <= E[eInt+1]
   const size_t eInt=static_cast<size_t>
-    (mathFunc::binSearch(E.begin(),E.end(),energy));
+    (mathFunc::binSearch(E.begin(),E.end(),energy))-1;
   // Linear interpolation:
 
-  const double frac=energy-E[eInt]/(E[eInt+1]-E[eInt]);
+  const double frac=(energy-E[eInt])/(E[eInt+1]-E[eInt]);
   return frac*sTot[eInt+1]+(1-frac)*sTot[eInt];
 }
 
+void
+SEtable::writeBinary(std::ostream& OX) const
+  /*!
+    Write the table to a binary [cache] stream
+    \param OX :: Binary output stream
+  */
+{
+  StrFunc::writeBinary(OX,E.size());
+  for(size_t i=0;i<E.size();i++)
+    {
+      StrFunc::writeBinary(OX,E[i]);
+      StrFunc::writeBinary(OX,sTot[i]);
+    }
+  return;
+}
+
+bool
+SEtable::readBinary(std::istream& IX)
+  /*!
+    Read the table from a binary [cache] stream
+    \param IX :: Binary input stream
+    \return true on success [table cleared on failure]
+  */
+{
+  clear();
+  size_t N;
+  if (!StrFunc::readBinary(IX,N) || N>(1UL << 24))
+    return 0;
+  E.resize(N);
+  sTot.resize(N);
+  for(size_t i=0;i<N;i++)
+    if (!StrFunc::readBinary(IX,E[i]) ||
+	!StrFunc::readBinary(IX,sTot[i]))
+      {
+	clear();
+	return 0;
+      }
+  nE=static_cast<int>(N);
+  return 1;
+}
+
 
 
 } // NAMESPACE ENDF
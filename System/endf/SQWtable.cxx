@@ -247,6 +247,66 @@ SQWtable::isValidRangePt(const double& alphaV,const double& betaV,
   return 1;
 }
 
+int
+SQWtable::huntIndex(const std::vector<double>& Vec,const size_t N,
+		    const double V,long int& index)
+  /*!
+    Find the bracket of V [Vec[index] < V <= Vec[index+1]]
+    starting from the previous bracket. The valid range 
+    is the same as isValidRangePt.
+    \param Vec :: Ordered values
+    \param N :: Number of values
+    \param V :: Value to find
+    \param index :: Previous bracket / new bracket on success
+    \return 0 if out of range and 1 on success
+  */
+{
+  if (N<3 || V<=Vec[0] || V>Vec[N-2])
+    return 0;
+
+  // check the previous bracket and its neighbours
+  for(long int step=0;step<3;step++)
+    {
+      const long int I=index+((step==2) ? -1 : step);
+      if (I>=0 && static_cast<size_t>(I+2)<N)
+	{
+	  const size_t sI(static_cast<size_t>(I));
+	  if (Vec[sI]<V && V<=Vec[sI+1])
+	    {
+	      index=I;
+	      return 1;
+	    }
+	}
+    }
+  index=std::lower_bound(Vec.begin(),Vec.begin()+
+			 static_cast<long int>(N),V)-Vec.begin()-1;
+  return 1;
+}
+
+double
+SQWtable::interpolate(const size_t saInt,const size_t sbInt,
+		      const double alphaV,const double betaV) const
+  /*!
+    Log-linear interpolation within a alpha/beta bracket
+    \param saInt :: alpha index
+    \param sbInt :: beta index
+    \param alphaV :: Q-values
+    \param betaV :: energy transfer
+    \return S(Q,w)
+  */
+{
+  const double Alow=loglinear(Alpha[saInt],Alpha[saInt+1],
+			      SAB[saInt][sbInt],SAB[saInt+1][sbInt],
+			      alphaV);
+
+  const double Ahigh=loglinear(Alpha[saInt],Alpha[saInt+1],
+			       SAB[saInt][sbInt+1],SAB[saInt+1][sbInt+1],
+			       alphaV);
+
+  return loglinear(Beta[sbInt],Beta[sbInt+1],
+		   Alow,Ahigh,betaV);  
+}
+
 double
 SQWtable::Sab(const double alphaV,const double betaV) const
   /*!
@@ -266,30 +326,37 @@ SQWtable::Sab(const double alphaV,const double betaV) const
       return 0.0;
     }
 
-  //  const int aType=alphaType(aInt);
-  //  const int bType=betaType(bInt);
-
-  const size_t saInt(static_cast<size_t>(aInt));
-  const size_t sbInt(static_cast<size_t>(bInt));
-  const double Alow=loglinear(Alpha[saInt],Alpha[saInt+1],
-			      SAB[aInt][bInt],SAB[aInt+1][bInt],
-			      alphaV);
-
-  const double Ahigh=loglinear(Alpha[saInt],Alpha[saInt+1],
-			       SAB[aInt][bInt+1],SAB[aInt+1][bInt+1],
-			       alphaV);
-
-  // ELog::EM<<Alow<<" "<<Ahigh<<" :: "<<alphaV<<" "
-  //  	  <<Alpha[aInt]<<" "<<Alpha[aInt+1]<<ELog::endCrit;
-  // ELog::EM<<Beta[bInt]<<" "<<Beta[bInt+1]<<" "<<betaV<<ELog::endCrit;
-  // ELog::EM<<SAB[aInt][bInt]<<" "<<SAB[aInt+1][bInt]<<" "
-  //  	  <<SAB[aInt][bInt+1]<<" "<<SAB[aInt+1][bInt+1]<<ELog::endCrit;
+  return interpolate(static_cast<size_t>(aInt),
+		     static_cast<size_t>(bInt),alphaV,betaV);
+}
 
-  const double SAB=loglinear(Beta[sbInt],Beta[sbInt+1],
-			     Alow,Ahigh,betaV);  
-  //  ELog::EM<<ELog::endCrit;
+void
+SQWtable::Sab(const std::vector<double>& alphaV,
+	      const std::vector<double>& betaV,
+	      std::vector<double>& SOut) const
+  /*!
+    Calculate S(q,omega) for a set of points. The alpha/beta
+    bracket of each point is found from the bracket of the
+    previous point, so a smooth path through the table
+    does not need a full search at each point.
+    \param alphaV :: Q-values
+    \param betaV :: energy transfer [same size as alphaV]
+    \param SOut :: S(Q,w) [resized]
+  */
+{
+  SOut.resize(alphaV.size());
 
-  return SAB;
+  long int aInt(0),bInt(0);
+  for(size_t i=0;i<alphaV.size();i++)
+    {
+      if (huntIndex(Alpha,nAlpha,alphaV[i],aInt) &&
+	  huntIndex(Beta,nBeta,betaV[i],bInt))
+	SOut[i]=interpolate(static_cast<size_t>(aInt),
+			    static_cast<size_t>(bInt),alphaV[i],betaV[i]);
+      else
+	SOut[i]=0.0;
+    }
+  return;
 }
 
 
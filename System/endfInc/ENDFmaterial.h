@@ -44,6 +44,7 @@ class ENDFmaterial
   int mat;            ///< Mat number
   size_t tmpIndex;       ///< Temperature index
   double tempActual;  ///< Real temperature
+  bool useCache;      ///< Read/write the SEtable cache
   
   int ZA;             ///< Zaid number 
   double AWR;         ///< Atomic Weight Ratio  
@@ -64,7 +65,15 @@ class ENDFmaterial
   void procBeta(std::istream&);
   void procAlpha(std::istream&);
   void procTeff(std::istream&);
-  void populateSETable();
+
+  double SabAtom(const size_t,const double,const double) const;
+  void dSdOdE(const double,const double,const std::vector<double>&,
+	      std::vector<double>&) const;
+  double integrateSigma(const double) const;
+  std::string cacheKey(const std::string&) const;
+  bool readSECache(const std::string&,const std::string&);
+  void writeSECache(const std::string&,const std::string&) const;
+  void populateSETable(const std::string&);
 
  public:
   
@@ -78,6 +87,8 @@ class ENDFmaterial
   /// Effective typeid
   virtual std::string className() const { return "ENDFmaterial"; }
 
+  /// Use the <file>.SEcache table [set before ENDF7file]
+  void setSECache(const bool A) { useCache=A; }
   int inRange(const double&,const double&) const;
 
   int ENDF7file(const std::string&);
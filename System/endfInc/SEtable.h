@@ -55,6 +55,9 @@ class SEtable
   void addEnergy(const double,const double);
 
   double STotal(const double) const;
+
+  void writeBinary(std::ostream&) const;
+  bool readBinary(std::istream&);
   
 };
 
@@ -50,6 +50,10 @@ struct SQWtable
   int alphaType(const long int) const;
   int betaType(const long int) const;
   int isValidRangePt(const double&,const double&,long int&,long int&) const;
+  static int huntIndex(const std::vector<double>&,const size_t,
+		       const double,long int&);
+  double interpolate(const size_t,const size_t,
+		     const double,const double) const;
   
  public:
   
@@ -67,6 +71,8 @@ struct SQWtable
 	       const std::vector<double>&);
 
   double Sab(const double,const double) const;
+  void Sab(const std::vector<double>&,const std::vector<double>&,
+	   std::vector<double>&) const;
   
 };
 
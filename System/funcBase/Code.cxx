@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <iterator>
 
 #include "Exception.h"
@@ -184,13 +185,43 @@ Code::subStackPtr(const size_t AS)
 
 
 
-template<typename T>
-T
-Code::Eval(varList* Vars)
+template<>
+double
+Code::zeroType()
+/*!
+  Output a zero variable + warning
+  \return nullObject
+ */
+{
+  ELog::EM<<"Error with zero conversion [double]"<<ELog::endErr;
+  return 0.0;
+}
+
+template<>
+Geometry::Vec3D
+Code::zeroType()
+/*!
+  Output a zero variable + warning
+  \return nullObject
+*/
+{
+  ELog::EM<<"Error with zero conversion [vec] "<<ELog::endErr;
+  return Geometry::Vec3D(0,0,0);
+}
+
+int
+Code::EvalValue(varList* Vars,Geometry::Vec3D& outVec,
+		double& outDbl) const
   /*!
-    The function that evaluates everything
+    The function that evaluates everything. The code is run 
+    in place with a local stack [heap only for deep expressions]
+    so that no copy of the Code object is needed.
     \param Vars :: Vector of variable pointers
-    \returns value of Function expression
+    \param outVec :: Vector result [if type 1]
+    \param outDbl :: Double result [if type 0]
+    \retval 0 :: double result
+    \retval 1 :: Vec3D result 
+    \retval -1 :: failure 
   */
 {
   const size_t ByteCodeSize = ByteCode.size();
@@ -200,9 +231,25 @@ Code::Eval(varList* Vars)
   size_t SP(0);       // Stack pointer  
   SP--;
 
-  std::vector<int> stackType(StackSize);
-  std::vector<double> Stack(StackSize);
-  std::vector<Geometry::Vec3D> StackVec(StackSize);
+  int localType[localStack];
+  double localDbl[localStack];
+  Geometry::Vec3D localVec[localStack];
+  std::vector<int> heapType;
+  std::vector<double> heapDbl;
+  std::vector<Geometry::Vec3D> heapVec;
+
+  int* stackType(localType);
+  double* Stack(localDbl);
+  Geometry::Vec3D* StackVec(localVec);
+  if (StackSize>localStack)
+    {
+      heapType.resize(StackSize);
+      heapDbl.resize(StackSize);
+      heapVec.resize(StackSize);
+      stackType=heapType.data();
+      Stack=heapDbl.data();
+      StackVec=heapVec.data();
+    }
   while (IP<ByteCodeSize)
     {
       switch(ByteCode[IP])
@@ -217,13 +264,13 @@ Code::Eval(varList* Vars)
 	  else if (stackType[SP]==0)  // double
 	    Stack[SP] = fabs(Stack[SP]); 
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	  
 	case  Opcodes::cAcos: 
 	  if(stackType[SP]==1 || 
 	     (Stack[SP] < -1 || Stack[SP] > 1))
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = acos(Stack[SP]); 
 	  break;
 
@@ -231,13 +278,13 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = acosh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cAsin: 
 	  if(stackType[SP]==1 || 
 	     Stack[SP] < -1 || Stack[SP] > 1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = asin(Stack[SP]); 
 	  break;
 	  
@@ -245,19 +292,19 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = asinh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cAtan: 
 	  if(stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = atan(Stack[SP]); 
 	  break;
 
 
 	case Opcodes::cAtan2: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 
 	  Stack[SP-1] = atan2(Stack[SP-1], Stack[SP]);
 	  SP--; 
@@ -267,79 +314,79 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = atanh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cCeil: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = ceil(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cCos: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cos(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	
 	case Opcodes::cCosd: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cos(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCosh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cosh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCot:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = tan(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCotd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = tan(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCsc:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = sin(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCscd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = sin(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cDot: 
@@ -350,54 +397,54 @@ Code::Eval(varList* Vars)
 	      SP--;
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cExp: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = exp(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cFloor: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = floor(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	      
 	case Opcodes::cInt: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = int(Stack[SP]+0.5); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cLog: 
 	  if(stackType[SP]==0 && Stack[SP] <= 0.0)
 	    Stack[SP] = log(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cLog10: 
 	  if(stackType[SP]==0 && Stack[SP] <= 0.0)
 	    Stack[SP] = log10(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cMax: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP-1] = (Stack[SP-1]>Stack[SP]) ? Stack[SP-1] : Stack[SP];
 	  SP--; 
 	  break;
 
 	case Opcodes::cMin: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP-1] = (Stack[SP-1]<Stack[SP]) ? Stack[SP-1] : Stack[SP];
 	  SP--; 
 	  break;
@@ -406,22 +453,22 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    {
 	      const double t = cos(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cSecd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = cos(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 
@@ -429,49 +476,49 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = sin(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSind: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sin(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSinh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sinh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSqrt: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sqrt(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTan: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tan(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTand: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tan(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTanh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tanh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cVec3D: 
@@ -484,7 +531,7 @@ Code::Eval(varList* Vars)
 	      SP-=2;
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cImmed: 
@@ -508,7 +555,7 @@ Code::Eval(varList* Vars)
 	  else if  (stackType[SP]==0)
 	    Stack[SP] = -Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cAdd: 
@@ -517,7 +564,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] += Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -527,7 +574,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] -= Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 
@@ -544,7 +591,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==1)
 	    StackVec[SP-1] *= Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -556,7 +603,7 @@ Code::Eval(varList* Vars)
 		   Stack[SP]!=0.0)
 	    StackVec[SP-1] /= Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -565,7 +612,7 @@ Code::Eval(varList* Vars)
 	      stackType[SP-1]==0 && Stack[SP]!=0)
 	    Stack[SP-1] = fmod(Stack[SP-1], Stack[SP]);
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  SP--; 
 	  break;
 
@@ -573,7 +620,7 @@ Code::Eval(varList* Vars)
 	  if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] = pow(Stack[SP-1], Stack[SP]);
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  SP--; 
 	  break;
 	      
@@ -582,21 +629,21 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = 180.0*Stack[SP]/M_PI; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	  
 	case  Opcodes::cRad: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = M_PI*Stack[SP]/180.0; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cInv:
 	  if(stackType[SP]==0 && Stack[SP]!=0)
 	    Stack[SP] = 1.0/Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cEqual: 
@@ -608,7 +655,7 @@ Code::Eval(varList* Vars)
 	default:
 	  if (ByteCode[IP]<0)
 	    {
-	      if (SP>=Stack.size())
+	      if (SP>=StackSize)
 		throw ColErr::InContainerError<size_t>
 		  (SP,"Code::Eval has looped");
 	    }
@@ -623,33 +670,66 @@ Code::Eval(varList* Vars)
       IP++;
     }
 
-  return (stackType[SP]) ? 
-    typeConvert<T>(StackVec[SP]) : 
-    typeConvert<T>(Stack[SP]);
+  // unknown variable [-1] is treated as a vector 
+  if (stackType[SP])
+    {
+      outVec=StackVec[SP];
+      return 1;
+    }
+  outDbl=Stack[SP];
+  return 0;
 }
 
-template<>
-double
-Code::zeroType()
-/*!
-  Output a zero variable + warning
-  \return nullObject
- */
+template<typename T>
+T
+Code::Eval(varList* Vars) const
+  /*!
+    The function that evaluates everything
+    \param Vars :: Vector of variable pointers
+    \returns value of Function expression
+  */
 {
-  ELog::EM<<"Error with zero conversion [double]"<<ELog::endErr;
-  return 0.0;
+  Geometry::Vec3D outVec;
+  double outDbl(0.0);
+  const int type=EvalValue(Vars,outVec,outDbl);
+  if (type<0)
+    return zeroType<T>();
+  return (type) ? typeConvert<T>(outVec) : typeConvert<T>(outDbl);
 }
 
-template<>
-Geometry::Vec3D
-Code::zeroType()
-/*!
-  Output a zero variable + warning
-  \return nullObject
-*/
+int
+Code::hasAssign() const
+  /*!
+    Determine if the code assigns a variable [cEqual]
+    \return true if a variable is set during evaluation
+  */
 {
-  ELog::EM<<"Error with zero conversion [vec] "<<ELog::endErr;
-  return Geometry::Vec3D(0,0,0);
+  for(size_t IP=0;IP<ByteCode.size();IP++)
+    {
+      if (ByteCode[IP]==Opcodes::cEqual)
+	return 1;
+    }
+  return 0;
+}
+
+std::vector<int>
+Code::getVarIndex() const
+  /*!
+    Get the index of all the variables read by the code
+    \return sorted/unique variable index
+  */
+{
+  std::vector<int> Out;
+  for(size_t IP=0;IP<ByteCode.size();IP++)
+    {
+      if (ByteCode[IP]==Opcodes::cEqual)
+	IP++;
+      else if (ByteCode[IP]>=Opcodes::varBegin)
+	Out.push_back(ByteCode[IP]-Opcodes::varBegin);
+    }
+  std::sort(Out.begin(),Out.end());
+  Out.erase(std::unique(Out.begin(),Out.end()),Out.end());
+  return Out;
 }
 
 template<typename T,typename U>
@@ -814,8 +894,8 @@ Code::printByteCode(std::ostream& OFS) const
 
 
 ///\cond TEMPLATE
-template double Code::Eval(varList*);
-template Geometry::Vec3D Code::Eval(varList*);
+template double Code::Eval(varList*) const;
+template Geometry::Vec3D Code::Eval(varList*) const;
 
 template double Code::typeConvert(const Geometry::Vec3D&);
 template Geometry::Vec3D Code::typeConvert(const double&);
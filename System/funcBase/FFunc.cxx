@@ -46,7 +46,8 @@
 //-----------------------------------------
 
 FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
-  FItem(VA,I),BaseUnit(CObj)
+  FItem(VA,I),BaseUnit(CObj),assignFlag(CObj.hasAssign()),
+  cacheValid(0),cacheType(0),cacheDbl(0.0)
   /*!
     Standard constructor
     \param VA :: VarList pointer
@@ -56,7 +57,9 @@ FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
 {}
 
 FFunc::FFunc(const FFunc& A) :
-  FItem(A),BaseUnit(A.BaseUnit)
+  FItem(A),BaseUnit(A.BaseUnit),assignFlag(A.assignFlag),
+  cacheValid(A.cacheValid),cacheType(A.cacheType),
+  cacheDbl(A.cacheDbl),cacheVec(A.cacheVec)
   /*!
     Standard copy constructor
     \param A :: FFunc object to copy
@@ -75,6 +78,11 @@ FFunc::operator=(const FFunc& A)
     {
       FItem::operator=(A);
       BaseUnit=A.BaseUnit;
+      assignFlag=A.assignFlag;
+      cacheValid=A.cacheValid;
+      cacheType=A.cacheType;
+      cacheDbl=A.cacheDbl;
+      cacheVec=A.cacheVec;
     }
   return *this;
 }
@@ -104,9 +112,53 @@ FFunc::setValue(const Code& AC)
   */
 {
   BaseUnit=AC;
+  assignFlag=AC.hasAssign();
+  cacheValid=0;
   return;
 }
 
+int
+FFunc::evalCode(Geometry::Vec3D& V,double& D) const
+  /*!
+    Evaluate the code or use the cached value.
+    Failed evaluations are not cached.
+    \param V :: Vector output
+    \param D :: Double output
+    \return type [0 double / 1 Vec3D / -1 failure]
+  */
+{
+  if (cacheValid)
+    {
+      V=cacheVec;
+      D=cacheDbl;
+      return cacheType;
+    }
+  const int type=BaseUnit.EvalValue(VListPtr,V,D);
+  if (type>=0 && !assignFlag)
+    {
+      cacheValid=1;
+      cacheType=type;
+      cacheVec=V;
+      cacheDbl=D;
+    }
+  return type;
+}
+
+double
+FFunc::evalDouble() const
+  /*!
+    Get the double value. A vector/failed result uses 
+    the full evaluation to give the same error.
+    \return value
+  */
+{
+  Geometry::Vec3D VOut;
+  double DOut(0.0);
+  if (!evalCode(VOut,DOut))
+    return DOut;
+  return BaseUnit.Eval<double>(VListPtr);
+}
+
 int
 FFunc::getValue(Geometry::Vec3D& V) const
   /*!
@@ -120,15 +172,13 @@ FFunc::getValue(Geometry::Vec3D& V) const
   */
 {
   ELog::RegMethod RegA("FFunc","getValue(Vec3D)");
-  Code BC(BaseUnit);
-  try
-    {
-      V=BC.Eval<Geometry::Vec3D>(FItem::VListPtr);
-    }
-  catch(ColErr::TypeConvError<double,Geometry::Vec3D>&)
-    {
-      return 0;
-    }
+
+  double DOut(0.0);
+  const int type=evalCode(V,DOut);
+  if (!type)
+    return 0;
+  if (type<0)
+    V=BaseUnit.Eval<Geometry::Vec3D>(VListPtr);
   const_cast<int&>(active)++;
   return 1;
 }
@@ -141,8 +191,7 @@ FFunc::getValue(double& V) const
     \return 1 if appropiate eval / 0 otherwise
   */
 {
-  Code BC(BaseUnit);
-  V=BC.Eval<double>(FItem::VListPtr);
+  V=evalDouble();
   const_cast<int&>(active)++;
   return 1;
 }
@@ -155,8 +204,7 @@ FFunc::getValue(int& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<int>(BC.Eval<double>(VListPtr));
+  V=static_cast<int>(evalDouble());
   const_cast<int&>(active)++;
   return 1;
 }
@@ -169,8 +217,7 @@ FFunc::getValue(long int& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<long int>(BC.Eval<double>(VListPtr));
+  V=static_cast<long int>(evalDouble());
   const_cast<int&>(active)++;
   return 1;
 }
@@ -184,8 +231,7 @@ FFunc::getValue(size_t& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<size_t>(BC.Eval<double>(VListPtr));
+  V=static_cast<size_t>(evalDouble());
   const_cast<int&>(active)++;
   return 1;
 }
@@ -198,8 +244,7 @@ FFunc::getValue(std::string& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  double Val=BC.Eval<double>(VListPtr);
+  const double Val=evalDouble();
   std::stringstream cx;
   cx<<Val;
   V=cx.str();
@@ -105,6 +105,20 @@ FuncDataBase::findItem(const std::string& Key) const
    return VList.findVar(Key);
 }
 
+const FItem*
+FuncDataBase::findItem(const std::string& KeyA,
+		       const std::string& KeyB) const
+  /*!
+    Finds a variable item from a two part name 
+    without constructing the full name
+    \param KeyA :: First part of name
+    \param KeyB :: Second part of name [tail]
+    \return FItem pointer (or 0 on failure to find)
+  */
+{
+   return VList.findVar(KeyA,KeyB);
+}
+
 int
 FuncDataBase::hasVariable(const std::string& Key) const
   /*!
@@ -200,7 +214,19 @@ FuncDataBase::EvalTriple(const std::string& KeyA,
     \throw InContainterError if no variables exists
   */
 {
-  return EvalTriple<T>(KeyA+Tail,KeyB+Tail,KeyC+Tail);
+  const FItem* FI=findItem(KeyA,Tail);
+  if (!FI)
+    FI=findItem(KeyB,Tail);
+  if (!FI)
+    FI=findItem(KeyC,Tail);
+  if (!FI)
+    throw ColErr::InContainerError<std::string>
+      (KeyC+Tail+":"+KeyB+Tail+":"+KeyA+Tail,
+       "FuncDataBase::EvalTriple no variables found");
+  
+  T Out;
+  FI->getValue(Out);
+  return Out;
 }
 
 template<typename T>
@@ -241,7 +267,16 @@ FuncDataBase::EvalPair(const std::string& KeyA,
     \throw InContainterError if no variables exists
   */
 {
-  return EvalPair<T>(KeyA+Tail,KeyB+Tail);
+  const FItem* FI=findItem(KeyA,Tail);
+  if (!FI)
+    FI=findItem(KeyB,Tail);
+  if (!FI)
+    throw ColErr::InContainerError<std::string>
+      (KeyB+Tail+":"+KeyA+Tail,"FuncDataBase::EvalPair no variables found");
+  
+  T Out;
+  FI->getValue(Out);
+  return Out;
 }
 
 template<typename T>
@@ -283,7 +318,15 @@ FuncDataBase::EvalDefPair(const std::string& KeyA,
     \return Value of variable 
   */
 {
-  return EvalDefPair<T>(KeyA+Tail,KeyB+Tail,defVal);
+  const FItem* FI=findItem(KeyA,Tail);
+  if (!FI)
+    FI=findItem(KeyB,Tail);
+  if (!FI)
+    return defVal;
+  
+  T Out;
+  FI->getValue(Out);
+  return Out;
 }
 
 template<typename T>
@@ -0,0 +1,199 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   funcBase/varHash.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "varHash.h"
+
+/// Key held by deleted slots
+static const std::string deadKey;
+
+const size_t varHash::hashSeed
+  (static_cast<size_t>(14695981039346656037ULL));
+
+varHash::varHash() :
+  nItem(0),nFill(0)
+  /*!
+    Constructor
+  */
+{}
+
+size_t
+varHash::hashAdd(size_t H,const std::string& A)
+  /*!
+    Add a string to a hash [FNV-1a]. Adding two
+    strings in turn gives the hash of the joined string
+    \param H :: Current hash
+    \param A :: String to add
+    \return new hash
+  */
+{
+  for(const char c : A)
+    {
+      H^=static_cast<unsigned char>(c);
+      H*=static_cast<size_t>(1099511628211ULL);
+    }
+  return H;
+}
+
+void
+varHash::clear()
+  /*!
+    Remove all the items
+  */
+{
+  nItem=0;
+  nFill=0;
+  Table.clear();
+  return;
+}
+
+size_t
+varHash::findSlot(const size_t H,const std::string& A,
+		  const std::string& B) const
+  /*!
+    Find the slot of the key A+B
+    \param H :: Hash of A+B
+    \param A :: First part of key
+    \param B :: Second part of key
+    \return slot index / npos if not found
+  */
+{
+  if (Table.empty()) return std::string::npos;
+
+  const size_t mask(Table.size()-1);
+  const size_t ALen(A.size());
+  for(size_t index=H & mask;Table[index].key;index=(index+1) & mask)
+    {
+      const Slot& SUnit=Table[index];
+      if (SUnit.item && SUnit.hash==H &&
+	  SUnit.key->size()==ALen+B.size() &&
+	  !SUnit.key->compare(0,ALen,A) &&
+	  !SUnit.key->compare(ALen,std::string::npos,B))
+	return index;
+    }
+  return std::string::npos;
+}
+
+void
+varHash::rehash(const size_t N)
+  /*!
+    Rebuild the table for N items [removes deleted slots]
+    \param N :: Number of items to allow
+  */
+{
+  size_t NSize(16);
+  while(NSize<2*N)
+    NSize*=2;
+
+  std::vector<Slot> OldTable(NSize,Slot({0,0,0}));
+  OldTable.swap(Table);
+  const size_t mask(NSize-1);
+  for(const Slot& SUnit : OldTable)
+    if (SUnit.key && SUnit.item)
+      {
+	size_t index(SUnit.hash & mask);
+	while(Table[index].key)
+	  index=(index+1) & mask;
+	Table[index]=SUnit;
+      }
+  nFill=nItem;
+  return;
+}
+
+void
+varHash::insert(const std::string& Key,FItem* FPtr)
+  /*!
+    Insert/replace an item.
+    \param Key :: Name [must exist until erased]
+    \param FPtr :: Item
+  */
+{
+  const size_t H=hashAdd(hashSeed,Key);
+  const size_t slot=findSlot(H,Key,deadKey);
+  if (slot!=std::string::npos)
+    {
+      Table[slot].key= &Key;
+      Table[slot].item=FPtr;
+      return;
+    }
+
+  if (2*(nFill+1)>Table.size())
+    rehash(nItem+1);
+
+  const size_t mask(Table.size()-1);
+  size_t index(H & mask);
+  while(Table[index].key && Table[index].item)
+    index=(index+1) & mask;
+  if (!Table[index].key) nFill++;
+  Table[index].hash=H;
+  Table[index].key= &Key;
+  Table[index].item=FPtr;
+  nItem++;
+  return;
+}
+
+void
+varHash::erase(const std::string& Key)
+  /*!
+    Remove an item [slot is marked as deleted]
+    \param Key :: Name
+  */
+{
+  const size_t H=hashAdd(hashSeed,Key);
+  const size_t slot=findSlot(H,Key,deadKey);
+  if (slot!=std::string::npos)
+    {
+      Table[slot].key= &deadKey;
+      Table[slot].item=0;
+      nItem--;
+    }
+  return;
+}
+
+FItem*
+varHash::find(const std::string& Key) const
+  /*!
+    Find an item
+    \param Key :: Name
+    \return Item / 0 if not found
+  */
+{
+  return find(Key,deadKey);
+}
+
+FItem*
+varHash::find(const std::string& KeyA,const std::string& KeyB) const
+  /*!
+    Find an item from a two part name without
+    building the full name
+    \param KeyA :: First part of name
+    \param KeyB :: Second part of name
+    \return Item / 0 if not found
+  */
+{
+  const size_t H=hashAdd
+    (hashAdd(hashSeed,KeyA),KeyB);
+  const size_t slot=findSlot(H,KeyA,KeyB);
+  return (slot!=std::string::npos) ? Table[slot].item : 0;
+}
@@ -42,17 +42,19 @@
 #include "Vec3D.h"
 #include "Code.h"
 #include "FItem.h"
+#include "varHash.h"
 #include "varList.h"
 
 varList::varList() :
-  varNum(0)
+  varNum(0),HashIndex(new varHash())
   /*!
     Default constructor
   */
 {}
 
 varList::varList(const varList& A) :
-  varNum(A.varNum)
+  varNum(A.varNum),HashIndex(new varHash()),
+  dependMap(A.dependMap)
   /*!
     Standard Copy constructor.
     Makes a memory copy of the FItem*
@@ -63,7 +65,10 @@ varList::varList(const varList& A) :
   for(vc=A.varName.begin();vc!=A.varName.end();vc++)
     {
       FItem* Ptr=vc->second->clone();
-      varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
+      Ptr->setVList(this);
+      varStore::const_iterator nc=
+	varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr)).first;
+      HashIndex->insert(nc->first,Ptr);
       varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
     }
   return;
@@ -82,11 +87,15 @@ varList::operator=(const varList& A)
     {
       varNum=A.varNum;
       deleteMem();
+      dependMap=A.dependMap;
       std::map<std::string,FItem*>::const_iterator vc;
       for(vc=A.varName.begin();vc!=A.varName.end();vc++)
         {
 	  FItem* Ptr=vc->second->clone();
-	  varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
+	  Ptr->setVList(this);
+	  varStore::const_iterator nc=varName.insert
+	    (std::pair<std::string,FItem*>(vc->first,Ptr)).first;
+	  HashIndex->insert(nc->first,Ptr);
 	  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
 	}
     }
@@ -100,17 +109,23 @@ varList::~varList()
   */
 {
   deleteMem();
+  delete HashIndex;
 }
 
 void
 varList::resetActive()
   /*!
-    Reset the active unit
+    Reset the active unit. The function caches are cleared
+    so the next evaluation reads [and activates] the 
+    variables they depend on.
   */
 {
   for(varStore::value_type& VC : varName)
-    VC.second->resetActive();
-      
+    {
+      VC.second->resetActive();
+      VC.second->clearCache();
+    }
+  return;
 }
 
 
@@ -125,6 +140,61 @@ varList::deleteMem()
     delete vc->second;
   varItem.erase(varItem.begin(),varItem.end());
   varName.erase(varName.begin(),varName.end());
+  HashIndex->clear();
+  dependMap.clear();
+  return;
+}
+
+void
+varList::addDepend(const FItem* FPtr)
+  /*!
+    Register the variables that a function reads
+    \param FPtr :: Item [only FFunc items are registered]
+  */
+{
+  const FFunc* CPtr=dynamic_cast<const FFunc*>(FPtr);
+  if (CPtr)
+    {
+      const int index=CPtr->getIndex();
+      for(const int I : CPtr->getCode().getVarIndex())
+	{
+	  std::vector<int>& DVec=dependMap[I];
+	  if (std::find(DVec.begin(),DVec.end(),index)==DVec.end())
+	    DVec.push_back(index);
+	}
+    }
+  return;
+}
+
+void
+varList::clearDepend(const int Key)
+  /*!
+    Clear the cached value of all the functions that
+    depend [directly or indirectly] on a variable
+    \param Key :: Index of variable that has changed
+  */
+{
+  std::vector<int> Active({Key});
+  std::vector<int> Done({Key});
+  while(!Active.empty())
+    {
+      const int index=Active.back();
+      Active.pop_back();
+      std::map<int,std::vector<int>>::const_iterator mc=
+	dependMap.find(index);
+      if (mc==dependMap.end()) continue;
+
+      for(const int DIndex : mc->second)
+	{
+	  if (std::find(Done.begin(),Done.end(),DIndex)==Done.end())
+	    {
+	      Done.push_back(DIndex);
+	      Active.push_back(DIndex);
+	      FItem* FPtr=findVar(DIndex);
+	      if (FPtr) FPtr->clearCache();
+	    }
+	}
+    }
   return;
 }
 
@@ -137,12 +207,22 @@ varList::findVar(const std::string& Key) const
     \retval FItem pointer
   */
 {
-  std::map<std::string,FItem*>::const_iterator vc;
-  vc=varName.find(Key);
-  if (vc!=varName.end())
-    return vc->second;
+  return HashIndex->find(Key);
+}
 
-  return 0;
+const FItem*
+varList::findVar(const std::string& KeyA,
+		 const std::string& KeyB) const  
+  /*!
+    Returns a pointer to the FItem* instance of the
+    variable KeyA+KeyB [the name is not constructed]
+    \param KeyA :: First part of the variable name
+    \param KeyB :: Second part of the variable name
+    \retval 0 :: If no such function name exists,
+    \retval FItem pointer
+  */
+{
+  return HashIndex->find(KeyA,KeyB);
 }
 
 const FItem*
@@ -188,12 +268,7 @@ varList::findVar(const std::string& Key)
     \retval FItem pointer
   */
 {
-  std::map<std::string,FItem*>::iterator vc;
-  vc=varName.find(Key);
-  if (vc!=varName.end())
-    return vc->second;
-
-  return 0;
+  return HashIndex->find(Key);
 }
 
 
@@ -220,10 +295,12 @@ varList::copyVar(const std::string& newKey,const std::string& oldKey)
   if (ac!=varName.end())
     {
       const int I=ac->second->getIndex();
+      clearDepend(I);
       delete ac->second;
 
       std::map<int,FItem*>::iterator ic;
       ic=varItem.find(I);
+      HashIndex->erase(newKey);
       varName.erase(ac);
       varItem.erase(ic);
     }
@@ -231,9 +308,11 @@ varList::copyVar(const std::string& newKey,const std::string& oldKey)
   Ptr->setIndex(varNum);
   varNum++;
     // Now insert into master lists
-  varName.insert(std::pair<std::string,FItem*>(newKey,Ptr));
+  varStore::const_iterator nc=
+    varName.insert(std::pair<std::string,FItem*>(newKey,Ptr)).first;
+  HashIndex->insert(nc->first,Ptr);
   varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
-
+  addDepend(Ptr);
   return;
 }
 
@@ -352,7 +431,11 @@ varList::setValue(const int Key,const T& Value)
 {
   FItem* FPtr=findVar(Key);
   if (FPtr)
-    FPtr->setValue(Value);
+    {
+      FPtr->setValue(Value);
+      addDepend(FPtr);
+      clearDepend(Key);
+    }
   return;
 }
 
@@ -375,8 +458,10 @@ varList::removeVar(const std::string& Name)
     throw ColErr::InContainerError<int>(mc->second->getIndex(),
                                         "NAME [INT] "+Name);
 
+  clearDepend(mc->second->getIndex());
   delete mc->second;
   varItem.erase(ic);
+  HashIndex->erase(Name);
   varName.erase(mc);
   return;
 }
@@ -432,10 +517,12 @@ varList::addVar(const std::string& Name,const Code& Value)
       // Note that the variable number is re-used 
       // despite the change in variable.
       const int I=vc->second->getIndex();
+      clearDepend(I);
 
       delete vc->second;
       std::map<int,FItem*>::iterator ac;
       ac=varItem.find(I);
+      HashIndex->erase(Name);
       varName.erase(vc);
       varItem.erase(ac);
       Ptr=createFType<Code>(I,Value);
@@ -447,8 +534,10 @@ varList::addVar(const std::string& Name,const Code& Value)
       varNum++;
     }
   // Now insert into master lists
-  varName.emplace(Name,Ptr);
+  varStore::const_iterator nc=varName.emplace(Name,Ptr).first;
+  HashIndex->insert(nc->first,Ptr);
   varItem.emplace(Ptr->getIndex(),Ptr);
+  addDepend(Ptr);
   return;
 }
 
@@ -472,10 +561,12 @@ varList::addVar(const std::string& Name,const T& Value)
       // Note that the variable number is re-used 
       // despite the change in variable.
       const int I=vc->second->getIndex();
+      clearDepend(I);
 
       delete vc->second;
       std::map<int,FItem*>::iterator ac;
       ac=varItem.find(I);
+      HashIndex->erase(Name);
       varName.erase(vc);
       varItem.erase(ac);
       Ptr=createFType<T>(I,Value);
@@ -487,7 +578,9 @@ varList::addVar(const std::string& Name,const T& Value)
       varNum++;
     }
   // Now insert into master lists
-  varName.insert(std::pair<std::string,FItem*>(Name,Ptr));
+  varStore::const_iterator nc=
+    varName.insert(std::pair<std::string,FItem*>(Name,Ptr)).first;
+  HashIndex->insert(nc->first,Ptr);
   varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
   return;
 }
@@ -509,6 +602,8 @@ varList::setVar(const std::string& Name,const T& Value)
   try
     {
       vc->second->setValue(Value);
+      addDepend(vc->second);
+      clearDepend(vc->second->getIndex());
     }
   catch (ColErr::ExBase&)
     {
@@ -66,6 +66,8 @@ class Code
 {
  private:
   
+  static const size_t localStack=16;   ///< Size of the local eval stack
+
   int valid;                           ///< Good code build
   size_t StackPtr;                     ///< Current point in an evaluation
   size_t StackSize;                    ///< Stack size [max]
@@ -86,8 +88,12 @@ class Code
   Code& operator=(const Code&);
   ~Code();
 
+  int EvalValue(varList*,Geometry::Vec3D&,double&) const;
   template<typename T>
-  T Eval(varList*);
+  T Eval(varList*) const;
+
+  int hasAssign() const;
+  std::vector<int> getVarIndex() const;
 
   void clear();
   int popByte();
@@ -64,6 +64,9 @@ class FItem
   virtual void setValue(const std::string&);
   virtual void setValue(const Code&);
 
+  /// Clear a cached value [only FFunc]
+  virtual void clearCache() {}
+
   /// Accessor to active
   int isActive() const { return active; }
   /// reset active
@@ -132,7 +135,9 @@ class FValue : public FItem
   \date April 2006
   \version 1.0
   Holds just the code item of the parser (the only bit that
-  is really needed)
+  is really needed). The value is cached after the first 
+  evaluation, the varList clears it when a variable
+  that it depends on changes.
 */
 
 class FFunc : public FItem
@@ -140,6 +145,15 @@ class FFunc : public FItem
  private:
 
   Code BaseUnit;    ///< Code unit of a compile Function
+  int assignFlag;   ///< Code sets a variable [not cached]
+
+  mutable bool cacheValid;          ///< Cache is valid
+  mutable int cacheType;            ///< Cache type [0 double/1 Vec3D]
+  mutable double cacheDbl;          ///< Cached double
+  mutable Geometry::Vec3D cacheVec; ///< Cached vector
+
+  int evalCode(Geometry::Vec3D&,double&) const;
+  double evalDouble() const;
 
  public:
 
@@ -150,6 +164,11 @@ class FFunc : public FItem
   virtual ~FFunc();
 
   void setValue(const Code&);
+  /// Accessor to code
+  const Code& getCode() const { return BaseUnit; }
+  /// Is the value cached
+  bool isCached() const { return cacheValid; }
+  virtual void clearCache() { cacheValid=0; }
 
   virtual int getValue(Geometry::Vec3D&) const;  
   virtual int getValue(int&) const;     
@@ -75,6 +75,7 @@ class FuncDataBase
   
   //  int hasItem(const std::string&) const;
   const FItem* findItem(const std::string&) const;
+  const FItem* findItem(const std::string&,const std::string&) const;
   //  void setFuncParser(const std::string&,const FuncDataBase&);
   
   int Parse(const std::string&);
@@ -0,0 +1,87 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   funcBaseInc/varHash.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef varHash_h
+#define varHash_h
+
+class FItem;
+
+/*!
+  \class varHash
+  \brief Open addressing hash index of variable names
+  \author S. Ansell
+  \version 1.0
+  \date February 2018
+
+  The names are not copied : each slot points to the
+  key held by the varList map (which is stable until
+  the item is erased). The hash of each key is held
+  in the slot. A name can be found from two parts
+  [prefix + tail] without building the full string.
+*/
+
+class varHash
+{
+ private:
+
+  /// Table slot [key==0 : empty / item==0 : deleted]
+  struct Slot
+  {
+    size_t hash;               ///< Hash of key
+    const std::string* key;    ///< Key [owned by varList]
+    FItem* item;               ///< Item
+  };
+
+  static const size_t hashSeed; ///< Start value of hash
+
+  size_t nItem;                ///< Number of active items
+  size_t nFill;                ///< Number of used slots [inc deleted]
+  std::vector<Slot> Table;     ///< Slots [size power of 2]
+
+  static size_t hashAdd(size_t,const std::string&);
+
+  size_t findSlot(const size_t,const std::string&,
+		  const std::string&) const;
+  void rehash(const size_t);
+
+  ///\cond SINGLETON
+  varHash(const varHash&);
+  varHash& operator=(const varHash&);
+  ///\endcond SINGLETON
+
+ public:
+
+  varHash();
+  ~varHash() {}     ///< Destructor
+
+  /// Number of items
+  size_t size() const { return nItem; }
+
+  void clear();
+  void insert(const std::string&,FItem*);
+  void erase(const std::string&);
+
+  FItem* find(const std::string&) const;
+  FItem* find(const std::string&,const std::string&) const;
+
+};
+
+#endif
@@ -31,9 +31,12 @@
 
   This class holds the variable name + number 
   relative to the actual variable type object. 
+  The functions that read each variable are held so that
+  their cached values can be cleared when it changes.
 */
 
 class FItem;
+class varHash;
 
 class varList
 {
@@ -46,9 +49,14 @@ class varList
   int varNum;                              ///< Current max var
 
   varStore varName;                        ///< Var by name
+  varHash* HashIndex;                      ///< Hash index of varName
   std::map<int,FItem*> varItem;            ///< Var by number
+  /// Functions [index] that read a variable [index]
+  std::map<int,std::vector<int>> dependMap;   
 
   void deleteMem();
+  void addDepend(const FItem*);
+  void clearDepend(const int);
 
  public:
 
@@ -58,6 +66,7 @@ class varList
   ~varList();
 
   const FItem* findVar(const std::string&) const;
+  const FItem* findVar(const std::string&,const std::string&) const;
   const FItem* findVar(const int) const;
   FItem* findVar(const std::string&);
   FItem* findVar(const int);
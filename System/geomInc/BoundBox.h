@@ -0,0 +1,90 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/BoundBox.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef Geometry_BoundBox_h
+#define Geometry_BoundBox_h
+
+namespace Geometry
+{
+  class Surface;
+
+/*!
+  \class BoundBox
+  \brief Axis aligned bounding box
+  \version 1.0
+  \date January 2018
+  \author S. Ansell
+
+  Holds a conservative axis-aligned box. Unbounded
+  directions are held as +/- infinity. A box with
+  low > high in any direction is empty.
+ */
+
+class BoundBox
+{
+ private:
+
+  double lowPt[3];            ///< Low corner
+  double highPt[3];           ///< High corner
+
+ public:
+
+  BoundBox();
+  BoundBox(const Vec3D&,const Vec3D&);
+  BoundBox(const BoundBox&);
+  BoundBox& operator=(const BoundBox&);
+  ~BoundBox() {}  ///< Destructor
+
+  static BoundBox emptyBox();
+
+  /// Access low point
+  double low(const size_t I) const { return lowPt[I % 3]; }
+  /// Access high point
+  double high(const size_t I) const { return highPt[I % 3]; }
+  Vec3D getLow() const;
+  Vec3D getHigh() const;
+  Vec3D centre() const;
+
+  void setLow(const size_t,const double);
+  void setHigh(const size_t,const double);
+  void addPoint(const Vec3D&);
+  void pad(const double);
+
+  BoundBox& intersect(const BoundBox&);
+  BoundBox& unite(const BoundBox&);
+
+  bool isEmpty() const;
+  bool isFinite() const;
+  bool isValid(const Vec3D&) const;
+  bool overlap(const BoundBox&) const;
+  bool isCut(const Surface&) const;
+  size_t longAxis() const;
+
+  void write(std::ostream&) const;
+};
+
+
+std::ostream&
+operator<<(std::ostream&,const BoundBox&);
+
+}   // NAMESPACE Geometry
+
+#endif
@@ -0,0 +1,105 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geomInc/SideCache.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef Geometry_SideCache_h
+#define Geometry_SideCache_h
+
+namespace Geometry
+{
+  class Vec3D;
+  class Surface;
+
+/*!
+  \class SideCache
+  \version 1.0
+  \author S. Ansell
+  \date February 2018
+  \brief Per-point cache of the surface sides
+
+  While a query scope is open each surface side is only
+  calculated once for a given point. The slots are the
+  surface cache index given by surfIndex. Entries are
+  invalidated by a generation counter that is moved on
+  at the start of each outer scope and when the point
+  changes. There is one instance per thread.
+*/
+
+class SideCache
+{
+ private:
+
+  size_t depth;                    ///< Number of open scopes
+  unsigned int generation;         ///< Current generation
+  double cachePt[3];               ///< Point of the current generation
+  std::vector<int> sideValue;      ///< Side of each surface
+  std::vector<unsigned int> genValue;  ///< Generation of sideValue
+
+  SideCache();
+
+  ///\cond SINGLETON
+  SideCache(const SideCache&);
+  SideCache& operator=(const SideCache&);
+  ///\endcond SINGLETON
+
+  void nextGeneration();
+  void resize(const size_t);
+  
+ public:
+
+  static SideCache& Instance();
+
+  /// Is a scope open
+  bool isActive() const { return depth!=0; }
+  
+  void begin();
+  void end();
+
+  int side(const Surface&,const Vec3D&);
+};
+
+/*!
+  \class SideScope
+  \version 1.0
+  \author S. Ansell
+  \date February 2018
+  \brief Opens a SideCache scope for its lifetime
+*/
+
+class SideScope
+{
+ private:
+
+  SideCache& SC;       ///< Cache of this thread
+
+  ///\cond SINGLETON
+  SideScope(const SideScope&);
+  SideScope& operator=(const SideScope&);
+  ///\endcond SINGLETON
+  
+ public:
+
+  SideScope();
+  ~SideScope();
+};
+
+}  // NAMESPACE Geometry
+
+#endif
@@ -27,6 +27,7 @@ class HeadRule;
 namespace Geometry
 {
   class Intersect;
+  class Line;
   
   class Surface;
   class Quadratic;
@@ -103,6 +104,21 @@ std::vector<Geometry::Vec3D>
 makePoint(const Geometry::Quadratic*,const Geometry::Quadratic*,
 	  const Geometry::Quadratic*);
 
+// Closed form kernels for processPoint
+int quadType(const Geometry::Quadratic*);
+
+size_t
+lineIntersect(const Geometry::Line&,const Geometry::Quadratic*,
+	      std::vector<Geometry::Vec3D>&);
+
+int
+quadDiffPlane(const Geometry::Quadratic*,const Geometry::Quadratic*,
+	      Geometry::Plane&);
+
+int
+cylPlanePoint(const Geometry::Plane*,const Geometry::Cylinder*,
+	      const Geometry::Quadratic*,std::vector<Geometry::Vec3D>&);
+
 int 
 getMidPoint(const Geometry::Surface*,const Geometry::Surface*, 
 	    const Geometry::Surface*,Geometry::Vec3D&);
@@ -45,6 +45,7 @@ class Surface
   
   int Name;        ///< Surface number (MCNP identifier)
   int TransN;      ///< Transform number (-ve means applied)
+  size_t cacheIndex;  ///< Slot in the SideCache [0 : not cached]
 
 
  protected:
@@ -76,6 +77,10 @@ class Surface
   int getName() const { return Name; }             ///< Get Name
   void setTrans(const int N) { TransN=N; }         ///< Set Transform number
   int getTrans() const { return TransN; }          ///< Get Transform number
+  /// Set the side cache slot [surfIndex only]
+  void setCacheIndex(const size_t I) { cacheIndex=I; }
+  /// Get the side cache slot
+  size_t getCacheIndex() const { return cacheIndex; }
 
   // Processes Name/TransNumber
   std::string stripID(const std::string&);
@@ -0,0 +1,83 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geomInc/TripleCache.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef Geometry_TripleCache_h
+#define Geometry_TripleCache_h
+
+namespace Geometry
+{
+  class Vec3D;
+  class Surface;
+
+/*!
+  \class TripleCache
+  \version 1.0
+  \author S. Ansell
+  \date February 2018
+  \brief Shared store of three surface intersection points
+
+  Neighbouring cells share most of their surfaces so the
+  points of SurInter::processPoint are kept by the sorted
+  surface number triple. The points are always calculated
+  with the surfaces in number order so the result does not
+  depend on the cell that asked first. Safe to use from
+  many threads. The surfaces must not move or be renumbered
+  while the cache is in use.
+*/
+
+class TripleCache
+{
+ private:
+
+  /// Key of sorted surface numbers
+  typedef std::tuple<int,int,int> KeyTYPE;
+  /// Storage type
+  typedef std::map<KeyTYPE,std::vector<Geometry::Vec3D>> PTYPE;
+
+  mutable std::mutex lockMutex;     ///< Lock on PMap/counters
+  PTYPE PMap;                       ///< Points of each triple
+  size_t nHit;                      ///< Number of found triples
+  size_t nMiss;                     ///< Number of calculated triples
+
+  ///\cond SINGLETON
+  TripleCache(const TripleCache&);
+  TripleCache& operator=(const TripleCache&);
+  ///\endcond SINGLETON
+  
+ public:
+
+  TripleCache();
+  ~TripleCache() {}        ///< Destructor
+
+  void clear();
+  size_t size() const;
+  /// Number of times a triple was found
+  size_t getHit() const { return nHit; }
+  /// Number of times a triple was calculated
+  size_t getMiss() const { return nMiss; }
+
+  std::vector<Geometry::Vec3D>
+  processPoint(const Surface*,const Surface*,const Surface*);
+};
+
+}  // NAMESPACE Geometry
+
+#endif
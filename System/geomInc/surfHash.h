@@ -0,0 +1,94 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/surfHash.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_surfHash_h
+#define ModelSupport_surfHash_h
+
+namespace Geometry
+{
+  class Surface;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class surfHash
+  \version 1.0
+  \author S. Ansell
+  \date March 2018
+  \brief Hash index of surfaces for equal surface lookup
+
+  Each surface is reduced to a family and a scalar made
+  from its normalised parameters [e.g. distance/normal of a
+  plane, radius/centre of a sphere]. Surfaces that are equal
+  within Geometry::zeroTol have scalars closer than the cell
+  size, so a lookup only tests the surfaces in the cell of the
+  scalar and the two cells either side.
+
+  The family is the surface class for Type mode [equality by
+  the class operator==] or plane/quadratic for Quadratic mode
+  [equality by cmpSurfaces].
+*/
+
+class surfHash
+{
+ public:
+
+  /// Equality that the index groups by
+  enum class Mode { Type, Quadratic };
+
+ private:
+
+  static const double cellSize;      ///< Size of a scalar cell
+
+  const Mode mode;                   ///< Equality type
+  /// Surfaces in each cell [cell key : surfaces]
+  std::unordered_map<size_t,std::vector<Geometry::Surface*>> Index;
+  /// Cell key of each surface [for removal after a move]
+  std::unordered_map<const Geometry::Surface*,size_t> SurfCell;
+
+  bool keyValue(const Geometry::Surface*,size_t&,double&) const;
+  static long int cellIndex(const double);
+  static size_t cellKey(const size_t,const long int);
+
+ public:
+
+  explicit surfHash(const Mode);
+  surfHash(const surfHash&);
+  surfHash& operator=(const surfHash&);
+  ~surfHash() {}    ///< Destructor
+
+  /// Number of surfaces held
+  size_t size() const { return SurfCell.size(); }
+
+  void clear();
+  void build(const std::map<int,Geometry::Surface*>&);
+  void insert(Geometry::Surface*);
+  void erase(const Geometry::Surface*);
+
+  std::map<int,Geometry::Surface*>
+    findCandidates(const Geometry::Surface*) const;
+};
+
+}
+
+#endif
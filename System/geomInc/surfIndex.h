@@ -29,6 +29,7 @@ namespace Geometry
 
 namespace ModelSupport
 {
+  class surfHash;
 
 /*!
   \class surfIndex 
@@ -36,6 +37,11 @@ namespace ModelSupport
   \author S. Ansell
   \date December 2009
   \brief Storage for all the surfaces in the problem
+
+  Surfaces in SMap are also held in a surfHash for the equal
+  surface lookup. Surfaces from createSurf are filled after
+  they are added so are keyed at the next lookup. Anything that
+  changes the surfaces in place must call reindex.
 */
 
 class surfIndex
@@ -47,8 +53,11 @@ class surfIndex
  private:
  
   int uniqNum;                      ///< uniq number
+  size_t nCacheIndex;               ///< Last SideCache slot given out
   STYPE SMap;                       ///< Index of kept surfaces
   std::map<int,int> holdMap;        ///< Hold/Write map :: surfaceN : write/no-write flag
+  surfHash* EqHash;                 ///< Equal surface index of SMap
+  std::vector<int> hashPend;        ///< Surfaces to key at next lookup
   
   surfIndex();
 
@@ -58,6 +67,8 @@ class surfIndex
   ////\endcond SINGLETON
 
   int processSurfaces(const std::string&);
+  void setCacheIndex(Geometry::Surface*);
+  void eraseSurf(STYPE::iterator);
 
   
  public:
@@ -77,6 +88,8 @@ class surfIndex
   template<typename T> T* addTypeSurface(T*);
 
   int getUniq();
+  /// Size of a SideCache array to cover all the surfaces
+  size_t cacheSize() const { return nCacheIndex+1; }
 
   void reset();
   void createSurface(const int,const std::string&);  
@@ -84,6 +97,7 @@ class surfIndex
   int checkSurface(const int,const Geometry::Vec3D&) const; 
   void deleteSurface(const int);
   void renumber(const int,const int);
+  void renumber(const std::map<int,int>&);
 
   Geometry::Surface* getSurf(const int) const; 
   
@@ -101,6 +115,8 @@ class surfIndex
   int keepFlag(const int) const;
   std::vector<int> keepVector() const;
 
+  void reindex();
+  STYPE equalCandidates(const Geometry::Surface*);
   int findEqualSurf(const int,const int,
 		    std::map<int,Geometry::Surface*>&) const;
   void removeOpposite(const int);
@@ -0,0 +1,403 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/BoundBox.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <limits>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "BoundBox.h"
+
+namespace Geometry
+{
+
+std::ostream&
+operator<<(std::ostream& OX,const BoundBox& A)
+  /*!
+    Standard output stream
+    \param OX :: Output stream
+    \param A :: BoundBox to write
+    \return Stream State
+   */
+{
+  A.write(OX);
+  return OX;
+}
+
+BoundBox::BoundBox()
+  /*!
+    Constructor : Unbounded box [all space]
+  */
+{
+  const double inf(std::numeric_limits<double>::infinity());
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]= -inf;
+      highPt[i]= inf;
+    }
+}
+
+BoundBox::BoundBox(const Vec3D& APt,const Vec3D& BPt)
+  /*!
+    Constructor from two corners [any order]
+    \param APt :: First corner
+    \param BPt :: Second corner
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(APt[i],BPt[i]);
+      highPt[i]=std::max(APt[i],BPt[i]);
+    }
+}
+
+BoundBox::BoundBox(const BoundBox& A)
+  /*!
+    Copy Constructor
+    \param A :: BoundBox object
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=A.lowPt[i];
+      highPt[i]=A.highPt[i];
+    }
+}
+
+BoundBox&
+BoundBox::operator=(const BoundBox& A)
+  /*!
+    Assignment operator
+    \param A :: BoundBox object
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      for(size_t i=0;i<3;i++)
+	{
+	  lowPt[i]=A.lowPt[i];
+	  highPt[i]=A.highPt[i];
+	}
+    }
+  return *this;
+}
+
+BoundBox
+BoundBox::emptyBox()
+  /*!
+    Create a box that contains nothing. This
+    is the identity for unite
+    \return empty box
+  */
+{
+  const double inf(std::numeric_limits<double>::infinity());
+  BoundBox Out;
+  for(size_t i=0;i<3;i++)
+    {
+      Out.lowPt[i]=inf;
+      Out.highPt[i]= -inf;
+    }
+  return Out;
+}
+
+Vec3D
+BoundBox::getLow() const
+  /*!
+    Accessor to the low corner
+    \return low corner
+  */
+{
+  return Vec3D(lowPt[0],lowPt[1],lowPt[2]);
+}
+
+Vec3D
+BoundBox::getHigh() const
+  /*!
+    Accessor to the high corner
+    \return high corner
+  */
+{
+  return Vec3D(highPt[0],highPt[1],highPt[2]);
+}
+
+Vec3D
+BoundBox::centre() const
+  /*!
+    Calculate the centre of the box [only valid if finite]
+    \return centre point
+  */
+{
+  return Vec3D((lowPt[0]+highPt[0])/2.0,
+	       (lowPt[1]+highPt[1])/2.0,
+	       (lowPt[2]+highPt[2])/2.0);
+}
+
+void
+BoundBox::setLow(const size_t I,const double V)
+  /*!
+    Tighten the low bound in a direction
+    \param I :: Axis index [0-2]
+    \param V :: Value that the box must be above
+  */
+{
+  if (V>lowPt[I % 3])
+    lowPt[I % 3]=V;
+  return;
+}
+
+void
+BoundBox::setHigh(const size_t I,const double V)
+  /*!
+    Tighten the high bound in a direction
+    \param I :: Axis index [0-2]
+    \param V :: Value that the box must be below
+  */
+{
+  if (V<highPt[I % 3])
+    highPt[I % 3]=V;
+  return;
+}
+
+void
+BoundBox::addPoint(const Vec3D& Pt)
+  /*!
+    Extend the box to include a point
+    \param Pt :: Point to include
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(lowPt[i],Pt[i]);
+      highPt[i]=std::max(highPt[i],Pt[i]);
+    }
+  return;
+}
+
+void
+BoundBox::pad(const double D)
+  /*!
+    Expand the box by a distance in all directions
+    (to avoid tolerance problems on the surfaces)
+    \param D :: Distance to expand
+  */
+{
+  if (!isEmpty())
+    for(size_t i=0;i<3;i++)
+      {
+	lowPt[i]-=D;
+	highPt[i]+=D;
+      }
+  return;
+}
+
+BoundBox&
+BoundBox::intersect(const BoundBox& A)
+  /*!
+    Intersect this box with another box
+    \param A :: Box to intersect
+    \return *this
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::max(lowPt[i],A.lowPt[i]);
+      highPt[i]=std::min(highPt[i],A.highPt[i]);
+    }
+  return *this;
+}
+
+BoundBox&
+BoundBox::unite(const BoundBox& A)
+  /*!
+    Union this box with another box
+    \param A :: Box to add
+    \return *this
+  */
+{
+  if (A.isEmpty())
+    return *this;
+  if (isEmpty())
+    return (*this=A);
+
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(lowPt[i],A.lowPt[i]);
+      highPt[i]=std::max(highPt[i],A.highPt[i]);
+    }
+  return *this;
+}
+
+bool
+BoundBox::isEmpty() const
+  /*!
+    Determine if the box contains no points
+    \return true if empty
+  */
+{
+  return (lowPt[0]>highPt[0] ||
+	  lowPt[1]>highPt[1] ||
+	  lowPt[2]>highPt[2]);
+}
+
+bool
+BoundBox::isFinite() const
+  /*!
+    Determine if the box is bounded in all directions
+    \return true if bounded (and not empty)
+  */
+{
+  if (isEmpty()) return 0;
+  for(size_t i=0;i<3;i++)
+    if (std::isinf(lowPt[i]) || std::isinf(highPt[i]))
+      return 0;
+  return 1;
+}
+
+bool
+BoundBox::isValid(const Vec3D& Pt) const
+  /*!
+    Determine if a point is within the box
+    \param Pt :: Point to test
+    \return true if Pt is within/on the box
+  */
+{
+  return (Pt[0]>=lowPt[0] && Pt[0]<=highPt[0] &&
+	  Pt[1]>=lowPt[1] && Pt[1]<=highPt[1] &&
+	  Pt[2]>=lowPt[2] && Pt[2]<=highPt[2]);
+}
+
+bool
+BoundBox::overlap(const BoundBox& A) const
+  /*!
+    Determine if two boxes overlap
+    \param A :: Box to test
+    \return true if the boxes share any volume/face
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (lowPt[i]>A.highPt[i] || A.lowPt[i]>highPt[i])
+      return 0;
+  return 1;
+}
+
+bool
+BoundBox::isCut(const Surface& S) const
+  /*!
+    Determine if a surface can pass through the box.
+    Only planes and spheres are tested, all other surfaces
+    (and unbounded boxes) are assumed to cut the box.
+    \param S :: Surface to test
+    \return false if the surface definately misses the box
+  */
+{
+  if (!isFinite()) return !isEmpty();
+
+  const Plane* PPtr=dynamic_cast<const Plane*>(&S);
+  if (PPtr)
+    {
+      // signed distance of the corners
+      const Vec3D& N=PPtr->getNormal();
+      double dLow(-PPtr->getDistance());
+      double dHigh(-PPtr->getDistance());
+      for(size_t i=0;i<3;i++)
+	{
+	  const double A=N[i]*lowPt[i];
+	  const double B=N[i]*highPt[i];
+	  dLow+=std::min(A,B);
+	  dHigh+=std::max(A,B);
+	}
+      return (dLow<=0.0 && dHigh>=0.0);
+    }
+  
+  const Sphere* SPtr=dynamic_cast<const Sphere*>(&S);
+  if (SPtr)
+    {
+      const Vec3D& C=SPtr->getCentre();
+      const double R2=SPtr->getRadius()*SPtr->getRadius();
+      // nearest and furthest point of the box from the centre
+      double nearD(0.0);
+      double farD(0.0);
+      for(size_t i=0;i<3;i++)
+	{
+	  const double A=std::abs(lowPt[i]-C[i]);
+	  const double B=std::abs(highPt[i]-C[i]);
+	  if (C[i]<lowPt[i] || C[i]>highPt[i])
+	    nearD+=std::min(A,B)*std::min(A,B);
+	  farD+=std::max(A,B)*std::max(A,B);
+	}
+      return (nearD<=R2 && farD>=R2);
+    }
+  return 1;
+}
+
+size_t
+BoundBox::longAxis() const
+  /*!
+    Determine the longest axis of the box
+    \return index [0-2] of the longest axis
+  */
+{
+  size_t index(0);
+  double maxLen(highPt[0]-lowPt[0]);
+  for(size_t i=1;i<3;i++)
+    if (highPt[i]-lowPt[i]>maxLen)
+      {
+	maxLen=highPt[i]-lowPt[i];
+	index=i;
+      }
+  return index;
+}
+
+void
+BoundBox::write(std::ostream& OX) const
+  /*!
+    Write out the box to a stream
+    \param OX :: Output stream
+  */
+{
+  OX<<"("<<lowPt[0]<<","<<lowPt[1]<<","<<lowPt[2]<<") : ("
+    <<highPt[0]<<","<<highPt[1]<<","<<highPt[2]<<")";
+  return;
+}
+
+}  // NAMESPACE Geometry
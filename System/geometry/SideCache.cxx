@@ -0,0 +1,181 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geometry/SideCache.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <limits>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "SideCache.h"
+
+namespace Geometry
+{
+
+SideCache::SideCache() :
+  depth(0),generation(1)
+  /*!
+    Constructor
+  */
+{
+  const double nanV(std::numeric_limits<double>::quiet_NaN());
+  cachePt[0]=nanV;
+  cachePt[1]=nanV;
+  cachePt[2]=nanV;
+}
+
+SideCache&
+SideCache::Instance()
+  /*!
+    Singleton this : one per thread 
+    \return SideCache object
+   */
+{
+  static thread_local SideCache SC;
+  return SC;
+}
+
+void
+SideCache::nextGeneration()
+  /*!
+    Invalidate all the entries. On wrap the
+    generation array is cleared
+  */
+{
+  generation++;
+  if (!generation)
+    {
+      std::fill(genValue.begin(),genValue.end(),0);
+      generation=1;
+    }
+  return;
+}
+
+void
+SideCache::resize(const size_t N)
+  /*!
+    Extend the arrays to hold at least N slots
+    \param N :: Number of slots
+  */
+{
+  if (N>genValue.size())
+    {
+      sideValue.resize(N,0);
+      genValue.resize(N,0);
+    }
+  return;
+}
+
+void
+SideCache::begin()
+  /*!
+    Open a scope : the outer scope starts a new generation
+    since the surfaces may have moved between queries
+  */
+{
+  if (!depth)
+    {
+      nextGeneration();
+      resize(ModelSupport::surfIndex::Instance().cacheSize());
+    }
+  depth++;
+  return;
+}
+
+void
+SideCache::end()
+  /*!
+    Close a scope
+  */
+{
+  if (depth) depth--;
+  return;
+}
+
+int
+SideCache::side(const Surface& S,const Vec3D& Pt)
+  /*!
+    Get the side of a surface, using the cached value
+    if the surface has been tested at this point
+    \param S :: Surface 
+    \param Pt :: Point to test
+    \return side of S [-1/0/1]
+  */
+{
+  const size_t index(S.getCacheIndex());
+  if (!depth || !index)
+    return S.side(Pt);
+
+  // exact compare : Vec3D::operator== has a tolerance
+  if (Pt[0]!=cachePt[0] || Pt[1]!=cachePt[1] || Pt[2]!=cachePt[2])
+    {
+      cachePt[0]=Pt[0];
+      cachePt[1]=Pt[1];
+      cachePt[2]=Pt[2];
+      nextGeneration();
+    }
+  if (index>=genValue.size())
+    resize(index+1);
+
+  if (genValue[index]!=generation)
+    {
+      sideValue[index]=S.side(Pt);
+      genValue[index]=generation;
+    }
+  return sideValue[index];
+}
+
+SideScope::SideScope() :
+  SC(SideCache::Instance())
+  /*!
+    Constructor : open the scope
+  */
+{
+  SC.begin();
+}
+
+SideScope::~SideScope()
+  /*!
+    Destructor : close the scope
+  */
+{
+  SC.end();
+}
+
+}  // NAMESPACE Geometry
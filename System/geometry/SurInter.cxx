@@ -32,6 +32,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <typeinfo>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -285,15 +286,151 @@ calcIntersect(const Geometry::Cylinder& Cyl,const Geometry::Plane& Pln)
   return new Geometry::Ellipse(C-D*(sDist/cosTheta),minor,major,N);
 }
 
+int
+quadType(const Geometry::Quadratic* QPtr)
+  /*!
+    Get the type of a quadratic surface by its typeid
+    [no string compare or dynamic_cast chain]
+    \param QPtr :: Quadratic surface
+    \retval 1 :: Plane
+    \retval 2 :: Cylinder
+    \retval 3 :: Sphere
+    \retval 4 :: Cone
+    \retval 0 :: other quadratic
+  */
+{
+  const std::type_info& TI=typeid(*QPtr);
+  if (TI==typeid(Geometry::Plane)) return 1;
+  if (TI==typeid(Geometry::Cylinder)) return 2;
+  if (TI==typeid(Geometry::Sphere)) return 3;
+  if (TI==typeid(Geometry::Cone)) return 4;
+  return 0;
+}
+
+size_t
+lineIntersect(const Geometry::Line& Lx,const Geometry::Quadratic* QPtr,
+	      std::vector<Geometry::Vec3D>& Out)
+  /*!
+    Intersect a line with a quadratic using the closed
+    form for the surface type. Cones use the general quadratic
+    since Line::intersect(Cone) drops points on the cut
+    sheet and the polynomial solver does not.
+    \param Lx :: Line 
+    \param QPtr :: Quadratic surface
+    \param Out :: Points found [added to]
+    \return number of points added
+  */
+{
+  switch(quadType(QPtr))
+    {
+    case 1:
+      return Lx.intersect(Out,*static_cast<const Geometry::Plane*>(QPtr));
+    case 2:
+      return Lx.intersect(Out,*static_cast<const Geometry::Cylinder*>(QPtr));
+    case 3:
+      return Lx.intersect(Out,*static_cast<const Geometry::Sphere*>(QPtr));
+    default:
+      return Lx.intersect(Out,*QPtr);
+    }
+}
+
+int
+quadDiffPlane(const Geometry::Quadratic* A,const Geometry::Quadratic* B,
+	      Geometry::Plane& DPlane)
+  /*!
+    If the second order parts of A and B are proportional
+    [e.g. two spheres, parallel cylinders] then A-kB is
+    a plane that holds the intersection of A and B.
+    \param A :: First quadratic
+    \param B :: Second quadratic
+    \param DPlane :: Plane of A-kB [if found]
+    \retval 1 :: DPlane set
+    \retval 0 :: second order parts not proportional / A==B
+    \retval -1 :: surfaces can not intersect
+  */
+{
+  const std::vector<double>& AE=A->copyBaseEqn();
+  const std::vector<double>& BE=B->copyBaseEqn();
+
+  double AB(0.0),BB(0.0),AA(0.0);
+  for(size_t i=0;i<6;i++)
+    {
+      AB+=AE[i]*BE[i];
+      BB+=BE[i]*BE[i];
+      AA+=AE[i]*AE[i];
+    }
+  if (BB<Geometry::zeroTol || AA<Geometry::zeroTol)
+    return 0;
+
+  const double k=AB/BB;
+  for(size_t i=0;i<6;i++)
+    if (std::abs(AE[i]-k*BE[i])>Geometry::zeroTol*std::sqrt(AA))
+      return 0;
+
+  const Geometry::Vec3D N(AE[6]-k*BE[6],AE[7]-k*BE[7],AE[8]-k*BE[8]);
+  const double C(AE[9]-k*BE[9]);
+  const double NL=N.abs();
+  if (NL<Geometry::zeroTol)
+    return (std::abs(C)>Geometry::zeroTol) ? -1 : 0;
+
+  // N.x + C = 0
+  DPlane.setPlane(N,-C/NL);
+  return 1;
+}
+
+int
+cylPlanePoint(const Geometry::Plane* PPtr,const Geometry::Cylinder* CPtr,
+	      const Geometry::Quadratic* QPtr,
+	      std::vector<Geometry::Vec3D>& Out)
+  /*!
+    Intersect a plane/cylinder/quadratic triple if the cylinder
+    axis is in the plane. The plane cuts the cylinder in 
+    zero/one/two lines along the axis and each line is 
+    intersected with the quadratic.
+    \param PPtr :: Plane
+    \param CPtr :: Cylinder
+    \param QPtr :: Third surface
+    \param Out :: Points found [added to]
+    \return 1 if the kernel applies / 0 if not
+  */
+{
+  const Geometry::Vec3D& N=PPtr->getNormal();
+  const Geometry::Vec3D& D=CPtr->getNormal();
+  if (std::abs(N.dotProd(D))>=Geometry::zeroTol)
+    return 0;
+
+  const double r=CPtr->getRadius();
+  const double sDist=PPtr->distance(CPtr->getCentre());
+  if (std::abs(sDist)>r+Geometry::zeroTol) return 1;
+
+  // closest point on the plane to the axis
+  const Geometry::Vec3D IPt=CPtr->getCentre()-N*sDist;
+  const double mD=(std::abs(sDist)<r) ? std::sqrt(r*r-sDist*sDist) : 0.0;
+  if (mD<Geometry::zeroTol)
+    {
+      lineIntersect(Geometry::Line(IPt,D),QPtr,Out);
+      return 1;
+    }
+  const Geometry::Vec3D lNorm=(N*D).unit();
+  lineIntersect(Geometry::Line(IPt+lNorm*mD,D),QPtr,Out);
+  lineIntersect(Geometry::Line(IPt-lNorm*mD,D),QPtr,Out);
+  return 1;
+}
+
 std::vector<Geometry::Vec3D> 
 processPoint(const Geometry::Surface* ASPtr,
 	     const Geometry::Surface* BSPtr,
 	     const Geometry::Surface* CSPtr)
   /*! 
      Since Surface is abstract so the vector is 
-     of derived classes. This determines the derived class
-     name and case the surface (dynamic_cast) and uses this
-     object to dispatch to the intersection.
+     of derived classes. This determines the type of each
+     surface (typeid) and uses the closed form kernels if
+     possible :
+     - three planes / two planes + quadratic : line intersect
+     - two quadratics with the same second order part are 
+       reduced to a plane [sphere/sphere, parallel cylinders]
+     - plane + cylinder with axis in the plane : line pair
+     Other cases use the general polynomial solver.
      \param ASPtr :: Surface to use
      \param BSPtr :: Surface to use
      \param CSPtr :: Surface to use
@@ -305,14 +442,16 @@ processPoint(const Geometry::Surface* ASPtr,
   std::vector<Geometry::Vec3D> Out;
   const Geometry::Surface* SVec[3]={ASPtr,BSPtr,CSPtr};
   const Geometry::Quadratic* QVec[3]={0,0,0};
-  const Geometry::Plane* PVec[3]={0,0,0};
 
   if (ASPtr==BSPtr || CSPtr==BSPtr || ASPtr==CSPtr)
     return Out;
 
-  int planeN(0);       
-  int nonPlane(0);
-  for(int i=0;i<3;i++)
+  // Planes first then the other quadratics
+  const Geometry::Quadratic* SQ[3];
+  int SType[3];
+  size_t planeN(0);
+  size_t nonPlane(2);
+  for(size_t i=0;i<3;i++)
     { 
       QVec[i]=dynamic_cast<const Geometry::Quadratic*>(SVec[i]);
       if (!QVec[i]) 
@@ -324,27 +463,72 @@ processPoint(const Geometry::Surface* ASPtr,
 	    ELog::EM<<"Null surface passed Index:"<<i<<ELog::endErr;
 	  return Out;
 	}
-      
-      PVec[planeN]=dynamic_cast<const Geometry::Plane*>(SVec[i]);
-      if (PVec[planeN]) 
-	planeN++;
-      else
-	nonPlane=i;
+      const int QT=quadType(QVec[i]);
+      const size_t index((QT==1) ? planeN++ : nonPlane--);
+      SQ[index]=QVec[i];
+      SType[index]=QT;
     }
   
   if (planeN==3)          // All Plane:
+    return makePoint(static_cast<const Geometry::Plane*>(SQ[0]),
+		     static_cast<const Geometry::Plane*>(SQ[1]),
+		     static_cast<const Geometry::Plane*>(SQ[2]));
+
+  Geometry::Line Lx;
+  if (planeN==2)        // Make line + intersect:
     {
-      return makePoint(PVec[0],PVec[1],PVec[2]);
+      if (Lx.setLine(*static_cast<const Geometry::Plane*>(SQ[0]),
+		     *static_cast<const Geometry::Plane*>(SQ[1])))
+	lineIntersect(Lx,SQ[2],Out);
+      return Out;
     }
-  if (planeN==2)        // Make line + intersect:
+
+  // Reduce pairs of quadratics to a plane [j is kept]
+  Geometry::Plane DPlane[2];
+  size_t dIndex(0);
+  for(size_t i=planeN;i<2;i++)
+    for(size_t j=i+1;j<3 && SType[i]!=1;j++)
+      if (SType[j]!=1)
+	{
+	  const int flag=quadDiffPlane(SQ[i],SQ[j],DPlane[dIndex]);
+	  if (flag<0) return Out;
+	  if (flag)
+	    {
+	      SQ[i]=&DPlane[dIndex++];
+	      SType[i]=1;
+	      planeN++;
+	    }
+	}
+  // planes back to the front
+  for(size_t i=0;i<2;i++)
+    for(size_t j=i+1;j<3;j++)
+      if (SType[i]!=1 && SType[j]==1)
+	{
+	  std::swap(SQ[i],SQ[j]);
+	  std::swap(SType[i],SType[j]);
+	}
+  
+  if (planeN>=2)        
     {
-      Geometry::Line Lx;
-      if (Lx.setLine(*PVec[0],*PVec[1]))
-	Lx.intersect(Out,*QVec[nonPlane]);
+      if (Lx.setLine(*static_cast<const Geometry::Plane*>(SQ[0]),
+		     *static_cast<const Geometry::Plane*>(SQ[1])))
+	lineIntersect(Lx,SQ[2],Out);
       return Out;
     }
-  Out=makePoint(QVec[0],QVec[1],QVec[2]);
-  return Out;
+  
+  if (planeN==1)
+    {
+      const Geometry::Plane* PPtr=static_cast<const Geometry::Plane*>(SQ[0]);
+      if ((SType[1]==2 &&
+	   cylPlanePoint(PPtr,static_cast<const Geometry::Cylinder*>(SQ[1]),
+			 SQ[2],Out)) ||
+	  (SType[2]==2 &&
+	   cylPlanePoint(PPtr,static_cast<const Geometry::Cylinder*>(SQ[2]),
+			 SQ[1],Out)))
+	return Out;
+    }
+  
+  return makePoint(QVec[0],QVec[1],QVec[2]);
 }
 
 std::vector<Geometry::Vec3D>
@@ -64,14 +64,14 @@ operator<<(std::ostream& OX,const Surface& A)
 }
 
 Surface::Surface() : 
-  Name(-1),TransN(0)
+  Name(-1),TransN(0),cacheIndex(0)
   /*!
     Constructor
   */
 {}
 
 Surface::Surface(const int N,const int T) : 
-  Name(N),TransN(T)
+  Name(N),TransN(T),cacheIndex(0)
   /*!
     Constructor
     \param N :: Name 
@@ -80,9 +80,10 @@ Surface::Surface(const int N,const int T) :
 {}
 
 Surface::Surface(const Surface& A) : 
-  Name(A.Name),TransN(A.TransN)
+  Name(A.Name),TransN(A.TransN),cacheIndex(0)
   /*!
-    Copy constructor
+    Copy constructor : the copy is not in the surfIndex
+    so it does not share the cache slot
     \param A :: Surface to copy
   */
 {}
@@ -91,7 +92,7 @@ Surface::Surface(const Surface& A) :
 Surface&
 Surface::operator=(const Surface& A)
   /*!
-    Assignment operator
+    Assignment operator [cache slot is kept]
     \param A :: Surface to copy
     \return *this
   */
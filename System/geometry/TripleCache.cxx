@@ -0,0 +1,120 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geometry/TripleCache.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <tuple>
+#include <mutex>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "SurInter.h"
+#include "TripleCache.h"
+
+namespace Geometry
+{
+
+TripleCache::TripleCache() :
+  nHit(0),nMiss(0)
+  /*!
+    Constructor
+  */
+{}
+
+void
+TripleCache::clear()
+  /*!
+    Remove all the points
+  */
+{
+  std::lock_guard<std::mutex> Guard(lockMutex);
+  PMap.clear();
+  nHit=0;
+  nMiss=0;
+  return;
+}
+
+size_t
+TripleCache::size() const
+  /*!
+    Number of triples held
+    \return size of map
+  */
+{
+  std::lock_guard<std::mutex> Guard(lockMutex);
+  return PMap.size();
+}
+
+std::vector<Geometry::Vec3D>
+TripleCache::processPoint(const Surface* SA,const Surface* SB,
+			  const Surface* SC)
+  /*!
+    Get the intersection points of three surfaces. They are
+    calculated (outside the lock) if the triple is new.
+    \param SA :: First surface
+    \param SB :: Second surface
+    \param SC :: Third surface
+    \return points of intersection
+  */
+{
+  const Surface* SPtr[3]={SA,SB,SC};
+  std::sort(SPtr,SPtr+3,
+	    [](const Surface* A,const Surface* B)
+	    { return A->getName()<B->getName(); });
+  const KeyTYPE Key(SPtr[0]->getName(),SPtr[1]->getName(),
+		    SPtr[2]->getName());
+  {
+    std::lock_guard<std::mutex> Guard(lockMutex);
+    PTYPE::const_iterator mc=PMap.find(Key);
+    if (mc!=PMap.end())
+      {
+	nHit++;
+	return mc->second;
+      }
+  }
+  
+  std::vector<Geometry::Vec3D> Out=
+    SurInter::processPoint(SPtr[0],SPtr[1],SPtr[2]);
+  
+  std::lock_guard<std::mutex> Guard(lockMutex);
+  nMiss++;
+  // another thread may have added the same [identical] points
+  PMap.emplace(Key,Out);
+  return Out;
+}
+
+}  // NAMESPACE Geometry
@@ -0,0 +1,306 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/surfHash.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <typeinfo>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Quaternion.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Cylinder.h"
+#include "Cone.h"
+#include "Torus.h"
+#include "surfHash.h"
+
+namespace ModelSupport
+{
+
+/// Cell size : far above the largest scalar change of an equal surface
+const double surfHash::cellSize(100.0*Geometry::zeroTol);
+
+/// Unit weight vector to reduce a vector to a scalar
+static const Geometry::Vec3D
+WVec(0.5773502691896258,0.6324555320336759,0.5163977794943222);
+
+surfHash::surfHash(const Mode M) :
+  mode(M)
+  /*!
+    Constructor
+    \param M :: Equality mode
+  */
+{}
+
+surfHash::surfHash(const surfHash& A) :
+  mode(A.mode),Index(A.Index),SurfCell(A.SurfCell)
+  /*!
+    Copy constructor
+    \param A :: surfHash to copy
+  */
+{}
+
+surfHash&
+surfHash::operator=(const surfHash& A)
+  /*!
+    Assignment operator [mode is kept]
+    \param A :: surfHash to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Index=A.Index;
+      SurfCell=A.SurfCell;
+    }
+  return *this;
+}
+
+long int
+surfHash::cellIndex(const double V)
+  /*!
+    Convert a scalar to a cell index
+    \param V :: Scalar value
+    \return cell index
+  */
+{
+  const double maxCell(1e15);
+  const double C=std::floor(V/cellSize);
+  if (C>maxCell) return static_cast<long int>(maxCell);
+  if (C< -maxCell) return static_cast<long int>(-maxCell);
+  return static_cast<long int>(C);
+}
+
+size_t
+surfHash::cellKey(const size_t family,const long int cell)
+  /*!
+    Combine a family and a cell into a key
+    \param family :: Family of surface
+    \param cell :: Cell index
+    \return key
+  */
+{
+  size_t H=static_cast<size_t>(cell)*static_cast<size_t>(11400714819323198485ULL);
+  H^=family+static_cast<size_t>(0x9e3779b97f4a7c15ULL)+(H<<6)+(H>>2);
+  return H;
+}
+
+bool
+surfHash::keyValue(const Geometry::Surface* SPtr,
+		   size_t& family,double& V) const
+  /*!
+    Calculate the family and scalar of a surface.
+    The change in the scalar between two surfaces equal
+    within Geometry::zeroTol is less than 20*zeroTol.
+    \param SPtr :: Surface
+    \param family :: Family of surface
+    \param V :: Scalar of surface
+    \return false if the surface can not be equal to another
+  */
+{
+  const Geometry::Quadratic* QPtr=
+    dynamic_cast<const Geometry::Quadratic*>(SPtr);
+
+  if (mode==Mode::Quadratic && !QPtr)
+    return 0;
+
+  // Planes : equal within the same rules in both modes
+  const Geometry::Plane* PPtr=dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      family=(mode==Mode::Type) ? typeid(*SPtr).hash_code() : 1;
+      V=PPtr->getDistance()+PPtr->getNormal().dotProd(WVec);
+      return 1;
+    }
+
+  if (mode==Mode::Type)
+    {
+      family=typeid(*SPtr).hash_code();
+      V=0.0;
+      const Geometry::Sphere* SphPtr=
+	dynamic_cast<const Geometry::Sphere*>(SPtr);
+      if (SphPtr)
+	{
+	  V=SphPtr->getRadius()+SphPtr->getCentre().dotProd(WVec);
+	  return 1;
+	}
+      // centre can slide along the axis : axis can be reversed
+      const Geometry::Cylinder* CPtr=
+	dynamic_cast<const Geometry::Cylinder*>(SPtr);
+      if (CPtr)
+	{
+	  V=CPtr->getRadius()+std::abs(CPtr->getNormal().dotProd(WVec));
+	  return 1;
+	}
+      const Geometry::Cone* KPtr=dynamic_cast<const Geometry::Cone*>(SPtr);
+      if (KPtr)
+	{
+	  V=KPtr->getCosAngle()+KPtr->getCentre().dotProd(WVec)+
+	    KPtr->getNormal().dotProd(WVec);
+	  return 1;
+	}
+      const Geometry::Torus* TPtr=
+	dynamic_cast<const Geometry::Torus*>(SPtr);
+      if (TPtr)
+	{
+	  V=TPtr->getIRad()+TPtr->getORad()+
+	    TPtr->getCentre().dotProd(WVec)+TPtr->getNormal().dotProd(WVec);
+	  return 1;
+	}
+      // other non-quadratic surfaces share one cell
+      if (!QPtr) return 1;
+    }
+  else
+    family=2;
+
+  // Quadratic equality : all coefficients equal or all opposite
+  const std::vector<double>& BE=QPtr->copyBaseEqn();
+  V=0.0;
+  for(size_t i=0;i<BE.size();i++)
+    V+=std::abs(BE[i])/(1.0+0.1*static_cast<double>(i));
+  return 1;
+}
+
+void
+surfHash::clear()
+  /*!
+    Remove all the surfaces
+  */
+{
+  Index.clear();
+  SurfCell.clear();
+  return;
+}
+
+void
+surfHash::build(const std::map<int,Geometry::Surface*>& SMap)
+  /*!
+    Build the index from a set of surfaces
+    \param SMap :: Surfaces to index
+  */
+{
+  clear();
+  Index.reserve(SMap.size());
+  SurfCell.reserve(SMap.size());
+  for(const std::map<int,Geometry::Surface*>::value_type& SM : SMap)
+    insert(SM.second);
+  return;
+}
+
+void
+surfHash::insert(Geometry::Surface* SPtr)
+  /*!
+    Add a surface to the index [moved if already present]
+    \param SPtr :: Surface to add
+  */
+{
+  if (!SPtr) return;
+  erase(SPtr);
+
+  size_t family;
+  double V;
+  if (!keyValue(SPtr,family,V))
+    return;
+  const size_t key=cellKey(family,cellIndex(V));
+  Index[key].push_back(SPtr);
+  SurfCell.emplace(SPtr,key);
+  return;
+}
+
+void
+surfHash::erase(const Geometry::Surface* SPtr)
+  /*!
+    Remove a surface from the index. The cell held for
+    the surface is used so a changed surface is removed.
+    \param SPtr :: Surface to remove
+  */
+{
+  std::unordered_map<const Geometry::Surface*,size_t>::iterator mc=
+    SurfCell.find(SPtr);
+  if (mc==SurfCell.end()) return;
+
+  std::unordered_map<size_t,std::vector<Geometry::Surface*>>::iterator
+    ic=Index.find(mc->second);
+  if (ic!=Index.end())
+    {
+      std::vector<Geometry::Surface*>& SVec=ic->second;
+      std::vector<Geometry::Surface*>::iterator vc=
+	std::find(SVec.begin(),SVec.end(),SPtr);
+      if (vc!=SVec.end())
+	{
+	  *vc=SVec.back();
+	  SVec.pop_back();
+	}
+      if (SVec.empty())
+	Index.erase(ic);
+    }
+  SurfCell.erase(mc);
+  return;
+}
+
+std::map<int,Geometry::Surface*>
+surfHash::findCandidates(const Geometry::Surface* SPtr) const
+  /*!
+    Find the surfaces that could be equal to SPtr.
+    This includes SPtr if it is indexed.
+    \param SPtr :: Surface to test
+    \return map of surface number : surface [sorted as the main map]
+  */
+{
+  std::map<int,Geometry::Surface*> Out;
+  size_t family;
+  double V;
+  if (!SPtr || !keyValue(SPtr,family,V))
+    return Out;
+
+  const long int cell=cellIndex(V);
+  for(long int i=cell-1;i<=cell+1;i++)
+    {
+      std::unordered_map<size_t,std::vector<Geometry::Surface*>>::
+	const_iterator ic=Index.find(cellKey(family,i));
+      if (ic!=Index.end())
+	for(Geometry::Surface* CPtr : ic->second)
+	  Out.emplace(CPtr->getName(),CPtr);
+    }
+  return Out;
+}
+
+}  // NAMESPACE ModelSupport
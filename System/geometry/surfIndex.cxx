@@ -26,6 +26,7 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <list>
 #include <stack>
 #include <string>
@@ -61,6 +62,7 @@
 #include "surfEqual.h"
 #include "surfaceFactory.h"
 #include "surfRegister.h"
+#include "surfHash.h"
 #include "surfIndex.h"
 
 #include "Debug.h"
@@ -68,7 +70,9 @@
 namespace ModelSupport
 {
 
-surfIndex::surfIndex() : uniqNum(1)
+surfIndex::surfIndex() :
+  uniqNum(1),nCacheIndex(0),
+  EqHash(new surfHash(surfHash::Mode::Type))
   /*!
     Constructor
   */
@@ -93,6 +97,7 @@ surfIndex::~surfIndex()
   STYPE::iterator mc;
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
+  delete EqHash;
 }
 
 void
@@ -105,6 +110,35 @@ surfIndex::reset()
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
   SMap.erase(SMap.begin(),SMap.end());
+  EqHash->clear();
+  hashPend.clear();
+  nCacheIndex=0;
+  return;
+}
+
+void
+surfIndex::eraseSurf(STYPE::iterator mc)
+  /*!
+    Delete a surface and remove it from the map and index
+    \param mc :: Iterator to surface
+  */
+{
+  EqHash->erase(mc->second);
+  delete mc->second;
+  SMap.erase(mc);
+  return;
+}
+
+void
+surfIndex::setCacheIndex(Geometry::Surface* SPtr)
+  /*!
+    Give a surface entering the map a SideCache slot.
+    A renumbered surface keeps its slot.
+    \param SPtr :: Surface to index
+  */
+{
+  if (!SPtr->getCacheIndex())
+    SPtr->setCacheIndex(++nCacheIndex);
   return;
 }
 
@@ -143,7 +177,11 @@ surfIndex::addSurface(Geometry::Surface* SPtr)
   Geometry::Surface* NewPtr=ModelSupport::equalSurface(SPtr);
   // Now find if we have copy
   if (NewPtr==SPtr)
-    SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+    {
+      setCacheIndex(SPtr);
+      SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+      EqHash->insert(SPtr);
+    }
   else
     delete SPtr;
 
@@ -183,7 +221,9 @@ surfIndex::insertSurface(Geometry::Surface* SPtr)
 	(SPtr->getName(),"SPtr name");
     }
 
+  setCacheIndex(SPtr);
   SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+  EqHash->insert(SPtr);
 
   return;
 }
@@ -220,10 +260,7 @@ surfIndex::removeOpposite(const int SN)
 
   STYPE::iterator sc=SMap.find(SN);
   if (sc!=SMap.end())
-    {
-      delete sc->second;
-      SMap.erase(sc);
-    }
+    eraseSurf(sc);
 
   return;
 }
@@ -246,10 +283,7 @@ surfIndex::removeEqualSurface(const int SNum)
     ModelSupport::equalSurface(vc->second);
   
   if (NewPtr!=vc->second)
-    {
-      delete vc->second;
-      SMap.erase(vc);
-    }
+    eraseSurf(vc);
   return NewPtr;
 }
 
@@ -281,19 +315,24 @@ surfIndex::createSurf(const int surfN)
   
   T* outPtr;
   
+  // surface is set by the caller : key at next lookup
+  hashPend.push_back(surfN);
   STYPE::iterator mp=SMap.find(surfN);
   if (mp!=SMap.end())
     {
       outPtr=dynamic_cast<T*>(mp->second);
       if (outPtr)
 	return outPtr;
+      EqHash->erase(mp->second);
       delete mp->second;
       outPtr=new T(surfN,0);
+      setCacheIndex(outPtr);
       mp->second=outPtr;
       ELog::EM<<"Reasigned exiting surface"<<surfN<<ELog::endWarn;
       return outPtr;
     }
   outPtr=new T(surfN,0);
+  setCacheIndex(outPtr);
   SMap.insert(STYPE::value_type(surfN,outPtr));
   return outPtr;
 }
@@ -368,7 +407,9 @@ surfIndex::createSurface(const int SN,const int TN,const std::string& SLine)
   STYPE::iterator mc=SMap.find(SN);
   if (mc!=SMap.end())
     throw ColErr::InContainerError<int>(SN,"Surface in use");
+  setCacheIndex(SPtr);
   SMap.emplace(SN,SPtr);
+  EqHash->insert(SPtr);
   return; 
 }
 
@@ -385,9 +426,7 @@ surfIndex::deleteSurface(const int surfN)
   if (mf==SMap.end())
     throw ColErr::InContainerError<int>(surfN,"surfN");
 
-  delete mf->second;
-  SMap.erase(mf);
-
+  eraseSurf(mf);
   return;
 }
 
@@ -442,6 +481,36 @@ surfIndex::renumber(const int origNum,const int newNum)
   return;
 }
 
+void
+surfIndex::renumber(const std::map<int,int>& RMap)
+  /*!
+    Convert all the surfaces in the map at once. All are
+    removed before any are re-inserted so the new numbers
+    can be old numbers of other surfaces.
+    \param RMap :: map of original number : new number
+  */
+{
+  ELog::RegMethod RegA("surfIndex","renumber(map)");
+
+  std::vector<Geometry::Surface*> SVec;
+  for(const std::map<int,int>::value_type& RItem : RMap)
+    {
+      STYPE::iterator mc=SMap.find(RItem.first);
+      if (mc==SMap.end())
+	{
+	  ELog::EM<<"Surface "<<RItem.first<<" does not exist"<<ELog::endWarn;
+	  continue;
+	}
+      mc->second->setName(RItem.second);
+      SVec.push_back(mc->second);
+      SMap.erase(mc);
+    }
+  // insertSurface checks for a new number in use
+  for(Geometry::Surface* SPtr : SVec)
+    insertSurface(SPtr);
+  return;
+}
+
 int
 surfIndex::calcRenumber(const int allowedSurf,
 			std::vector<std::pair<int,int> >& ChangeList) const
@@ -776,32 +845,71 @@ surfIndex::processSurfaces(const std::string& InputLine)
   return 1;
 }
 
+void
+surfIndex::reindex()
+  /*!
+    Rebuild the equal surface index after the surfaces
+    have been changed in place [e.g. transforms]
+  */
+{
+  ELog::RegMethod RegA("surfIndex","reindex");
+  EqHash->build(SMap);
+  hashPend.clear();
+  return;
+}
+
+surfIndex::STYPE
+surfIndex::equalCandidates(const Geometry::Surface* SPtr)
+  /*!
+    Get the surfaces that could be equal to SPtr
+    [by the surface type operator==]. Pending surfaces
+    from createSurf are keyed first.
+    \param SPtr :: Surface to find
+    \return map of possible surfaces [in SMap order]
+  */
+{
+  for(const int SN : hashPend)
+    {
+      STYPE::const_iterator mc=SMap.find(SN);
+      if (mc!=SMap.end())
+	EqHash->insert(mc->second);
+    }
+  hashPend.clear();
+  return EqHash->findCandidates(SPtr);
+}
+
 int
 surfIndex::findEqualSurf(const int sBegin,const int sEnd,
 			 std::map<int,Geometry::Surface*>& EQMap) const
   /*!
-    Loop [long] though and find equal surfaces
+    Find the surfaces in the range that are equal to
+    an earlier surface or one outside the range. Only the
+    surfaces in the same hash cell are compared.
     \param sBegin :: begining number
-    \param sBegin :: end number
+    \param sEnd :: end number [not included]
     \param EQMap :: Map of equal surfaces
     \return number found
    */
 {
+  ELog::RegMethod RegA("surfIndex","findEqualSurf");
+  
   typedef std::map<int,Geometry::Surface*> EQTYPE;
+
+  surfHash QHash(surfHash::Mode::Quadratic);
+  QHash.build(SMap);
+  
   STYPE::const_iterator mc;
-  STYPE::const_iterator nc;
-  for(mc=SMap.begin();mc!=SMap.end();mc++)
+  for(mc=SMap.lower_bound(sBegin);
+      mc!=SMap.end() && mc->first<sEnd;mc++)
     {
-      if (mc->first>=sBegin && mc->first<sEnd)
+      const STYPE CMap=QHash.findCandidates(mc->second);
+      for(const STYPE::value_type& NC : CMap)
 	{
-	  for(nc=SMap.begin();nc!=SMap.end();nc++)
+	  if ((NC.first<sBegin || NC.first>mc->first) &&
+	      ModelSupport::cmpSurfaces(mc->second,NC.second))
 	    {
-	      if ((nc->first<sBegin || nc->first>mc->first) &&
-		  ModelSupport::cmpSurfaces(mc->second,nc->second))
-		{
-		  EQMap.insert(EQTYPE::value_type(mc->first,nc->second));
-		  break;
-		}		  
+	      EQMap.insert(EQTYPE::value_type(mc->first,NC.second));
+	      break;
 	    }
 	}
     }
@@ -810,7 +918,6 @@ surfIndex::findEqualSurf(const int sBegin,const int sEnd,
 
 
 
-
 ///\cond TEMPLATE 
 
 template Geometry::Sphere* 
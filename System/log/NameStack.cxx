@@ -38,7 +38,7 @@ NameStack::NameStack() :
 
 NameStack::NameStack(const NameStack& A) :
   key(A.key),Class(A.Class),Method(A.Method),
-  Extra(A.Extra),extraLevel(A.extraLevel),
+  Extra(A.Extra),Unwind(A.Unwind),extraLevel(A.extraLevel),
   indentLevel(A.indentLevel)
   /*!
     Copy Constructor
@@ -60,6 +60,7 @@ NameStack::operator=(const NameStack& A)
       Class=A.Class;
       Method=A.Method;
       Extra=A.Extra;
+      Unwind=A.Unwind;
       extraLevel=A.extraLevel;
       indentLevel=A.indentLevel;
     }
@@ -76,16 +77,17 @@ NameStack::clear()
   Class.clear();
   Method.clear();
   Extra.clear();
+  Unwind.clear();
   extraLevel=0;
   indentLevel=0;
   return;
 }
 
 void
-NameStack::addComp(const std::string& CN,
-		   const std::string& MN)
+NameStack::addComp(const char* CN,const char* MN)
   /*!
-    Adds a component to the class names series
+    Adds a component to the class names series.
+    The strings must exist until the item is popped.
     \param CN :: Class name
     \param MN :: Method name
   */
@@ -144,7 +146,7 @@ NameStack::getBase() const
   */
 {
   return (Class.empty()) ?  
-    "" : Class.back()+"::"+Method.back();
+    "" : std::string(Class.back())+"::"+Method.back();
 }
 
 std::string
@@ -158,7 +160,7 @@ NameStack::getItem(const long int Index) const
 {
   if (Class.empty()) return "";
   if (!Index) 
-    return Class.back()+"::"+Method.back();
+    return std::string(Class.back())+"::"+Method.back();
   
   const size_t CSize=Class.size();
  
@@ -166,23 +168,24 @@ NameStack::getItem(const long int Index) const
 		    ? (CSize-static_cast<size_t>(1-Index)) 
 		    : static_cast<size_t>(Index));
 
-  return (itx<CSize) ? Class[itx]+"::"+Method[itx] : "";
+  return (itx<CSize) ? std::string(Class[itx])+"::"+Method[itx] : "";
 } 
 
 std::string
 NameStack::getFull() const 
   /*!
     Return the base component
-    \return BaseItem
+    \return BaseItem [empty if no items : tracing off]
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
-  std::string Out=*vc+"::"+*ac;
+  if (Class.empty()) return "";
+  std::vector<const char*>::const_iterator vc(Class.begin());
+  std::vector<const char*>::const_iterator ac(Method.begin());
+  std::string Out=std::string(*vc)+"::"+*ac;
   for(ac++,vc++;vc!=Class.end();vc++,ac++)
     {
       Out+="#";
-      Out+=*vc+"::"+*ac;
+      Out+=std::string(*vc)+"::"+*ac;
     }
   if (!Extra.empty())
     {
@@ -196,18 +199,19 @@ std::string
 NameStack::getFullTree() const 
   /*!
     Return the base component
-    \return BaseItem
+    \return BaseItem [empty if no items : tracing off]
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
+  if (Class.empty()) return "";
+  std::vector<const char*>::const_iterator vc(Class.begin());
+  std::vector<const char*>::const_iterator ac(Method.begin());
   size_t indent(2);
-  std::string Out=*vc+"::"+*ac;
+  std::string Out=std::string(*vc)+"::"+*ac;
   for(ac++,vc++;vc!=Class.end();vc++,ac++,indent+=2)
     {
       Out+='\n';
       Out+=std::string(indent,' ');
-      Out+=*vc+"::"+*ac;
+      Out+=std::string(*vc)+"::"+*ac;
     }
   if (!Extra.empty())
     {
@@ -217,6 +221,40 @@ NameStack::getFullTree() const
   return Out;
 }
 
+void
+NameStack::addUnwind(const char* CN,const char* MN)
+  /*!
+    Add a frame removed by an exception [tracing off].
+    The names are copied as the owner is being destroyed.
+    Frames are added innermost first.
+    \param CN :: Class name
+    \param MN :: Method name
+  */
+{
+  Unwind.push_back(std::string(CN)+"::"+MN);
+  return;
+}
+
+std::string
+NameStack::getUnwindTree() const 
+  /*!
+    Return the frames left by the last exception
+    in the same form as getFullTree
+    \return Tree [empty if no frames]
+  */
+{
+  std::string Out;
+  size_t indent(0);
+  std::vector<std::string>::const_reverse_iterator vc;
+  for(vc=Unwind.rbegin();vc!=Unwind.rend();vc++,indent+=2)
+    {
+      if (indent)
+	Out+='\n';
+      Out+=std::string(indent,' ')+*vc;
+    }
+  return Out;
+}
+
 void
 NameStack::addIndent(const long int N) 
   /*!
@@ -26,6 +26,8 @@
 #include <sstream>
 #include <map>
 #include <vector>
+#include <mutex>
+#include <thread>
 #include <boost/format.hpp>
 
 #include "Exception.h"
@@ -37,6 +39,11 @@
 namespace ELog
 {
 
+/// Thread that owns the member stream of the logs
+const std::thread::id mainThread(std::this_thread::get_id());
+/// Serialises the reports of all the logs
+std::mutex logMutex;
+
 template<typename RepClass>
 OutputLog<RepClass>::OutputLog() :
   colourFlag(0),activeBits(255),actionBits(0),
@@ -116,6 +123,24 @@ OutputLog<RepClass>::~OutputLog()
   */
 {}
 
+template<typename RepClass>
+std::ostringstream&
+OutputLog<RepClass>::stream()
+  /*!
+    Get the message stream of the calling thread. 
+    The main thread uses the member stream, other threads
+    have their own stream so messages are not interleaved.
+    \return message stream
+  */
+{
+  if (std::this_thread::get_id()==mainThread)
+    return cx;
+
+  thread_local std::map<const OutputLog<RepClass>*,
+			std::ostringstream> threadCX;
+  return threadCX[this];
+}
+
 template<typename RepClass>
 bool
 OutputLog<RepClass>::isActive(const int Flag) const
@@ -223,6 +248,7 @@ OutputLog<RepClass>::report(const std::string& M,const int T)
     \param T :: Type of error 
   */
 {
+  std::lock_guard<std::mutex> Lock(logMutex);
   static int length(0);
 
   std::string cxItem=M;
@@ -299,8 +325,10 @@ OutputLog<RepClass>::report(const int T)
     \param T :: Type of error 
   */
 {
-  report(cx.str(),T);
-  cx.str("");
+  std::ostringstream& tx=stream();
+  const std::string M(tx.str());
+  tx.str("");
+  report(M,T);
   makeAction(T);
   return;
 }
@@ -487,6 +515,7 @@ OutputLog<RepClass>::disLevel(const int levelFlag)
     \param levelFlag to dispatch [low is more]
   */
 {
+  std::lock_guard<std::mutex> Lock(logMutex);
   std::ostringstream cx;
   cx<<"Log BEGIN: Dispatch at level "<<levelFlag;
   FOut.process(cx.str(),0);
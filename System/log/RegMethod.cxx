@@ -23,6 +23,7 @@
 #include <sstream>
 #include <map>
 #include <vector>
+#include <exception>
 
 #include <iostream>
 
@@ -33,25 +34,26 @@
 namespace ELog
 {
 
-NameStack RegMethod::Base;
+bool RegMethod::traceFlag(1);
+thread_local NameStack RegMethod::Base;
+thread_local bool RegMethod::unwindFlag(0);
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN) :
-  indentLevel(0)
+  active(traceFlag),indentLevel(0),CName(0),MName(0),NameBuf(0)
   /*!
     Constructor add name to stack
     \param CN :: Class name
     \param MN :: Method name
   */
 {
-  Base.addComp(CN,MN);
-
+  setNames(CN,MN);
 }
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN,
 		     const int param) :
-  indentLevel(0)
+  active(traceFlag),indentLevel(0),CName(0),MName(0),NameBuf(0)
   /*!
     Constructor add name to stack
     \param CN :: Class name
@@ -60,18 +62,90 @@ RegMethod::RegMethod(const std::string& CN,
   */
 {
   std::ostringstream cx;
-  cx<<"<"<<param<<">";
-  Base.addComp(CN+cx.str(),MN);
+  cx<<CN<<"<"<<param<<">";
+  setNames(cx.str(),MN);
 }
 
-RegMethod::~RegMethod() 
+void
+RegMethod::setNames(const std::string& CN,const std::string& MN)
   /*!
-    Destructor removes one from the stack
+    Copy the names into a single buffer [CN\0MN\0] 
+    and register them if tracing is on. The copy is
+    also needed with tracing off for the unwind.
+    \param CN :: Class name
+    \param MN :: Method name
+  */
+{
+  NameBuf=new char[CN.size()+MN.size()+2];
+  CN.copy(NameBuf,CN.size());
+  NameBuf[CN.size()]=0;
+  MN.copy(NameBuf+CN.size()+1,MN.size());
+  NameBuf[CN.size()+MN.size()+1]=0;
+  CName=NameBuf;
+  MName=NameBuf+CN.size()+1;
+  if (active)
+    Base.addComp(CName,MName);
+  return;
+}
+
+void
+RegMethod::popStack() 
+  /*!
+    Remove the names of this object from the stack
   */
 {
   Base.popBack();
   if (indentLevel) 
     Base.addIndent(-indentLevel);
+  delete [] NameBuf;
+  return;
+}
+
+void
+RegMethod::leaveStack() 
+  /*!
+    Tracing off : if the object is being removed
+    by an exception add the names to the unwind list
+    so the exception keeps the call stack from the 
+    throw point to the catch. The first removal after
+    the catch ends the unwind.
+  */
+{
+  if (unwindFlag)
+    {
+      if (std::uncaught_exception())
+	Base.addUnwind(CName,MName);
+      else
+	unwindFlag=0;
+    }
+  delete [] NameBuf;
+  return;
+}
+
+void
+RegMethod::startUnwind()
+  /*!
+    Called as an exception is made : clear the old
+    unwind frames and [tracing off] record the frames
+    removed by the throw
+  */
+{
+  Base.clearUnwind();
+  unwindFlag=!traceFlag;
+  return;
+}
+
+void
+RegMethod::setTrace(const bool A)
+  /*!
+    Turn the registration of names on/off. Must be set
+    before any threads are started. Objects already 
+    registered are removed as normal.
+    \param A :: Tracing flag [0 : RegMethod is a no-op]
+  */
+{
+  traceFlag=A;
+  return;
 }
 
 void
@@ -102,8 +176,11 @@ RegMethod::incIndent()
     Increase the indent level
   */
 {
-  indentLevel+=2;
-  Base.addIndent(2);
+  if (active)
+    {
+      indentLevel+=2;
+      Base.addIndent(2);
+    }
   return;
 }
 
@@ -113,8 +190,11 @@ RegMethod::decIndent()
     Increase the indent level
   */
 {
-  indentLevel-=2;
-  Base.addIndent(-2);
+  if (active)
+    {
+      indentLevel-=2;
+      Base.addIndent(-2);
+    }
   return;
 }
 
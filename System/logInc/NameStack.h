@@ -28,17 +28,24 @@ namespace ELog
     \class NameStack 
     \brief Holds a list of items for a calling stack
     \author S. Ansell
-    \version 1.0
+    \version 1.1
     \date June 2009
+
+    The names are held as pointers to the caller's strings
+    (normally literals) so that registration is a pointer push.
+    The strings are only built when the stack is written.
+    With tracing off the frames left by an exception are
+    copied [Unwind] so the exception still has a call stack.
   */
 class NameStack
 {
  private:
 
   std::map<std::string,int> key;        ///< Key names
-  std::vector<std::string> Class;       ///< Class Name
-  std::vector<std::string> Method;      ///< Method Name
+  std::vector<const char*> Class;       ///< Class Name
+  std::vector<const char*> Method;      ///< Method Name
   std::string Extra;                    ///< Extra tag if neeed
+  std::vector<std::string> Unwind;      ///< Frames left by an exception
   size_t extraLevel;                    ///< Extra tag if neeed
   long int indentLevel;                 ///< Indent level
 
@@ -55,14 +62,18 @@ class NameStack
   void setExtra(const std::string&);
   /// Remove extra output for exception [early]
   void clearExtra() { Extra.clear(); }
-  void addComp(const std::string&,const std::string&);
+  void addComp(const char*,const char*);
   void popBack();
+  void addUnwind(const char*,const char*);
+  /// Remove the unwound frames [new exception]
+  void clearUnwind() { Unwind.clear(); }
 
   
   std::string getBase() const;
   std::string getItem(const long int) const;
   std::string getFull() const;
   std::string getFullTree() const;
+  std::string getUnwindTree() const;
   const std::string& getExtra() const;
 
   /// Access depth of function:
@@ -52,6 +52,10 @@ namespace ELog
   class which decides the policy for what to do
   with the Error data when it is recieved. 
 
+  Each thread builds its message in its own stream and
+  the report of a completed message is serialised, so
+  worker threads can write to the global logs.
+
   activeBits 
   - 1 : Basic 
   - 2 : Warning
@@ -67,7 +71,7 @@ class OutputLog
 {
  private:
   
-  std::ostringstream cx;            ///< Stream for processing
+  std::ostringstream cx;            ///< Stream for processing [main thread]
 
   int colourFlag;                   ///< Activate colour
   size_t activeBits;                ///< Activity bits
@@ -83,6 +87,7 @@ class OutputLog
   std::vector<std::string> EText;   ///< Storage buffer (text)
   std::vector<int> EType;           ///< Storage buffer (type)
 
+  std::ostringstream& stream();
   bool isActive(const int) const;
   std::string getColour(const int) const;
   void makeAction(const int);
@@ -102,7 +107,7 @@ class OutputLog
   void report(const std::string&,const int);
   void report(const int);
 
-  std::ostringstream& Estream() { return cx; }   ///< Access stream
+  std::ostringstream& Estream() { return stream(); }   ///< Access stream
 
   /// Set Pointer
   void setNBasePtr(NameStack* Ptr) { NBasePtr=Ptr; } 
@@ -112,12 +117,12 @@ class OutputLog
   /// Template specialization to get input
   template<typename InputType>
   OutputLog& operator<<(const InputType& A)
-    { cx<<A; return *this; }
+    { stream()<<A; return *this; }
   
   /// Special to pick up modifications to the stream
   OutputLog& operator<<(std::ostream& (*f)(std::ostream&) )
     {
-      f(cx);
+      f(stream());
       return *this;
     }
 
@@ -33,15 +33,35 @@ namespace ELog
 
     This class is called as a registration class.
     It keeps location etc possible for 
+    
+    Literal names are registered as pointers only so the
+    cost on hot paths is a push/pop of two pointers. Names
+    built at run time are held in one owned buffer. The
+    string of the stack is only made on output/exception.
+    With tracing off [setTrace(0)] nothing is registered:
+    after an exception is made [startUnwind] the names are 
+    written if the object is destroyed by the throw 
+    [see getUnwind].
   */
 
 class RegMethod
 {
  private:
 
-  static NameStack Base;           ///< Singleton of base to register
+  static bool traceFlag;               ///< Register names [0 : no-op]
+  static thread_local NameStack Base;  ///< Base to register [per thread]
+  static thread_local bool unwindFlag; ///< Exception made [tracing off]
 
+  bool active;                     ///< Names registered by this object
   int indentLevel;                 ///< Additional indent
+  const char* CName;               ///< Class name
+  const char* MName;               ///< Method name
+  char* NameBuf;                   ///< Owned names [if not literal]
+
+  void setNames(const std::string&,const std::string&);
+  void popStack();
+  void leaveStack();
+
   /// \cond NOWRITTEN
   RegMethod(const RegMethod&);
   RegMethod& operator=(const RegMethod&);
@@ -51,9 +71,19 @@ class RegMethod
 
   /// Access NameStack pointer
   NameStack* getBasePtr() { return &Base; }
+  /// Literal names [not copied] : not registered if tracing is off
+  RegMethod(const char* CN,const char* MN) :
+    active(traceFlag),indentLevel(0),CName(CN),MName(MN),NameBuf(0)
+    { if (active) Base.addComp(CN,MN); }
   RegMethod(const std::string&,const std::string&);
   RegMethod(const std::string&,const std::string&,const int);
-  ~RegMethod();
+  /// Destructor : remove the names [or record them on an unwind]
+  ~RegMethod() 
+    { if (active) popStack(); else if (unwindFlag || NameBuf) leaveStack(); }
+
+  static void setTrace(const bool);
+  /// Tracing state
+  static bool getTrace() { return traceFlag; }
 
   void setTrack(const std::string&);
   void clearTrack();
@@ -64,6 +94,9 @@ class RegMethod
   static std::string getFull() { return Base.getFullTree(); }
   /// Access particular item 
   static std::string getItem(const int I) { return Base.getItem(I); }
+  /// Access frames removed by the last exception [tracing off]
+  static std::string getUnwind() { return Base.getUnwindTree(); }
+  static void startUnwind();
 
   void incIndent();
   void decIndent();
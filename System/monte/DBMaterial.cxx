@@ -19,6 +19,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
  *
  ****************************************************************************/
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -43,6 +44,7 @@
 #include "OutputLog.h"
 #include "support.h"
 #include "stringCombine.h"
+#include "fileSupport.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "Element.h"
@@ -50,17 +52,41 @@
 #include "MXcards.h"
 #include "Material.h"
 #include "DBMaterial.h"
+#include "ThreadControl.h"
 
 namespace ModelSupport
 {
 
+std::string DBMaterial::snapFile;
+
+/*!
+  Stamp of the snapshot : it holds the compile time of this 
+  file, so any change to initMaterial/initMXUnits [which 
+  recompiles it] makes an old snapshot file be rebuilt.
+*/
+const std::string 
+DBMaterial::snapStamp("CombLayer:DBMaterial:" __DATE__ " " __TIME__);
+
+/*!
+  Version of the snapshot binary layout : increment on 
+  any change to the Material/MXcards binary format.
+*/
+const int DBMaterial::snapVersion(2);
+
 DBMaterial::DBMaterial() 
   /*!
-    Constructor
+    Constructor : The default materials are read from
+    the snapshot file if it has the current snapStamp/snapVersion,
+    otherwise they are built and the snapshot is written.
   */
 {
-  initMaterial();
-  initMXUnits();
+  if (snapFile.empty() || !readSnapshot(snapFile))
+    {
+      initMaterial();
+      initMXUnits();
+      if (!snapFile.empty())
+	writeSnapshot(snapFile);
+    }
 }
 
 DBMaterial&
@@ -152,6 +178,109 @@ DBMaterial::readFile(const std::string& FName)
   return;
 }
 
+void
+DBMaterial::setSnapshot(const std::string& FName)
+  /*!
+    Set the snapshot file of the default materials.
+    Only has an effect before the first call to Instance()
+    \param FName :: Filename [empty to turn off]
+   */
+{
+  snapFile=FName;
+  return;
+}
+
+void
+DBMaterial::writeSnapshot(const std::string& FName) const
+  /*!
+    Write the material store and the name index to a
+    binary snapshot file
+    \param FName :: Filename
+   */
+{
+  ELog::RegMethod RegA("DBMaterial","writeSnapshot");
+
+  const std::string TmpName=StrFunc::tempFileName(FName);
+  std::ofstream OX(TmpName.c_str(),std::ios::binary);
+  if (!OX.good())
+    {
+      ELog::EM<<"Unable to open material snapshot :"
+	      <<TmpName<<ELog::endWarn;
+      return;
+    }
+
+  StrFunc::writeBinary(OX,snapStamp);
+  StrFunc::writeBinary(OX,snapVersion);
+  StrFunc::writeBinary(OX,MStore.size());
+  for(const MTYPE::value_type& MItem : MStore)
+    MItem.second.writeBinary(OX);
+
+  StrFunc::writeBinary(OX,IndexMap.size());
+  for(const SCTYPE::value_type& SItem : IndexMap)
+    {
+      StrFunc::writeBinary(OX,SItem.first);
+      StrFunc::writeBinary(OX,SItem.second);
+    }
+  OX.close();
+  if (OX.fail() || StrFunc::replaceFile(TmpName,FName))
+    {
+      std::remove(TmpName.c_str());
+      ELog::EM<<"Unable to write material snapshot :"
+	      <<FName<<ELog::endWarn;
+    }
+  return;
+}
+
+bool
+DBMaterial::readSnapshot(const std::string& FName)
+  /*!
+    Replace the material store and the name index from
+    a binary snapshot file. The store is unchanged if the file
+    is missing, from a different build [snapStamp], of a 
+    different snapVersion or corrupt.
+    \param FName :: Filename
+    \return true on success
+   */
+{
+  ELog::RegMethod RegA("DBMaterial","readSnapshot");
+
+  std::ifstream IX(FName.c_str(),std::ios::binary);
+  if (!IX.good()) return 0;
+
+  std::string Stamp;
+  int Version;
+  if (!StrFunc::readBinary(IX,Stamp) || Stamp!=snapStamp ||
+      !StrFunc::readBinary(IX,Version) || Version!=snapVersion)
+    return 0;
+
+  MTYPE MTemp;
+  SCTYPE STemp;
+  size_t N;
+  if (!StrFunc::readBinarySize(IX,N,sizeof(size_t))) return 0;
+  for(size_t i=0;i<N;i++)
+    {
+      MonteCarlo::Material MObj;
+      if (!MObj.readBinary(IX)) return 0;
+      MTemp.emplace(MObj.getNumber(),MObj);
+    }
+
+  if (!StrFunc::readBinarySize(IX,N,sizeof(size_t)+sizeof(int)))
+    return 0;
+  for(size_t i=0;i<N;i++)
+    {
+      std::string Key;
+      int Index;
+      if (!StrFunc::readBinary(IX,Key) ||
+	  !StrFunc::readBinary(IX,Index))
+	return 0;
+      STemp.emplace(Key,Index);
+    }
+
+  MStore.swap(MTemp);
+  IndexMap.swap(STemp);
+  calcAttnTable();
+  return 1;
+}
   
 void
 DBMaterial::initMaterial()
@@ -1345,6 +1474,7 @@ DBMaterial::setMaterial(const MonteCarlo::Material& MO)
   checkNameIndex(MIndex,MName);
   MStore.insert(MTYPE::value_type(MIndex,MO));
   IndexMap.insert(SCTYPE::value_type(MName,MIndex));
+  setAttnFactor(MO);
   return;
 }
   
@@ -1573,6 +1703,45 @@ DBMaterial::resetMaterial(const MonteCarlo::Material& MO)
 
   MStore.insert(MTYPE::value_type(MIndex,MO));
   IndexMap.insert(SCTYPE::value_type(MName,MIndex));
+  setAttnFactor(MO);
+  return;
+}
+
+void
+DBMaterial::setAttnFactor(const MonteCarlo::Material& MO)
+  /*!
+    Set the attenuation factor of a material in the
+    dense table [atomDensity * A^0.66]. A material with
+    an unknown isotope mass is left as not available.
+    \param MO :: Material object
+   */
+{
+  const int MIndex=MO.getNumber();
+  if (MIndex<0) return;
+
+  const size_t index(static_cast<size_t>(MIndex));
+  if (index>=AttnTable.size())
+    AttnTable.resize(index+1,-1.0);
+  try
+    {
+      AttnTable[index]=MO.getAtomDensity()*std::pow(MO.getMeanA(),0.66);
+    }
+  catch (ColErr::ExBase&)
+    {
+      AttnTable[index]= -1.0;
+    }
+  return;
+}
+
+void
+DBMaterial::calcAttnTable()
+  /*!
+    Rebuild the attenuation table from the store
+   */
+{
+  AttnTable.clear();
+  for(const MTYPE::value_type& MItem : MStore)
+    setAttnFactor(MItem.second);
   return;
 }
 
@@ -1635,6 +1804,20 @@ DBMaterial::getMaterial(const int MIndex) const
   return mc->second;
 }
 
+double
+DBMaterial::getAttnFactor(const int MIndex) const
+  /*!
+    Get the attenuation factor of a material
+    \param MIndex :: Material number
+    \return atomDensity * A^0.66
+   */
+{
+  const size_t index(static_cast<size_t>(MIndex));
+  if (MIndex<0 || index>=AttnTable.size() || AttnTable[index]<0.0)
+    throw ColErr::InContainerError<int>(MIndex,"MIndex in AttnTable");
+  return AttnTable[index];
+}
+
 const MonteCarlo::Material&
 DBMaterial::getMaterial(const std::string& MName) const
   /*!
@@ -1851,6 +2034,7 @@ DBMaterial::writeMCNPX(std::ostream& OX) const
 {
   ELog::RegMethod RegA("DBMaterial","writeMCNPX");
 
+  std::vector<const MonteCarlo::Material*> MatVec;
   for(const int sActive : active)
     {
       if (sActive)
@@ -1858,9 +2042,15 @@ DBMaterial::writeMCNPX(std::ostream& OX) const
 	  MTYPE::const_iterator mp=MStore.find(sActive);
 	  if (mp==MStore.end())
 	    throw ColErr::InContainerError<int>(sActive,"MStore find(active item)");
-	  mp->second.write(OX);
+	  MatVec.push_back(&mp->second);
 	}
     }
+  ModelSupport::ThreadControl::writeBlocks
+    (OX,MatVec.size(),
+     [&MatVec](const size_t index,std::ostream& cx)
+     {
+       MatVec[index]->write(cx);
+     });
   return;
 }
 
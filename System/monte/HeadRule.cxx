@@ -48,7 +48,12 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Cylinder.h"
+#include "Sphere.h"
 #include "surfIndex.h"
 #include "BnId.h"
 #include "Acomp.h"
@@ -679,6 +684,108 @@ HeadRule::isolateSurfNum(const std::set<int>& SN)
   return;
 }
 
+Geometry::BoundBox
+HeadRule::calcBoundBox(const Rule* RPtr)
+  /*!
+    Calculate a conservative axis-aligned box for a rule
+    by interval arithmetic on the surfaces. Only exactly axis 
+    aligned planes and cylinders and spheres add bounds: all other
+    surfaces and complements are taken as unbounded. [A plane
+    tilted by t moves by t x extent, which a tolerance can not
+    bound without knowing the extent].
+    \param RPtr :: Rule to process
+    \return bounding box 
+  */
+{
+  if (!RPtr)
+    return Geometry::BoundBox::emptyBox();
+
+  const int RT=RPtr->type();
+  if (RT)   // intersection [1] / union [-1]
+    {
+      Geometry::BoundBox Out=calcBoundBox(RPtr->leaf(0));
+      if (RT==1)
+	Out.intersect(calcBoundBox(RPtr->leaf(1)));
+      else
+	Out.unite(calcBoundBox(RPtr->leaf(1)));
+      return Out;
+    }
+
+  Geometry::BoundBox Out;
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (!SPtr || !SPtr->getKey())
+    return Out;
+  
+  const Geometry::Surface* KPtr=SPtr->getKey();
+  const int sign=SPtr->getSign();
+  
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(KPtr);
+  if (PPtr)
+    {
+      const Geometry::Vec3D& N=PPtr->getNormal();
+      const int mDir=N.masterDir();
+      if (mDir)
+	{
+	  const size_t index=static_cast<size_t>(std::abs(mDir)-1);
+	  if (N[(index+1) % 3]!=0.0 || N[(index+2) % 3]!=0.0)
+	    return Out;
+	  const double D=(mDir>0) ? PPtr->getDistance() : -PPtr->getDistance();
+	  if (sign*mDir>0)
+	    Out.setLow(index,D);
+	  else
+	    Out.setHigh(index,D);
+	}
+      return Out;
+    }
+  // Only the inside of closed surfaces are bounded
+  if (sign>0)
+    return Out;
+
+  const Geometry::Sphere* SphPtr=
+    dynamic_cast<const Geometry::Sphere*>(KPtr);
+  if (SphPtr)
+    {
+      const Geometry::Vec3D& C=SphPtr->getCentre();
+      const double R=SphPtr->getRadius();
+      for(size_t i=0;i<3;i++)
+	{
+	  Out.setLow(i,C[i]-R);
+	  Out.setHigh(i,C[i]+R);
+	}
+      return Out;
+    }
+
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(KPtr);
+  if (CPtr)
+    {
+      // only bounded in directions orthogonal to the axis
+      const Geometry::Vec3D& C=CPtr->getCentre();
+      const Geometry::Vec3D& N=CPtr->getNormal();
+      const double R=CPtr->getRadius();
+      for(size_t i=0;i<3;i++)
+	if (N[i]==0.0)
+	  {
+	    Out.setLow(i,C[i]-R);
+	    Out.setHigh(i,C[i]+R);
+	  }
+    }
+  return Out;
+}
+
+Geometry::BoundBox
+HeadRule::calcBoundBox() const
+  /*!
+    Calculate a conservative axis-aligned box that
+    contains all valid points of the rule. 
+    Requires the surfaces to be populated.
+    \return bounding box [unbounded if not determined]
+  */
+{
+  return calcBoundBox(HeadNode);
+}
+
 std::set<int>
 HeadRule::getSurfSet() const
   /*!
@@ -1408,6 +1515,57 @@ HeadRule::substituteSurf(const int SurfN,const int newSurfN,
   return cnt;
 }
 
+int
+HeadRule::substituteSurf(const std::map<int,int>& RMap)
+  /*!
+    Substitues all the surfaces in the map in one
+    pass of the tree. Each surface is changed once so
+    the new numbers can include old numbers.
+    \param RMap :: Map of old surface [+ve] : new surface 
+       (if -ve then the key is reversed)
+    \returns number of substitutions
+  */
+{
+  ELog::RegMethod RegA("HeadRule","substitueSurf(map)");
+
+  if (!HeadNode || RMap.empty()) return 0;
+
+  const ModelSupport::surfIndex& SurI=
+    ModelSupport::surfIndex::Instance();
+  int cnt(0);
+
+  std::stack<Rule*> TreeLine;
+  TreeLine.push(HeadNode);
+  while(!TreeLine.empty())
+    {
+      Rule* RPtr=TreeLine.top();
+      TreeLine.pop();
+      SurfPoint* SP=dynamic_cast<SurfPoint*>(RPtr);
+      if (SP)
+	{
+	  std::map<int,int>::const_iterator mc=RMap.find(SP->getKeyN());
+	  if (mc!=RMap.end() && mc->first!=mc->second)
+	    {
+	      const Geometry::Surface* SPtr=SurI.getSurf(abs(mc->second));
+	      if (!SPtr)
+		throw ColErr::InContainerError<int>
+		  (mc->second,"Surface number not found");
+	      SP->setKeyN(SP->getSign()*mc->second);
+	      SP->setKey(SPtr);
+	      cnt++;
+	    }
+	}
+      else
+	{
+	  Rule* leafA=RPtr->leaf(0);
+	  Rule* leafB=RPtr->leaf(1);
+	  if (leafA) TreeLine.push(leafA);
+	  if (leafB && leafB!=leafA) TreeLine.push(leafB);
+	}
+    }
+  return cnt;
+}
+
 void
 HeadRule::makeComplement()
   /*!
@@ -40,6 +40,7 @@
 #include "RegMethod.h"
 #include "OutputLog.h"
 #include "support.h"
+#include "fileSupport.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "Element.h"
@@ -159,4 +160,47 @@ MXcards::write(std::ostream& OX,
   return;
 } 
 
+void
+MXcards::writeBinary(std::ostream& OX) const
+  /*!
+    Write out to a binary [snapshot] stream
+    \param OX :: Binary output stream
+  */
+{
+  StrFunc::writeBinary(OX,particle);
+  StrFunc::writeBinary(OX,items.size());
+  for(const std::map<size_t,std::string>::value_type& MI : items)
+    {
+      StrFunc::writeBinary(OX,MI.first);
+      StrFunc::writeBinary(OX,MI.second);
+    }
+  return;
+}
+
+bool
+MXcards::readBinary(std::istream& IX)
+  /*!
+    Read from a binary [snapshot] stream
+    \param IX :: Binary input stream
+    \return true on success
+  */
+{
+  size_t N;
+  if (!StrFunc::readBinary(IX,particle) ||
+      !StrFunc::readBinarySize(IX,N,2*sizeof(size_t)))
+    return 0;
+
+  items.clear();
+  for(size_t i=0;i<N;i++)
+    {
+      size_t Index;
+      std::string Item;
+      if (!StrFunc::readBinary(IX,Index) ||
+	  !StrFunc::readBinary(IX,Item))
+	return 0;
+      items.emplace(Index,Item);
+    }
+  return 1;
+}
+
 }  // NAMESPACE MonteCarlo
@@ -44,6 +44,7 @@
 #include "RegMethod.h"
 #include "OutputLog.h"
 #include "support.h"
+#include "fileSupport.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "RefCon.h"
@@ -982,4 +983,81 @@ Material::write(std::ostream& OX) const
   return;
 } 
 
+void
+Material::writeBinary(std::ostream& OX) const
+  /*!
+    Write the full material state to a binary [snapshot]
+    stream. The atomic density is written directly so it
+    is not recalculated on reading.
+    \param OX :: Binary output stream
+  */
+{
+  StrFunc::writeBinary(OX,Mnum);
+  StrFunc::writeBinary(OX,Name);
+  StrFunc::writeBinary(OX,atomDensity);
+
+  StrFunc::writeBinary(OX,zaidVec.size());
+  for(const Zaid& ZI : zaidVec)
+    ZI.writeBinary(OX);
+
+  StrFunc::writeBinary(OX,mxCards.size());
+  for(const std::map<std::string,MXcards>::value_type& MX : mxCards)
+    {
+      StrFunc::writeBinary(OX,MX.first);
+      MX.second.writeBinary(OX);
+    }
+
+  StrFunc::writeBinary(OX,Libs.size());
+  for(const std::string& libItem : Libs)
+    StrFunc::writeBinary(OX,libItem);
+
+  StrFunc::writeBinary(OX,SQW.size());
+  for(const std::string& sqwItem : SQW)
+    StrFunc::writeBinary(OX,sqwItem);
+  return;
+}
+
+bool
+Material::readBinary(std::istream& IX)
+  /*!
+    Read the full material state from a binary [snapshot] stream
+    \param IX :: Binary input stream
+    \return true on success
+  */
+{
+  size_t N;
+  if (!StrFunc::readBinary(IX,Mnum) ||
+      !StrFunc::readBinary(IX,Name) ||
+      !StrFunc::readBinary(IX,atomDensity) ||
+      !StrFunc::readBinarySize(IX,N,sizeof(double)))
+    return 0;
+
+  zaidVec.resize(N);
+  for(Zaid& ZI : zaidVec)
+    if (!ZI.readBinary(IX)) return 0;
+
+  if (!StrFunc::readBinarySize(IX,N,2*sizeof(size_t))) return 0;
+  mxCards.clear();
+  for(size_t i=0;i<N;i++)
+    {
+      std::string Key;
+      MXcards MX("");
+      if (!StrFunc::readBinary(IX,Key) || !MX.readBinary(IX))
+	return 0;
+      mxCards.emplace(Key,MX);
+    }
+
+  if (!StrFunc::readBinarySize(IX,N,sizeof(size_t))) return 0;
+  Libs.resize(N);
+  for(std::string& libItem : Libs)
+    if (!StrFunc::readBinary(IX,libItem)) return 0;
+
+  if (!StrFunc::readBinarySize(IX,N,sizeof(size_t))) return 0;
+  SQW.resize(N);
+  for(std::string& sqwItem : SQW)
+    if (!StrFunc::readBinary(IX,sqwItem)) return 0;
+  
+  return 1;
+}
+
 }  // NAMESPACE MonteCarlo
@@ -49,6 +49,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Transform.h"
 #include "Track.h"
 #include "Line.h"
@@ -60,6 +61,7 @@
 #include "Token.h"
 #include "neutron.h"
 #include "RuleCheck.h"
+#include "RuleProgram.h"
 #include "objectRegister.h"
 #include "masterWrite.h"
 #include "Element.h"
@@ -168,9 +170,13 @@ Object::startLine(const std::string& Line)
   return 0;         
 }
 
+size_t Object::ruleChange(0);
+bool Object::compileFlag(1);
+
 Object::Object() :
   ObjName(0),listNum(-1),Tmp(300),MatN(-1),fill(0),trcl(0),
   universe(0),imp(1),density(0.0),placehold(0),populated(0),
+  Prog(new RuleProgram),boxValid(0),BBox(new Geometry::BoundBox),
   objSurfValid(0)
  /*!
    Defaut constuctor, set temperature to 300C and material to vacuum
@@ -181,7 +187,8 @@ Object::Object(const int N,const int M,const double T,
 	       const std::string& Line) :
   ObjName(N),listNum(-1),Tmp(T),MatN(M),fill(0),trcl(0),
   universe(0),imp(1),density(0.0),placehold(0),
-  populated(0),objSurfValid(0)
+  populated(0),Prog(new RuleProgram),boxValid(0),
+  BBox(new Geometry::BoundBox),objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -197,7 +204,9 @@ Object::Object(const Object& A) :
   ObjName(A.ObjName),listNum(A.listNum),Tmp(A.Tmp),MatN(A.MatN),
   fill(A.fill),trcl(A.trcl),universe(A.universe),imp(A.imp),
   density(A.density),placehold(A.placehold),populated(A.populated),
-  HRule(A.HRule),objSurfValid(0),SurList(A.SurList),SurSet(A.SurSet)
+  HRule(A.HRule),Prog(new RuleProgram(*A.Prog)),
+  boxValid(A.boxValid),BBox(new Geometry::BoundBox(*A.BBox)),
+  objSurfValid(0),SurList(A.SurList),SurSet(A.SurSet)
   /*!
     Copy constructor
     \param A :: Object to copy
@@ -226,6 +235,9 @@ Object::operator=(const Object& A)
       placehold=A.placehold;
       populated=A.populated;
       HRule=A.HRule;
+      *Prog=*A.Prog;
+      ruleChange++;
+      boxValid=0;
       objSurfValid=0;
       SurList=A.SurList;
       SurSet=A.SurSet;
@@ -237,7 +249,10 @@ Object::~Object()
   /*!
     Delete operator : removes Object tree
   */
-{}
+{
+  delete Prog;
+  delete BBox;
+}
 
 Object*
 Object::clone() const 
@@ -292,6 +307,9 @@ Object::complementaryObject(const int Cnum,std::string& Ln)
   ObjName=Cnum;
   MatN=0;
   density=0.0;
+  ruleChange++;
+  boxValid=0;
+  Prog->clear();
   if (!HRule.procString(Part))
     throw ColErr::ExBase(0,RegA.getFull()+"\n"+Part);
 
@@ -397,6 +415,9 @@ Object::setObject(std::string Ln)
     }
 
   populated=0;
+  ruleChange++;
+  boxValid=0;
+  Prog->clear();
   if (HRule.procString(Ln))     // this currently does not fail:
     {
       SurList.clear();
@@ -419,6 +440,9 @@ Object::procString(const std::string& cellStr)
    */
 {
   populated=0;
+  ruleChange++;
+  boxValid=0;
+  Prog->clear();
   return HRule.procString(cellStr);
 }
 
@@ -445,6 +469,10 @@ Object::setObject(const int N,const int matNum,
   for(mc=TVec.begin();mc!=TVec.end();mc++)
     mc->write(cx);
 
+  ruleChange++;
+
+  boxValid=0;
+  Prog->clear();
   if (HRule.procString(cx.str()))     // this currently does not fail:
     {
       SurList.clear();
@@ -472,10 +500,42 @@ Object::populate()
     {
       HRule.populateSurf();
       populated=1;
+      ruleChange++;
+      boxValid=0;
+      compileRule();
     }
   return;
 }
 
+void
+Object::compileRule()
+  /*!
+    Compile the rule for fast evaluation. The
+    tree is used if not populated or not compilable.
+  */
+{
+  Prog->clear();
+  if (compileFlag && populated)
+    Prog->compile(HRule.getTopRule());
+  return;
+}
+
+const Geometry::BoundBox&
+Object::getBoundBox() const
+  /*!
+    Get a conservative box round the cell from the
+    rule surfaces. It is cached until the rule changes.
+    \return bounding box [unbounded if not determined]
+  */
+{
+  if (!boxValid)
+    {
+      *BBox=HRule.calcBoundBox();
+      boxValid=1;
+    }
+  return *BBox;
+}
+
 void
 Object::rePopulate()
   /*! 
@@ -489,34 +549,68 @@ Object::rePopulate()
   ELog::RegMethod RegA("Object","rePopulate");
   HRule.populateSurf();
   populated=1;
+  ruleChange++;
+  boxValid=0;
+  compileRule();
   return;
 }
 
 int
 Object::addSurfString(const std::string& XE)
   /*!
-    Adds a string in the most ugly fashion...
+    Adds a rule string as an intersection with the cell
     \param XE Bit to add (at the global point)
     \retval 1 on success
     \retval 0 on failure
   */
 {
   ELog::RegMethod RegA("Object","addSurfString");
-  const double Temp=Tmp;                   // need to set later
-  std::string Line;
-  if (HRule.isUnion())
-    Line = headStr()+" ("+cellCompStr()+")"+XE;
+
+  if (XE.find_first_not_of(" \t")==std::string::npos)
+    return 1;
+
+  HeadRule XRule;
+  if (!XRule.procString(XE))
+    {
+      ELog::EM<<"Failed to process:"<<XE<<ELog::endErr;
+      return 0;
+    }
+  return addSurfRule(XRule);
+}
+
+int
+Object::addSurfRule(const HeadRule& XRule)
+  /*!
+    Intersect a rule with the cell in place. The existing
+    tree and its surface pointers are kept and if the cell
+    is populated the new part is populated.
+    \param XRule :: Rule to add (at the global point)
+    \return 1 [always succeeds : an empty rule adds nothing]
+  */
+{
+  ELog::RegMethod RegA("Object","addSurfRule");
+
+  if (!XRule.hasRule()) return 1;
+
+  if (populated)
+    {
+      HeadRule PRule(XRule);
+      PRule.populateSurf();
+      HRule.addIntersection(PRule);
+    }
   else
-    Line = str()+XE;
+    HRule.addIntersection(XRule);
 
-  const int flag=setObject(Line);
-  Tmp=Temp;      
-  populated=0;
+  ruleChange++;
+
+  boxValid=0;
+  SurList.clear();
+  SurSet.erase(SurSet.begin(),SurSet.end());
   objSurfValid=0;
-  return flag;
+  compileRule();
+  return 1;
 }
 
-
 int
 Object::isOnSide(const Geometry::Vec3D& Pt) const
   /*!
@@ -627,6 +721,8 @@ Object::isValid(const Geometry::Vec3D& Pt) const
   \returns 1 if true and 0 if false
 */
 {
+  if (Prog->isCompiled())
+    return Prog->isValid(Pt);
   return HRule.isValid(Pt);
 }
 
@@ -641,6 +737,8 @@ Object::isValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
+  if (Prog->isCompiled())
+    return Prog->isValid(Pt,ExSN);
   return HRule.isValid(Pt,ExSN);
 }
 
@@ -655,6 +753,8 @@ Object::isDirectionValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
+  if (Prog->isCompiled())
+    return Prog->isDirectionValid(Pt,ExSN);
   return HRule.isDirectionValid(Pt,ExSN);
 }
 
@@ -719,6 +819,8 @@ Object::pairValid(const int SN,const Geometry::Vec3D& Pt) const
     \retval 3 : valid [SN true/false]
   */
 {
+  if (Prog->isCompiled())
+    return Prog->pairValid(SN,Pt);
   return HRule.pairValid(SN,Pt);
 }
 
@@ -862,6 +964,9 @@ Object::removeSurface(const int SurfN)
     {
       createSurfaceList();
       objSurfValid=0;
+      ruleChange++;
+      boxValid=0;
+      compileRule();
     }
   return cnt;
 }
@@ -887,6 +992,31 @@ Object::substituteSurf(const int SurfN,const int NsurfN,
   if ( out )
     {
       populated=0;
+      ruleChange++;
+      boxValid=0;
+      populate();
+      createSurfaceList();
+    }
+  return out;
+}
+
+int
+Object::substituteSurf(const std::map<int,int>& RMap)
+  /*! 
+    Renumbers all the surfaces in the map and then
+    re-builds the cell once.
+    \param RMap :: Map of old surface : new surface number
+    \return number of surfaces substituted
+  */
+{ 
+  ELog::RegMethod RegA("Object","substituteSurf(map)");
+
+  const int out=HRule.substituteSurf(RMap);
+  if ( out )
+    {
+      populated=0;
+      ruleChange++;
+      boxValid=0;
       populate();
       createSurfaceList();
     }
@@ -1163,6 +1293,9 @@ Object::makeComplement()
    */
 {
   HRule.makeComplement();
+  ruleChange++;
+  boxValid=0;
+  compileRule();
   return;
 }
 
@@ -34,6 +34,8 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <tuple>
+#include <mutex>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -59,6 +61,7 @@
 #include "SurfVertex.h"
 #include "Line.h"
 #include "SurInter.h"
+#include "TripleCache.h"
 #include "Qhull.h"
 
 namespace MonteCarlo
@@ -125,10 +128,11 @@ Qhull::clone() const
 }
 
 int
-Qhull::calcIntersections()
+Qhull::calcIntersections(Geometry::TripleCache* TCPtr)
   /*! 
     Loops over all the surfaces and calculates the appropiate
     intersection
+    \param TCPtr :: Shared triple point cache [0 for none]
     \return number of items intersection points.
   */
 {
@@ -142,14 +146,15 @@ Qhull::calcIntersections()
       for(kc=jc+1;kc!=SurList.end();kc++)
         {
 	  // This adds intersections to the VList
-	  cnt+=getIntersect(*ic,*jc,*kc);
+	  cnt+=getIntersect(TCPtr,*ic,*jc,*kc);
 	}
   // return number of item found
   return cnt;
 }
 
 int
-Qhull::getIntersect(const Geometry::Surface* SurfX,
+Qhull::getIntersect(Geometry::TripleCache* TCPtr,
+		    const Geometry::Surface* SurfX,
 		    const Geometry::Surface* SurfY,
 		    const Geometry::Surface* SurfZ)
   /*!
@@ -157,6 +162,7 @@ Qhull::getIntersect(const Geometry::Surface* SurfX,
     Adds the point to the vertex list if the point is valid 
     and is on a side.
     
+    \param TCPtr :: Shared triple point cache [0 for none]
     \param SurfX :: Surface pointer
     \param SurfY :: Surface pointer
     \param SurfZ :: Surface pointer
@@ -169,7 +175,8 @@ Qhull::getIntersect(const Geometry::Surface* SurfX,
   const int BS=SurfY->getName();
   const int CS=SurfZ->getName();
 
-  std::vector<Geometry::Vec3D> PntOut=
+  const std::vector<Geometry::Vec3D> PntOut=(TCPtr) ?
+    TCPtr->processPoint(SurfX,SurfY,SurfZ) :
     SurInter::processPoint(SurfX,SurfY,SurfZ);
 
   int Ncnt(0);
@@ -300,11 +307,12 @@ Qhull::getVertex() const
 }
 
 int
-Qhull::calcVertex()
+Qhull::calcVertex(Geometry::TripleCache* TCPtr)
   /*!
     Loop over all the surfaces, determine if the 
     plane intersection exists and calculate
     the vertii
+    \param TCPtr :: Shared triple point cache [0 for none]
     \return Number of intersection vertexs found.
   */
 {
@@ -312,7 +320,7 @@ Qhull::calcVertex()
   
   createSurfaceList();
   populate();
-  calcIntersections();
+  calcIntersections(TCPtr);
   if (!VList.empty())  
     calcCentreOfMass();
     
@@ -0,0 +1,264 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RulePool.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <new>
+
+#include "RulePool.h"
+
+/*!
+  \struct RulePool::Shared
+  \brief Store used by all threads [lock to access]
+*/
+
+struct RulePool::Shared
+{
+  std::mutex lock;                      ///< Lock of the store
+  size_t nChunk;                        ///< Chunks allocated
+  FreeNode* freeList[nBucket];          ///< Free blocks of each size
+  /// Unused parts of chunks [start/end]
+  std::vector<std::pair<char*,char*>> Spare;
+};
+
+/*!
+  \class RulePool::Retire
+  \brief Passes a thread store to the shared store on exit
+*/
+
+class RulePool::Retire
+{
+ private:
+
+  Store& S;         ///< Store of thread
+
+ public:
+
+  /// Constructor
+  explicit Retire(Store& SR) : S(SR) {}
+  /// Destructor : pass on store
+  ~Retire() { RulePool::retire(S); }
+};
+
+RulePool::Store&
+RulePool::getStore()
+  /*!
+    Accessor to the store of the thread. The store
+    is trivial so is never destroyed.
+    \return store of this thread
+  */
+{
+  static thread_local Store TS={};
+  return TS;
+}
+
+RulePool::Shared&
+RulePool::getShared()
+  /*!
+    Accessor to the shared store. This is never deleted
+    as nodes held by static objects can be released
+    after the end of main.
+    \return shared store
+  */
+{
+  static Shared* SPtr=new Shared();
+  return *SPtr;
+}
+
+size_t
+RulePool::nChunk()
+  /*!
+    Get the number of chunks allocated
+    \return number of chunks
+  */
+{
+  Shared& SS=getShared();
+  std::lock_guard<std::mutex> Guard(SS.lock);
+  return SS.nChunk;
+}
+
+void
+RulePool::refill(Store& S,const size_t index)
+  /*!
+    Give the store a free block of size index
+    or enough bump space for one.
+    \param S :: Store of thread
+    \param index :: Size index
+  */
+{
+  if (!S.registered)
+    {
+      static thread_local Retire RG(S);
+      S.registered=1;
+    }
+
+  const size_t NB((index+1)*unitSize);
+  Shared& SS=getShared();
+  std::lock_guard<std::mutex> Guard(SS.lock);
+  // take all the free blocks of this size
+  if (SS.freeList[index])
+    {
+      S.freeList[index]=SS.freeList[index];
+      SS.freeList[index]=0;
+      return;
+    }
+  // current remainder is lost [less than one block]
+  for(size_t i=0;i<SS.Spare.size();i++)
+    if (static_cast<size_t>(SS.Spare[i].second-SS.Spare[i].first)>=NB)
+      {
+	S.bumpPtr=SS.Spare[i].first;
+	S.bumpEnd=SS.Spare[i].second;
+	SS.Spare.erase(SS.Spare.begin()+static_cast<long int>(i));
+	return;
+      }
+  S.bumpPtr=static_cast<char*>(::operator new(chunkSize));
+  S.bumpEnd=S.bumpPtr+chunkSize;
+  SS.nChunk++;
+  return;
+}
+
+void
+RulePool::retire(Store& S)
+  /*!
+    Pass the free blocks and chunk of an exiting thread
+    to the shared store. Later calls on this thread
+    use the shared store.
+    \param S :: Store of thread
+  */
+{
+  Shared& SS=getShared();
+  std::lock_guard<std::mutex> Guard(SS.lock);
+  for(size_t i=0;i<nBucket;i++)
+    {
+      FreeNode* FN=S.freeList[i];
+      while(FN)
+	{
+	  FreeNode* nextFN=FN->next;
+	  FN->next=SS.freeList[i];
+	  SS.freeList[i]=FN;
+	  FN=nextFN;
+	}
+      S.freeList[i]=0;
+    }
+  if (static_cast<size_t>(S.bumpEnd-S.bumpPtr)>=unitSize)
+    SS.Spare.push_back(std::pair<char*,char*>(S.bumpPtr,S.bumpEnd));
+  S.bumpPtr=0;
+  S.bumpEnd=0;
+  S.retired=1;
+  return;
+}
+
+void*
+RulePool::sharedAllocate(const size_t index)
+  /*!
+    Allocate a block from the shared store
+    \param index :: Size index
+    \return block
+  */
+{
+  Shared& SS=getShared();
+  std::lock_guard<std::mutex> Guard(SS.lock);
+  FreeNode* FN=SS.freeList[index];
+  if (FN)
+    {
+      SS.freeList[index]=FN->next;
+      return FN;
+    }
+  return ::operator new((index+1)*unitSize);
+}
+
+void
+RulePool::sharedRelease(void* Ptr,const size_t index)
+  /*!
+    Release a block to the shared store
+    \param Ptr :: Block
+    \param index :: Size index
+  */
+{
+  Shared& SS=getShared();
+  std::lock_guard<std::mutex> Guard(SS.lock);
+  FreeNode* FN=static_cast<FreeNode*>(Ptr);
+  FN->next=SS.freeList[index];
+  SS.freeList[index]=FN;
+  return;
+}
+
+void*
+RulePool::allocate(const size_t N)
+  /*!
+    Allocate a block
+    \param N :: Size of block [bytes]
+    \return block
+  */
+{
+  if (!N || N>nBucket*unitSize)
+    return ::operator new(N);
+
+  const size_t index((N-1)/unitSize);
+  Store& S=getStore();
+  if (S.retired)
+    return sharedAllocate(index);
+
+  const size_t NB((index+1)*unitSize);
+  while(!S.freeList[index] &&
+	static_cast<size_t>(S.bumpEnd-S.bumpPtr)<NB)
+    refill(S,index);
+
+  FreeNode* FN=S.freeList[index];
+  if (FN)
+    {
+      S.freeList[index]=FN->next;
+      return FN;
+    }
+  void* Out=S.bumpPtr;
+  S.bumpPtr+=NB;
+  return Out;
+}
+
+void
+RulePool::release(void* Ptr,const size_t N)
+  /*!
+    Release a block allocated by allocate
+    \param Ptr :: Block [can be null]
+    \param N :: Size of block [bytes]
+  */
+{
+  if (!Ptr) return;
+  if (!N || N>nBucket*unitSize)
+    {
+      ::operator delete(Ptr);
+      return;
+    }
+
+  const size_t index((N-1)/unitSize);
+  Store& S=getStore();
+  if (S.retired)
+    {
+      sharedRelease(Ptr,index);
+      return;
+    }
+  FreeNode* FN=static_cast<FreeNode*>(Ptr);
+  FN->next=S.freeList[index];
+  S.freeList[index]=FN;
+  return;
+}
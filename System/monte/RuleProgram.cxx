@@ -0,0 +1,455 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RuleProgram.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <sstream>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "SideCache.h"
+#include "Rules.h"
+#include "RuleProgram.h"
+
+std::ostream&
+operator<<(std::ostream& OX,const RuleProgram& A)
+  /*!
+    Standard output stream
+    \param OX :: Output stream
+    \param A :: RuleProgram to write
+    \return Stream State
+   */
+{
+  A.write(OX);
+  return OX;
+}
+
+RuleProgram::RuleProgram() :
+  compiled(0),maxStack(0)
+  /*!
+    Constructor
+  */
+{}
+
+RuleProgram::RuleProgram(const RuleProgram& A) :
+  compiled(A.compiled),maxStack(A.maxStack),
+  Prog(A.Prog),SurfSlot(A.SurfSlot),SurfNum(A.SurfNum)
+  /*!
+    Copy constructor
+    \param A :: RuleProgram to copy
+  */
+{}
+
+RuleProgram&
+RuleProgram::operator=(const RuleProgram& A)
+  /*!
+    Assignment operator
+    \param A :: RuleProgram to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      compiled=A.compiled;
+      maxStack=A.maxStack;
+      Prog=A.Prog;
+      SurfSlot=A.SurfSlot;
+      SurfNum=A.SurfNum;
+    }
+  return *this;
+}
+
+void
+RuleProgram::clear()
+  /*!
+    Remove the program
+  */
+{
+  compiled=0;
+  maxStack=0;
+  Prog.clear();
+  SurfSlot.clear();
+  SurfNum.clear();
+  return;
+}
+
+size_t
+RuleProgram::getSlot(const Geometry::Surface* SPtr,const int SN)
+  /*!
+    Get the slot of a surface [adding if new]
+    \param SPtr :: Surface
+    \param SN :: Surface number [unsigned]
+    \return slot index
+  */
+{
+  std::vector<int>::const_iterator vc=
+    std::find(SurfNum.begin(),SurfNum.end(),SN);
+  if (vc!=SurfNum.end())
+    return static_cast<size_t>(vc-SurfNum.begin());
+
+  SurfSlot.push_back(SPtr);
+  SurfNum.push_back(SN);
+  return SurfNum.size()-1;
+}
+
+void
+RuleProgram::addOp(const OpType T,const int V,const size_t I)
+  /*!
+    Add an operation to the end of the program
+    \param T :: Type of operation
+    \param V :: Value [sign/constant]
+    \param I :: Index [slot/jump]
+  */
+{
+  RuleOp Op;
+  Op.type=T;
+  Op.value=V;
+  Op.index=I;
+  Prog.push_back(Op);
+  return;
+}
+
+bool
+RuleProgram::compileGroup(const Rule* RPtr,const int groupType)
+  /*!
+    Compile an intersection/union. All the directly nested
+    rules of the same type are flattened into one group
+    \param RPtr :: Top rule of the group
+    \param groupType :: 1 for intersection / -1 for union
+    \return true on success
+  */
+{
+  std::vector<const Rule*> Items;
+  std::vector<const Rule*> Stack;
+  Stack.push_back(RPtr);
+  while(!Stack.empty())
+    {
+      const Rule* APtr=Stack.back();
+      Stack.pop_back();
+      if (APtr->type()!=groupType)
+	Items.push_back(APtr);
+      else
+	{
+	  const Rule* LPtr=APtr->leaf(0);
+	  const Rule* RLPtr=APtr->leaf(1);
+	  // null leaves have odd rules in the tree
+	  if (!LPtr || !RLPtr) return 0;
+	  Stack.push_back(RLPtr);
+	  Stack.push_back(LPtr);
+	}
+    }
+
+  const OpType jumpType=(groupType==1) ?
+    OpType::JumpFalse : OpType::JumpTrue;
+  const OpType mergeType=(groupType==1) ?
+    OpType::And : OpType::Or;
+
+  std::vector<size_t> JumpOp;
+  if (!compileRule(Items.front())) return 0;
+  for(size_t i=1;i<Items.size();i++)
+    {
+      JumpOp.push_back(Prog.size());
+      addOp(jumpType,0,0);
+      if (!compileRule(Items[i])) return 0;
+      addOp(mergeType,0,0);
+    }
+  for(const size_t index : JumpOp)
+    Prog[index].index=Prog.size();
+
+  return 1;
+}
+
+bool
+RuleProgram::compileRule(const Rule* RPtr)
+  /*!
+    Compile a rule into the program
+    \param RPtr :: Rule to add
+    \return true on success / false if the rule is not supported
+  */
+{
+  if (!RPtr) return 0;
+
+  if (RPtr->type())
+    return compileGroup(RPtr,RPtr->type());
+
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      if (!SPtr->getKey()) return 0;
+      const size_t slot=getSlot(SPtr->getKey(),SPtr->getKeyN());
+      addOp(OpType::Leaf,SPtr->getSign(),slot);
+      return 1;
+    }
+
+  const CompGrp* CPtr=dynamic_cast<const CompGrp*>(RPtr);
+  if (CPtr)
+    {
+      const Rule* APtr=CPtr->leaf(0);
+      if (!APtr)
+	{
+	  addOp(OpType::Const,3,0);
+	  return 1;
+	}
+      if (!compileRule(APtr)) return 0;
+      addOp(OpType::Not,0,0);
+      return 1;
+    }
+
+  if (dynamic_cast<const BoolValue*>(RPtr))
+    {
+      addOp(OpType::Const,
+	    (RPtr->isValid(Geometry::Vec3D(0,0,0)) ? 3 : 0),0);
+      return 1;
+    }
+
+  // CompObj/ContObj/ContGrp reference other objects
+  return 0;
+}
+
+void
+RuleProgram::calcStack()
+  /*!
+    Calculate the maximum depth of the value stack.
+    Jumps only skip balanced sections so the linear
+    pass is an upper bound.
+  */
+{
+  size_t depth(0);
+  maxStack=0;
+  for(const RuleOp& Op : Prog)
+    {
+      if (Op.type==OpType::Leaf || Op.type==OpType::Const)
+	depth++;
+      else if (Op.type==OpType::And || Op.type==OpType::Or)
+	depth--;
+      maxStack=std::max(maxStack,depth);
+    }
+  return;
+}
+
+bool
+RuleProgram::compile(const Rule* TopRule)
+  /*!
+    Compile the rule tree. The tree needs to be populated.
+    \param TopRule :: Top rule of the tree
+    \return true if compiled / false if the tree must be used
+  */
+{
+  ELog::RegMethod RegA("RuleProgram","compile");
+
+  clear();
+  if (!compileRule(TopRule))
+    {
+      clear();
+      return 0;
+    }
+  calcStack();
+  compiled=1;
+  return 1;
+}
+
+int
+RuleProgram::evaluate(const EvalMode mode,
+		      const Geometry::Vec3D& Pt,
+		      const int SN) const
+  /*!
+    Run the program
+    \param mode :: Type of evaluation
+    \param Pt :: Point to test
+    \param SN :: Surface number [excluded/direction/pair]
+    \return 2-bit state [3 : true / 0 : false]
+  */
+{
+  const size_t nSurf(SurfSlot.size());
+  const int absSN(std::abs(SN));
+  Geometry::SideCache& SC(Geometry::SideCache::Instance());
+
+  // side of each surface : 2 is not yet calculated
+  int localSide[localSize];
+  int localStack[localSize];
+  std::vector<int> extSide;
+  std::vector<int> extStack;
+  int* sideCache(localSide);
+  int* valStack(localStack);
+  if (nSurf>localSize)
+    {
+      extSide.resize(nSurf);
+      sideCache= &extSide[0];
+    }
+  if (maxStack>localSize)
+    {
+      extStack.resize(maxStack);
+      valStack= &extStack[0];
+    }
+  std::fill(sideCache,sideCache+nSurf,2);
+
+  size_t nStack(0);
+  size_t pc(0);
+  while(pc<Prog.size())
+    {
+      const RuleOp& Op=Prog[pc];
+      switch (Op.type)
+	{
+	case OpType::Leaf:
+	  if (mode!=EvalMode::Point && SurfNum[Op.index]==absSN)
+	    {
+	      if (mode==EvalMode::Exclude)
+		valStack[nStack++]=3;
+	      else if (mode==EvalMode::Direction)
+		valStack[nStack++]=(Op.value*SN>0) ? 3 : 0;
+	      else
+		valStack[nStack++]=(Op.value>0) ? 2 : 1;
+	    }
+	  else
+	    {
+	      int& side=sideCache[Op.index];
+	      if (side==2)
+		side=SC.side(*SurfSlot[Op.index],Pt);
+	      valStack[nStack++]=(side*Op.value>=0) ? 3 : 0;
+	    }
+	  break;
+	case OpType::Const:
+	  valStack[nStack++]=Op.value;
+	  break;
+	case OpType::And:
+	  nStack--;
+	  valStack[nStack-1]&=valStack[nStack];
+	  break;
+	case OpType::Or:
+	  nStack--;
+	  valStack[nStack-1]|=valStack[nStack];
+	  break;
+	case OpType::Not:
+	  valStack[nStack-1]=(~valStack[nStack-1]) & 3;
+	  break;
+	case OpType::JumpFalse:
+	  if (!valStack[nStack-1])
+	    {
+	      pc=Op.index;
+	      continue;
+	    }
+	  break;
+	case OpType::JumpTrue:
+	  if (valStack[nStack-1]==3)
+	    {
+	      pc=Op.index;
+	      continue;
+	    }
+	  break;
+	}
+      pc++;
+    }
+  return (nStack) ? valStack[0] : 0;
+}
+
+bool
+RuleProgram::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if a point is valid
+    \param Pt :: Point to test
+    \return true if Pt is valid
+  */
+{
+  return evaluate(EvalMode::Point,Pt,0)!=0;
+}
+
+bool
+RuleProgram::isValid(const Geometry::Vec3D& Pt,const int ExSN) const
+  /*!
+    Determine if a point is valid, the excluded surface
+    is always true
+    \param Pt :: Point to test
+    \param ExSN :: Excluded surface number
+    \return true if Pt is valid
+  */
+{
+  return evaluate(EvalMode::Exclude,Pt,ExSN)!=0;
+}
+
+bool
+RuleProgram::isDirectionValid(const Geometry::Vec3D& Pt,
+			      const int ExSN) const
+  /*!
+    Determine if a point is valid, the side of the
+    excluded surface is given by the sign of ExSN
+    \param Pt :: Point to test
+    \param ExSN :: Excluded surface number [signed]
+    \return true if Pt is valid
+  */
+{
+  return evaluate(EvalMode::Direction,Pt,ExSN)!=0;
+}
+
+int
+RuleProgram::pairValid(const int SN,const Geometry::Vec3D& Pt) const
+  /*!
+    Determine the validity of Pt with the surface SN
+    false/true
+    \param SN :: Surface number
+    \param Pt :: Point to test
+    \return valid(SN->false) : valid(SN->true)
+  */
+{
+  return evaluate(EvalMode::Pair,Pt,SN);
+}
+
+void
+RuleProgram::write(std::ostream& OX) const
+  /*!
+    Write out the program [debug]
+    \param OX :: Output stream
+  */
+{
+  const char* OpName[]=
+    { "Leaf","Const","And","Or","Not","JumpFalse","JumpTrue" };
+
+  for(size_t i=0;i<Prog.size();i++)
+    {
+      const RuleOp& Op=Prog[i];
+      OX<<i<<" "<<OpName[static_cast<size_t>(Op.type)];
+      if (Op.type==OpType::Leaf)
+	OX<<" "<<Op.value*SurfNum[Op.index];
+      else if (Op.type==OpType::Const)
+	OX<<" "<<Op.value;
+      else if (Op.type==OpType::JumpFalse || Op.type==OpType::JumpTrue)
+	OX<<" -> "<<Op.index;
+      OX<<std::endl;
+    }
+  return;
+}
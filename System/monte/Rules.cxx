@@ -40,6 +40,7 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "MemStack.h"
+#include "RulePool.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "Triple.h"
@@ -585,14 +586,39 @@ Rule::removeItem(Rule* &TRule,const int SurfN)
   return cnt;
 }
 
+void*
+Rule::operator new(size_t N)
+  /*!
+    Allocate a rule node from the pool
+    \param N :: Size of node
+    \return memory for the node
+  */
+{
+  return RulePool::allocate(N);
+}
+
+void
+Rule::operator delete(void* Ptr,size_t N)
+  /*!
+    Return a rule node to the pool
+    \param Ptr :: Node memory
+    \param N :: Size of node
+  */
+{
+  RulePool::release(Ptr,N);
+  return;
+}
+
 Rule::Rule()  : Parent(0)
   /*!
     Standard Constructor
   */
 {
+#ifdef MEMSTACK
   ELog::MemStack::Instance().
     addMem("Rule",ELog::RegMethod::getBase(),
 	   reinterpret_cast<size_t>(this));
+#endif
 }
 
 Rule::Rule(const Rule&) : 
@@ -602,9 +628,11 @@ Rule::Rule(const Rule&) :
     Parent set to 0
   */
 {
+#ifdef MEMSTACK
   ELog::MemStack::Instance().
     addMem("Rule",ELog::RegMethod::getBase(),
 	   reinterpret_cast<size_t>(this));
+#endif
 }
 
 Rule::Rule(Rule* A) : 
@@ -615,9 +643,11 @@ Rule::Rule(Rule* A) :
     \param A :: Parent value
   */
 {
+#ifdef MEMSTACK
  ELog::MemStack::Instance().
     addMem("Rule",ELog::RegMethod::getBase(),
 	   reinterpret_cast<size_t>(this));
+#endif
 }
 
 Rule&
@@ -637,8 +667,10 @@ Rule::~Rule()
     Destructor
   */
 {
+#ifdef MEMSTACK
  ELog::MemStack::Instance().
    delMem(reinterpret_cast<size_t>(this));
+#endif
 }
 
 void
@@ -49,6 +49,7 @@
 #include "Transform.h"
 #include "Track.h"
 #include "Surface.h"
+#include "SideCache.h"
 #include "Rules.h"
 #include "Token.h"
 #include "objectRegister.h"
@@ -224,7 +225,7 @@ SurfPoint::isDirectionValid(const Geometry::Vec3D& Pt,
   if (!key) return 0;
   if (abs(ExSN)==keyN)
       return ((sign*ExSN>0) ? 1 : 0);
-  return (key->side(Pt)*sign)>=0 ? 1 : 0;
+  return (Geometry::SideCache::Instance().side(*key,Pt)*sign)>=0 ? 1 : 0;
 }
 
 bool
@@ -241,7 +242,7 @@ SurfPoint::isValid(const Geometry::Vec3D& Pt,
 {
   if (!key) return 0;
   if (abs(ExSN)==keyN) return 1;
-  return (key->side(Pt)*sign)>=0 ? 1 : 0;
+  return (Geometry::SideCache::Instance().side(*key,Pt)*sign)>=0 ? 1 : 0;
 }
 
 bool
@@ -258,7 +259,7 @@ SurfPoint::isValid(const Geometry::Vec3D& Pt,
 {
   if (!key) return 0;
   if (ExSN.find(keyN)!=ExSN.end()) return 1;
-  return (key->side(Pt)*sign)>=0 ? 1 : 0;
+  return (Geometry::SideCache::Instance().side(*key,Pt)*sign)>=0 ? 1 : 0;
 }
 
 bool
@@ -272,7 +273,7 @@ SurfPoint::isValid(const Geometry::Vec3D& Pt) const
   */
 {
   if (key)
-    return (key->side(Pt)*sign)>=0 ? 1 : 0;
+    return (Geometry::SideCache::Instance().side(*key,Pt)*sign)>=0 ? 1 : 0;
   else
     return 0;
 }
@@ -290,7 +291,7 @@ SurfPoint::pairValid(const int SN,const Geometry::Vec3D& Pt) const
   if (keyN==abs(SN)) 
     return (sign>0) ? 2 : 1;
   
-  return (key->side(Pt)*sign)>=0 ? 3 : 0;
+  return (Geometry::SideCache::Instance().side(*key,Pt)*sign)>=0 ? 3 : 0;
 }
 
 bool
@@ -40,6 +40,7 @@
 #include "OutputLog.h"
 #include "Triple.h"
 #include "support.h"
+#include "fileSupport.h"
 #include "IsoTable.h"
 #include "Element.h"
 #include "Zaid.h"
@@ -261,4 +262,32 @@ Zaid::write(std::ostream& OX) const
   return;
 }
 
+void
+Zaid::writeBinary(std::ostream& OX) const
+  /*!
+    Write out to a binary [snapshot] stream
+    \param OX :: Binary output stream
+   */
+{
+  StrFunc::writeBinary(OX,index);
+  StrFunc::writeBinary(OX,tag);
+  StrFunc::writeBinary(OX,type);
+  StrFunc::writeBinary(OX,density);
+  return;
+}
+
+bool
+Zaid::readBinary(std::istream& IX)
+  /*!
+    Read from a binary [snapshot] stream
+    \param IX :: Binary input stream
+    \return true on success
+   */
+{
+  return (StrFunc::readBinary(IX,index) &&
+	  StrFunc::readBinary(IX,tag) &&
+	  StrFunc::readBinary(IX,type) &&
+	  StrFunc::readBinary(IX,density));
+}
+
 }  // NAMESPACE MonteCarlo
@@ -54,6 +54,12 @@ class DBMaterial
   NTYPE  NStore;     ///< Store of neutron materials [if exist]
   /// Active list
   std::set<int> active;
+  /// Attenuation factor [by material number : -ve if no material]
+  std::vector<double> AttnTable;
+
+  static std::string snapFile;       ///< Binary snapshot file
+  static const std::string snapStamp; ///< Snapshot tag [build time]
+  static const int snapVersion;       ///< Snapshot binary format version
 
   DBMaterial();
 
@@ -65,6 +71,8 @@ class DBMaterial
   void initMaterial();
   void initMXUnits();
   void checkNameIndex(const int,const std::string&) const;
+  void setAttnFactor(const MonteCarlo::Material&);
+  void calcAttnTable();
   int getFreeNumber() const;
 
   int createOrthoParaMix(const std::string&,const double);
@@ -85,6 +93,9 @@ class DBMaterial
   const NTYPE& getNeutMat() const { return NStore; }
   const MonteCarlo::Material& getMaterial(const int) const;
   const MonteCarlo::Material& getMaterial(const std::string&) const;
+  /// Attenuation factor [atomDensity*A^0.66] by material number
+  const std::vector<double>& getAttnTable() const { return AttnTable; }
+  double getAttnFactor(const int) const;
 
   void resetMaterial(const MonteCarlo::Material&);
   void setMaterial(const MonteCarlo::Material&);
@@ -111,6 +122,10 @@ class DBMaterial
   void setENDF7();
 
   void readFile(const std::string&);
+
+  static void setSnapshot(const std::string&);
+  bool readSnapshot(const std::string&);
+  void writeSnapshot(const std::string&) const;
   
   void writeCinder(std::ostream&) const;
   void writeMCNPX(std::ostream&) const;
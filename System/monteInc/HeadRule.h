@@ -30,6 +30,7 @@ class SurfPoint;
 namespace Geometry
 {
   class Surface;
+  class BoundBox;
 }
 
 
@@ -53,6 +54,7 @@ class HeadRule
   void removeItem(const Rule*);
   static int procPair(std::string&,std::map<int,Rule*>&,int&);
   static CompGrp* procComp(Rule*);
+  static Geometry::BoundBox calcBoundBox(const Rule*);
 
   void createAddition(const int,const Rule*);
   const SurfPoint* findSurf(const int) const;
@@ -109,12 +111,14 @@ class HeadRule
   bool partMatched(const HeadRule&) const;
 
   std::set<int> getSurfSet() const;
+  Geometry::BoundBox calcBoundBox() const;
 
   int removeItems(const int);
   int removeUnsignedItems(const int);
   void isolateSurfNum(const std::set<int>&);
   int removeTopItem(const int);
   int substituteSurf(const int,const int,const Geometry::Surface*);
+  int substituteSurf(const std::map<int,int>&);
   void removeCommon();
   
   void makeComplement();
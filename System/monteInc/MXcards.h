@@ -57,6 +57,8 @@ class MXcards
 
 
   void write(std::ostream&,const std::vector<Zaid>&) const;               
+  void writeBinary(std::ostream&) const;
+  bool readBinary(std::istream&);
   
 };
 
@@ -122,6 +122,9 @@ class Material
   void writeFLUKA(std::ostream&) const;
   void writePHITS(std::ostream&) const;
   void writePOVRay(std::ostream&) const;               
+
+  void writeBinary(std::ostream&) const;
+  bool readBinary(std::istream&);
   
 };
 
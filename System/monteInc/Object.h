@@ -23,6 +23,12 @@
 #define MonteCarlo_Object_h
 
 class Token;
+class RuleProgram;
+
+namespace Geometry
+{
+  class BoundBox;
+}
 
 namespace MonteCarlo
 {
@@ -56,6 +62,12 @@ class Object
   int populated;     ///< Full population
 
   HeadRule HRule;    ///< Top rule
+  RuleProgram* Prog;  ///< Compiled form of HRule [if populated]
+  mutable bool boxValid;     ///< BBox is current
+  Geometry::BoundBox* BBox;  ///< Box round the cell [cache]
+
+  static size_t ruleChange;   ///< Count of rule changes [all objects]
+  static bool compileFlag;    ///< Compile rules on populate
 
   /// Set of surfaces that are logically opposite in the rule.
   std::set<const Geometry::Surface*> logicOppSurf;
@@ -64,6 +76,7 @@ class Object
   int checkExteriorValid(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
   /// Calc in/out 
   int calcInOut(const int,const int) const;
+  void compileRule();
 
  protected:
   
@@ -80,6 +93,10 @@ class Object
  public:
   
   static int startLine(const std::string& Line);
+  /// Count of rule/surface changes to any object 
+  static size_t getRuleChange() { return ruleChange; }
+  /// Set the compilation of rules on populate
+  static void setCompileRule(const bool F) { compileFlag=F; }
 
   Object();
   Object(const int,const int,const double,const std::string&);
@@ -124,6 +141,9 @@ class Object
   const Rule* topRule() const { return HRule.getTopRule(); }
   /// get head rule 
   const HeadRule& getHeadRule() const { return HRule; }
+  /// get compiled rule
+  const RuleProgram& getRuleProgram() const { return *Prog; }
+  const Geometry::BoundBox& getBoundBox() const;
   
   void populate();
   void rePopulate();
@@ -132,8 +152,10 @@ class Object
   int isObjSurfValid() const { return objSurfValid; }  ///< Check validity needed
   void setObjSurfValid()  { objSurfValid=1; }          ///< set as valid
   int addSurfString(const std::string&);   
+  int addSurfRule(const HeadRule&);
   int removeSurface(const int);        
   int substituteSurf(const int,const int,Geometry::Surface*);  
+  int substituteSurf(const std::map<int,int>&);
   void makeComplement();
 
   bool hasSurface(const int) const;
@@ -25,6 +25,7 @@
 namespace Geometry
 {
   class Surface;
+  class TripleCache;
 }
 
 namespace MonteCarlo
@@ -49,8 +50,8 @@ class Qhull : public Object
   std::vector<SurfVertex> VList;      ///< Full Vertex list
   Geometry::Vec3D CofM;               ///< Effective centre of mass
 
-  int getIntersect(const Geometry::Surface*,const Geometry::Surface*,
-		   const Geometry::Surface*);
+  int getIntersect(Geometry::TripleCache*,const Geometry::Surface*,
+		   const Geometry::Surface*,const Geometry::Surface*);
 
   void calcCentreOfMass();
 
@@ -65,8 +66,8 @@ class Qhull : public Object
 
   /// Determine if intersections has been calculted:
   bool hasIntersections() const { return !VList.empty(); }
-  int calcIntersections();
-  int calcVertex();
+  int calcIntersections(Geometry::TripleCache* =0);
+  int calcVertex(Geometry::TripleCache* =0);
   int calcMidVertex();
   
   Geometry::Matrix<double> getRotation(const unsigned int,const unsigned int,
@@ -0,0 +1,82 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/RulePool.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef RulePool_h
+#define RulePool_h
+
+/*!
+  \class RulePool
+  \brief Pool allocator for the Rule tree nodes
+  \author S. Ansell
+  \version 1.0
+  \date March 2018
+
+  Nodes are allocated by a bump pointer through a large
+  chunk and released blocks go to a free list for each size.
+  There is one store per thread so no locks are needed
+  except to get a new chunk. When a thread exits its
+  free blocks and unused chunk are passed to a shared
+  store for the next thread. Chunks are held until exit.
+*/
+
+class RulePool
+{
+ private:
+
+  static const size_t unitSize=16;        ///< Size step of blocks
+  static const size_t nBucket=16;         ///< Number of block sizes
+  static const size_t chunkSize=65536;    ///< Size of a chunk [bytes]
+
+  /// Released block
+  struct FreeNode
+  {
+    FreeNode* next;         ///< Next free block
+  };
+
+  /// Store of a thread
+  struct Store
+  {
+    bool retired;                  ///< Thread has exited
+    bool registered;               ///< Exit action set
+    char* bumpPtr;                 ///< Next free byte of chunk
+    char* bumpEnd;                 ///< End of chunk
+    FreeNode* freeList[nBucket];   ///< Free blocks of each size
+  };
+
+  struct Shared;
+  class Retire;
+
+  static Store& getStore();
+  static Shared& getShared();
+  static void refill(Store&,const size_t);
+  static void retire(Store&);
+  static void* sharedAllocate(const size_t);
+  static void sharedRelease(void*,const size_t);
+
+ public:
+
+  static void* allocate(const size_t);
+  static void release(void*,const size_t);
+
+  static size_t nChunk();
+};
+
+#endif
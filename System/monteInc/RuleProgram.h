@@ -0,0 +1,110 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/RuleProgram.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef RuleProgram_h
+#define RuleProgram_h
+
+class Rule;
+
+namespace Geometry
+{
+  class Surface;
+}
+
+/*!
+  \class RuleProgram
+  \brief Flat short-circuit form of a rule tree
+  \version 1.0
+  \date January 2018
+  \author S. Ansell
+
+  The rule tree is compiled into a contiguous list
+  of operations. Nested intersections/unions are
+  flattened and each group jumps to its end as soon
+  as the result is known. Values are held as the
+  2-bit pairValid state [true==3 : false==0].
+  Each surface is given a slot so its side is only
+  calculated once per query.
+*/
+
+class RuleProgram
+{
+ private:
+
+  /// Operation types
+  enum class OpType { Leaf, Const, And, Or, Not, JumpFalse, JumpTrue };
+
+  /// Single operation
+  struct RuleOp
+  {
+    OpType type;       ///< Operation
+    int value;         ///< Sign of leaf / constant value
+    size_t index;      ///< Surface slot / jump target
+  };
+
+  /// Evaluation mode [matches the Rule virtual functions]
+  enum class EvalMode { Point, Exclude, Direction, Pair };
+
+  static const size_t localSize=64;   ///< Size of stack buffers
+
+  bool compiled;                      ///< Program is valid
+  size_t maxStack;                    ///< Max depth of value stack
+  std::vector<RuleOp> Prog;           ///< Operations
+  std::vector<const Geometry::Surface*> SurfSlot;  ///< Surface of slot
+  std::vector<int> SurfNum;           ///< Surface number of slot
+
+  size_t getSlot(const Geometry::Surface*,const int);
+  void addOp(const OpType,const int,const size_t);
+  bool compileRule(const Rule*);
+  bool compileGroup(const Rule*,const int);
+  void calcStack();
+
+  int evaluate(const EvalMode,const Geometry::Vec3D&,const int) const;
+
+ public:
+
+  RuleProgram();
+  RuleProgram(const RuleProgram&);
+  RuleProgram& operator=(const RuleProgram&);
+  ~RuleProgram() {}   ///< Destructor
+
+  /// Has the rule been compiled
+  bool isCompiled() const { return compiled; }
+  /// Number of operations
+  size_t size() const { return Prog.size(); }
+  /// Number of unique surfaces
+  size_t nSurface() const { return SurfSlot.size(); }
+
+  void clear();
+  bool compile(const Rule*);
+
+  bool isValid(const Geometry::Vec3D&) const;
+  bool isValid(const Geometry::Vec3D&,const int) const;
+  bool isDirectionValid(const Geometry::Vec3D&,const int) const;
+  int pairValid(const int,const Geometry::Vec3D&) const;
+
+  void write(std::ostream&) const;
+};
+
+std::ostream&
+operator<<(std::ostream&,const RuleProgram&);
+
+#endif
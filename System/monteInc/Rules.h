@@ -71,6 +71,9 @@ class Rule
   static int procPair(std::string&,std::map<int,Rule*>&,
 		      int&);
 
+  static void* operator new(size_t);
+  static void operator delete(void*,size_t);
+
   Rule();
   Rule(Rule*);
   Rule(const Rule&);  
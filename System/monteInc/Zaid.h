@@ -75,6 +75,8 @@ class Zaid
   double getAtomicMass() const;
 
   void write(std::ostream&) const;
+  void writeBinary(std::ostream&) const;
+  bool readBinary(std::istream&);
 
 };
 
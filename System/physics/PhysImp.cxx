@@ -336,6 +336,35 @@ PhysImp::renumberCell(const int oldCellN,const int newCellN)
   return; 
 }
 
+void
+PhysImp::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumbers all the cells in the map. The new map is built
+    in one pass so new numbers can be old numbers of other cells.
+    \param RMap :: Map of old cell : new cell
+  */
+{
+  ELog::RegMethod RegA("PhysImp","renumberCell(map)");
+  if (impNum.empty() || RMap.empty()) return;
+
+  typedef std::map<int,double> ITYPE;
+  for(const std::map<int,int>::value_type& RItem : RMap)
+    if (impNum.find(RItem.first)==impNum.end())
+      throw ColErr::InContainerError<int>(RItem.first,"Old cell not found "+
+					  RegA.getFull());    
+
+  ITYPE newImp;
+  for(const ITYPE::value_type& IItem : impNum)
+    {
+      std::map<int,int>::const_iterator mc=RMap.find(IItem.first);
+      const int cellN((mc!=RMap.end()) ? mc->second : IItem.first);
+      if (!newImp.insert(ITYPE::value_type(cellN,IItem.second)).second)
+	throw ColErr::InContainerError<int>(cellN,"New cell already present");
+    }
+  impNum.swap(newImp);
+  return; 
+}
+
 int
 PhysImp::removeParticle(const std::string& PT)
   /*!
@@ -914,6 +914,28 @@ PhysicsCards::substituteCell(const int oldCell,const int newCell)
 
   return;
 }
+
+void
+PhysicsCards::substituteCell(const std::map<int,int>& RMap)
+  /*!
+    Substitute all the cells in the map in all physics cards
+    that use cells. Each card is rebuilt once.
+    \param RMap :: Map of old cell : new cell 
+   */
+{
+  ELog::RegMethod RegA("PhysicsCards","substituteCell(map)");
+  histpCells.changeItem(RMap);
+  for(PhysImp& PI : ImpCards)
+    PI.renumberCell(RMap);
+  
+  Volume.renumberCell(RMap);
+  for(const std::map<int,int>::value_type& RItem : RMap)
+    {
+      PWTCard->renumberCell(RItem.first,RItem.second);
+      ExtCard->renumberCell(RItem.first,RItem.second);
+    }
+  return;
+}
   
 void
 PhysicsCards::setMode(std::string Particles) 
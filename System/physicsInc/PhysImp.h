@@ -80,6 +80,7 @@ class PhysImp
   void modifyCells(const std::vector<int>&,const double =1.0);
   void removeCell(const int);
   void renumberCell(const int,const int);
+  void renumberCell(const std::map<int,int>&);
 
   void write(std::ostream&,const std::set<std::string>&,
 	     const std::vector<int>&) const;
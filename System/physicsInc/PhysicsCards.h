@@ -170,6 +170,7 @@ class PhysicsCards
 
   void rotateMaster();
   void substituteCell(const int,const int);
+  void substituteCell(const std::map<int,int>&);
   //  void substituteSurface(const int,const int); 
 
   void writeHelp(const std::string&) const;
@@ -0,0 +1,522 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   poly/PolyFix.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <array>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "support.h"
+#include "mathSupport.h"
+#include "polySupport.h"
+#include "PolyFunction.h"
+#include "PolyVar.h"
+#include "PolyFix.h"
+
+namespace mathLevel
+{
+
+template<size_t MaxDeg>
+std::ostream& 
+operator<<(std::ostream& OX,const PolyFix<MaxDeg>& A)
+  /*!
+    External Friend :: outputs point to a stream 
+    \param OX :: output stream
+    \param A :: PolyFix to write
+    \returns The output stream (OX)
+  */
+{
+  A.write(OX);
+  return OX;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>::PolyFix() :
+  iDegree(0)
+  /*!
+    Constructor : zero polynominal
+  */
+{
+  PCoeff.fill(0.0);
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>::PolyFix(const PolyVar<1>& A) :
+  iDegree(0)
+  /*!
+    Constructor from a single variable PolyVar
+    \param A :: Polynominal to copy
+  */
+{
+  *this=A;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>::PolyFix(const size_t D,const double* Val) :
+  iDegree(D)
+  /*!
+    Constructor from an array
+    \param D :: Degree
+    \param Val :: Values low->high [size D+1]
+  */
+{
+  if (D>MaxDeg)
+    throw ColErr::RangeError<size_t>(D,0,MaxDeg,"PolyFix degree");
+  PCoeff.fill(0.0);
+  std::copy(Val,Val+D+1,PCoeff.begin());
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>::PolyFix(const PolyFix<MaxDeg>& A) :
+  iDegree(A.iDegree),PCoeff(A.PCoeff)
+  /*!
+    Copy Constructor
+    \param A :: PolyFix to copy
+  */
+{}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>& 
+PolyFix<MaxDeg>::operator=(const PolyFix<MaxDeg>& A)
+  /*!
+    Assignment operator
+    \param A :: PolyFix to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      iDegree=A.iDegree;
+      PCoeff=A.PCoeff;
+    }
+  return *this;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>& 
+PolyFix<MaxDeg>::operator=(const PolyVar<1>& A)
+  /*!
+    Assignment operator from a PolyVar
+    \param A :: PolyVar to copy
+    \return *this
+  */
+{
+  const size_t D=A.getDegree();
+  if (D>MaxDeg)
+    throw ColErr::RangeError<size_t>(D,0,MaxDeg,"PolyFix degree");
+  iDegree=D;
+  PCoeff.fill(0.0);
+  for(size_t i=0;i<=D;i++)
+    PCoeff[i]=A[i];
+  return *this;
+}
+
+template<size_t MaxDeg>
+void
+PolyFix<MaxDeg>::setDegree(const size_t D)
+  /*!
+    Set the degree value [new coefficients are zero]
+    \param D :: degree
+  */
+{
+  if (D>MaxDeg)
+    throw ColErr::RangeError<size_t>(D,0,MaxDeg,"PolyFix degree");
+  for(size_t i=D+1;i<=iDegree;i++)
+    PCoeff[i]=0.0;
+  iDegree=D;
+  return;
+}
+
+template<size_t MaxDeg>
+void
+PolyFix<MaxDeg>::setComp(const size_t Index,const double V)
+  /*!
+    Set a coefficient [degree increased if required]
+    \param Index :: Power of x
+    \param V :: Value
+  */
+{
+  if (Index>iDegree)
+    setDegree(Index);
+  PCoeff[Index]=V;
+  return;
+}
+
+template<size_t MaxDeg>
+void
+PolyFix<MaxDeg>::zeroPoly()
+  /*!
+    Zero the polynominal
+  */
+{
+  iDegree=0;
+  PCoeff.fill(0.0);
+  return;
+}
+
+template<size_t MaxDeg>
+double
+PolyFix<MaxDeg>::operator[](const size_t Index) const
+  /*!
+    Accessor to a coefficient
+    \param Index :: Power of x
+    \return coefficient [zero above the degree]
+  */
+{
+  return (Index<=MaxDeg) ? PCoeff[Index] : 0.0;
+}
+
+template<size_t MaxDeg>
+double
+PolyFix<MaxDeg>::operator()(const double X) const
+  /*!
+    Calculate the value of the polynomial at a point
+    \param X :: Value to calculate poly at
+    \return polyvalue
+  */
+{
+  double Result(PCoeff[iDegree]);
+  for(size_t i=iDegree;i>0;i--)
+    Result=Result*X+PCoeff[i-1];
+  return Result;
+}
+
+template<size_t MaxDeg>
+std::complex<double>
+PolyFix<MaxDeg>::evalPoly(const std::complex<double>& X) const
+  /*!
+    Calculate the value of the polynomial at a complex point
+    \param X :: Value to calculate poly at
+    \return polyvalue
+  */
+{
+  std::complex<double> Result(PCoeff[iDegree]);
+  for(size_t i=iDegree;i>0;i--)
+    Result=Result*X+PCoeff[i-1];
+  return Result;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>&
+PolyFix<MaxDeg>::operator+=(const PolyFix<MaxDeg>& A)
+  /*!
+    Self addition value
+    \param A :: PolyFix to add 
+    \return *this+=A;
+   */
+{
+  iDegree=std::max(iDegree,A.iDegree);
+  for(size_t i=0;i<=A.iDegree;i++)
+    PCoeff[i]+=A.PCoeff[i];
+  return *this;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>&
+PolyFix<MaxDeg>::operator-=(const PolyFix<MaxDeg>& A)
+  /*!
+    Self subtraction value
+    \param A :: PolyFix to subtract
+    \return *this-=A;
+   */
+{
+  iDegree=std::max(iDegree,A.iDegree);
+  for(size_t i=0;i<=A.iDegree;i++)
+    PCoeff[i]-=A.PCoeff[i];
+  return *this;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>&
+PolyFix<MaxDeg>::operator*=(const PolyFix<MaxDeg>& A)
+  /*!
+    Self multiplication value
+    \param A :: PolyFix to multiply
+    \return *this*=A;
+    \throw RangeError if the result degree exceeds MaxDeg
+  */
+{
+  const size_t iD=iDegree+A.iDegree;
+  if (iD>MaxDeg)
+    throw ColErr::RangeError<size_t>(iD,0,MaxDeg,"PolyFix degree");
+
+  std::array<double,MaxDeg+1> CX;
+  CX.fill(0.0);
+  for(size_t i=0;i<=iDegree;i++)
+    for(size_t j=0;j<=A.iDegree;j++)
+      CX[i+j]+=PCoeff[i]*A.PCoeff[j];
+
+  PCoeff=CX;
+  iDegree=iD;
+  return *this;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>&
+PolyFix<MaxDeg>::operator*=(const double V)
+  /*!
+    Scalar multiplication
+    \param V :: Value to multiply
+    \return *this*=V;
+  */
+{
+  for(size_t i=0;i<=iDegree;i++)
+    PCoeff[i]*=V;
+  return *this;
+}
+
+template<size_t MaxDeg>
+PolyFix<MaxDeg>
+PolyFix<MaxDeg>::getDerivative() const
+  /*!
+    Returns the derivative of the polynominal
+    \return dP/dx
+  */
+{
+  PolyFix<MaxDeg> Out;
+  if (iDegree)
+    {
+      Out.iDegree=iDegree-1;
+      for(size_t i=1;i<=iDegree;i++)
+	Out.PCoeff[i-1]=static_cast<double>(i)*PCoeff[i];
+    }
+  return Out;
+}
+
+template<size_t MaxDeg>
+void 
+PolyFix<MaxDeg>::compress(const double eps)
+  /*!
+    Reduce degree by eliminating all (nearly) zero leading 
+    coefficients
+    \param eps :: coeficient to use to decide if a values is zero
+  */
+{
+  for (;iDegree>0 && std::abs(PCoeff[iDegree])<=eps;iDegree--)
+    PCoeff[iDegree]=0.0;
+  return;
+}
+
+template<size_t MaxDeg>
+size_t
+PolyFix<MaxDeg>::unitCoeff(double* C,const double eps) const
+  /*!
+    Copy the coefficients with near zero leading values removed
+    and with the leading value set to unity
+    \param C :: Output coefficients [low->high]
+    \param eps :: Tolerance on a zero coefficient
+    \return degree 
+  */
+{
+  size_t D(iDegree);
+  for (;D>0 && std::abs(PCoeff[D])<=eps;D--) ;
+  for(size_t i=0;i<D;i++)
+    C[i]=PCoeff[i]/PCoeff[D];
+  C[D]=1.0;
+  return D;
+}
+
+template<size_t MaxDeg>
+size_t
+PolyFix<MaxDeg>::durandKerner(const size_t D,const double* C,
+			      std::complex<double>* cn,
+			      const double eps) const
+  /*!
+    Calculate all the roots of the unit polynominal C.
+    Uses the Durand-Kerner method as PolyVar<1> but
+    with all the storage on the stack
+    \param D :: Degree of C
+    \param C :: Coefficients [low->high, C[D]==1]
+    \param cn :: Roots [size D]
+    \param eps :: tolerance factor
+    \return number of roots
+  */
+{
+  cn[0]=std::complex<double>(0.4,0.9);
+  for(size_t i=1;i<D;i++)
+    cn[i]=cn[0]*cn[i-1];
+
+  // roots that have converged are not moved again
+  std::array<bool,MaxDeg> done;
+  done.fill(0);
+  const size_t maxIter(300);
+  size_t flag(1);
+  for(size_t iter=0;iter<maxIter && flag;iter++)
+    {
+      flag=0;
+      for(size_t i=0;i<D;i++)
+	{
+	  if (done[i]) continue;
+	  // real arithmetic : avoids the inf/nan checks of complex mult
+	  const double xR(cn[i].real());
+	  const double xI(cn[i].imag());
+	  double dR(1.0),dI(0.0);
+	  for(size_t j=0;j<D;j++)
+	    if (j!=i)
+	      {
+		const double aR(xR-cn[j].real());
+		const double aI(xI-cn[j].imag());
+		const double tR(dR*aR-dI*aI);
+		dI=dR*aI+dI*aR;
+		dR=tR;
+	      }
+	  double pR(1.0),pI(0.0);
+	  for(size_t j=D;j>0;j--)
+	    {
+	      const double tR(pR*xR-pI*xI+C[j-1]);
+	      pI=pR*xI+pI*xR;
+	      pR=tR;
+	    }
+	  const double dNorm(dR*dR+dI*dI);
+	  const std::complex<double> modTerm((pR*dR+pI*dI)/dNorm,
+					     (pI*dR-pR*dI)/dNorm);
+	  cn[i]-=modTerm;
+	  if (std::norm(modTerm)>eps*eps/1e4)
+	    flag++;
+	  else
+	    done[i]=1;
+	}
+    }
+  return D;
+}
+
+template<size_t MaxDeg>
+double
+PolyFix<MaxDeg>::polish(const double X) const
+  /*!
+    Improve a real root by Newton steps 
+    [only accepted if the residual is reduced]
+    \param X :: Initial root
+    \return improved root
+  */
+{
+  double root(X);
+  for(size_t iter=0;iter<3;iter++)
+    {
+      double F(PCoeff[iDegree]),dF(0.0);
+      for(size_t i=iDegree;i>0;i--)
+	{
+	  dF=dF*root+F;
+	  F=F*root+PCoeff[i-1];
+	}
+      if (std::abs(dF)<1e-300 || F==0.0)
+	break;
+      const double nextRoot(root-F/dF);
+      if (std::abs((*this)(nextRoot))>=std::abs(F))
+	break;
+      root=nextRoot;
+    }
+  return root;
+}
+
+template<size_t MaxDeg>
+size_t
+PolyFix<MaxDeg>::calcRoots(std::array<std::complex<double>,MaxDeg>& Out,
+			   const double eps) const
+  /*!
+    Calculate all the roots of the polynominal.
+    Closed form for degree 4 or less else Durand-Kerner.
+    \param Out :: Roots found
+    \param eps :: tolerance factor
+    \return number of roots (not sorted/uniqued)
+  */
+{
+  double C[MaxDeg+1];
+  const size_t D=unitCoeff(C,eps);
+  switch (D)
+    {
+    case 0:
+      return 0;
+    case 1:   // x+a_0 =0 
+      Out[0]=std::complex<double>(-C[0]);
+      return 1;
+    case 2:   // x^2+a_1 x+a_0=0
+      return ::solveQuadratic(1.0,C[1],C[0],Out[0],Out[1]);
+    case 3:   // x^3+a_2 x^2+ a_1 x+a_0=0
+      return ::solveCubic(1.0,C[2],C[1],C[0],Out[0],Out[1],Out[2]);
+    case 4:
+      return ::solveQuartic(1.0,C[3],C[2],C[1],C[0],Out.data());
+    default:
+      return durandKerner(D,C,Out.data(),eps);
+    }
+}
+
+template<size_t MaxDeg>
+size_t
+PolyFix<MaxDeg>::realRoots(std::array<double,MaxDeg>& Out,
+			   const double eps) const
+  /*!
+    Get just the real roots
+    \param Out :: Real roots [sorted/unique]
+    \param eps :: tolerance factor
+    \return number of real roots 
+  */
+{
+  std::array<std::complex<double>,MaxDeg> CRoots;
+  const size_t nC=calcRoots(CRoots,eps);
+  size_t nR(0);
+  for(size_t i=0;i<nC;i++)
+    if (std::abs(CRoots[i].imag())<eps)
+      Out[nR++]=polish(CRoots[i].real());
+
+  std::sort(Out.begin(),Out.begin()+nR);
+  return static_cast<size_t>
+    (std::unique(Out.begin(),Out.begin()+nR,mathSupport::tolEqual(eps))-
+     Out.begin());
+}
+
+template<size_t MaxDeg>
+void
+PolyFix<MaxDeg>::write(std::ostream& OX) const
+  /*!
+    Basic write command
+    \param OX :: output stream
+  */
+{
+  const std::vector<double> Val(PCoeff.begin(),PCoeff.begin()+iDegree+1);
+  PolyVar<1>(Val).write(OX);
+  return;
+}
+
+/// \cond TEMPLATE
+
+template class PolyFix<4>;
+template class PolyFix<8>;
+template class PolyFix<16>;
+
+template std::ostream& operator<<(std::ostream&,const PolyFix<4>&);
+template std::ostream& operator<<(std::ostream&,const PolyFix<8>&);
+template std::ostream& operator<<(std::ostream&,const PolyFix<16>&);
+
+/// \endcond TEMPLATE
+
+}  // NAMESPACE  mathLevel
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <complex>
 #include <vector>
+#include <array>
 #include <map>
 #include <algorithm>
 #include <iterator>
@@ -49,6 +50,7 @@
 #include "polySupport.h"
 #include "PolyFunction.h"
 #include "PolyVar.h"
+#include "PolyFix.h"
 
 namespace mathLevel
 {
@@ -815,7 +817,9 @@ PolyVar<1>::divide(const PolyVar<1>& pD,PolyVar<1>& pQ,
 std::vector<double> 
 PolyVar<1>::realRoots(const double epsilon)
   /*!
-    Get just the real roots
+    Get just the real roots. Polynominals of degree 16 or 
+    less are solved by PolyFix [no allocation/closed form
+    up to quartics].
     \param epsilon :: tolerance factor (-ve to use default)
     \return vector of the real roots (if any)
   */
@@ -823,6 +827,14 @@ PolyVar<1>::realRoots(const double epsilon)
   ELog::RegMethod RegA("PolyVar<1>","realRoots");
 
   const double eps((epsilon>0.0) ? epsilon : Eaccuracy);
+  unitPrimary(epsilon);
+  if (iDegree<=16)
+    {
+      std::array<double,16> Roots;
+      const size_t nRoots=PolyFix<16>(*this).realRoots(Roots,eps);
+      return std::vector<double>(Roots.begin(),Roots.begin()+nRoots);
+    }
+  
   std::vector<std::complex<double> > Croots=calcDurandKernerRoots(epsilon);
   std::vector<double> Out;
   std::vector<std::complex<double> >::const_iterator vc;
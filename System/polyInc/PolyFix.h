@@ -0,0 +1,97 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   polyInc/PolyFix.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef mathLevel_PolyFix_h
+#define mathLevel_PolyFix_h
+
+namespace mathLevel
+{
+
+  /*!
+    \class PolyFix
+    \version 1.0
+    \author S. Ansell 
+    \date March 2018
+    \brief Single variable polynominal of bounded degree
+
+    The coefficients are held in a fixed array so no
+    operation allocates. Roots of degree 4 or less are
+    found in closed form, higher degrees by Durand-Kerner
+    on a stack array. The degree must not exceed MaxDeg.
+  */
+
+template<size_t MaxDeg>
+class PolyFix 
+{
+ private:
+
+  size_t iDegree;                          ///< Degree [0 == constant]
+  std::array<double,MaxDeg+1> PCoeff;      ///< Coefficients [low->high]
+
+  size_t unitCoeff(double*,const double) const;
+  size_t durandKerner(const size_t,const double*,
+		      std::complex<double>*,const double) const;
+  double polish(const double) const;
+
+ public:
+
+  PolyFix();
+  explicit PolyFix(const PolyVar<1>&);
+  PolyFix(const size_t,const double*);
+  PolyFix(const PolyFix<MaxDeg>&);
+  PolyFix<MaxDeg>& operator=(const PolyFix<MaxDeg>&);
+  PolyFix<MaxDeg>& operator=(const PolyVar<1>&);
+  ~PolyFix() {}   ///< Destructor
+
+  // member access
+  void setDegree(const size_t);
+  /// Access degree
+  size_t getDegree() const { return iDegree; }
+  void setComp(const size_t,const double);
+  void zeroPoly();
+  double operator[](const size_t) const;
+
+  // evaluation
+  double operator()(const double) const;
+  std::complex<double> evalPoly(const std::complex<double>&) const;
+
+  // arithmetic updates
+  PolyFix<MaxDeg>& operator+=(const PolyFix<MaxDeg>&);
+  PolyFix<MaxDeg>& operator-=(const PolyFix<MaxDeg>&);
+  PolyFix<MaxDeg>& operator*=(const PolyFix<MaxDeg>&);
+  PolyFix<MaxDeg>& operator*=(const double);
+
+  PolyFix<MaxDeg> getDerivative() const;
+  void compress(const double);
+
+  size_t calcRoots(std::array<std::complex<double>,MaxDeg>&,
+		   const double =1e-6) const;
+  size_t realRoots(std::array<double,MaxDeg>&,const double =1e-6) const;
+
+  void write(std::ostream&) const;
+};
+
+template<size_t MaxDeg> 
+std::ostream& operator<<(std::ostream&,const PolyFix<MaxDeg>&);
+
+}  // NAMESPACE mathLevel
+
+#endif
@@ -160,14 +160,19 @@ LineTrack::clearAll()
 
   
 void
-LineTrack::calculate(const Simulation& ASim)
+LineTrack::calculate(const Simulation& ASim,const double maxAttn)
   /*!
     Calculate the track
     \param ASim :: Simulation to use						
+    \param maxAttn :: Stop the track once the attenuation sum
+      reaches this value [<0 : full track]
   */
 {
   ELog::RegMethod RegA("LineTrack","calculate");
 
+  const std::vector<double>& AT=
+    ModelSupport::DBMaterial::Instance().getAttnTable();
+  double attnSum(0.0);                     // Attenuation of track
   double aDist(0);                         // Length of track
   const Geometry::Surface* SPtr;           // Surface
   const ModelSupport::ObjSurfMap* OSMPtr =ASim.getOSM();
@@ -187,6 +192,11 @@ LineTrack::calculate(const Simulation& ASim)
       // Update Track : returns 1 on excess of distance
       if (SN && updateDistance(OPtr,SPtr,SN,aDist))
 	{
+	  if (maxAttn>=0.0)
+	    {
+	      attnSum+=getAttnItem(AT,Track.size()-1);
+	      if (attnSum>=maxAttn) break;
+	    }
 	  nOut.moveForward(aDist);
 	  
 	  OPtr=OSMPtr->findNextObject(SN,nOut.Pos,OPtr->getName());
@@ -385,6 +395,43 @@ LineTrack::getPoint(const size_t Index) const
   return InitPt+(EndPt-InitPt).unit()*Len;
 }
 
+double
+LineTrack::getAttnItem(const std::vector<double>& AT,
+		       const size_t index) const
+  /*!
+    Attenuation [track * atomDensity * A^0.66] of one 
+    track unit using the dense material table of DBMaterial.
+    \param AT :: Attenuation table [DBMaterial]
+    \param index :: Track unit
+    \return attenuation 
+  */
+{
+  const int matN=(!ObjVec[index]) ? -1 : ObjVec[index]->getMat();
+  if (matN<=0) return 0.0;
+
+  const size_t mIndex(static_cast<size_t>(matN));
+  if (mIndex>=AT.size() || AT[mIndex]<0.0)
+    throw ColErr::InContainerError<int>(matN,"matN in AttnTable");
+  return Track[index]*AT[mIndex];
+}
+
+double
+LineTrack::getAttnSum() const
+  /*!
+    Sum the attenuation [track * atomDensity * A^0.66] over
+    the whole track in one pass 
+    \return attenuation sum
+  */
+{
+  const std::vector<double>& AT=
+    ModelSupport::DBMaterial::Instance().getAttnTable();
+
+  double sum(0.0);
+  for(size_t i=0;i<Track.size();i++)
+    sum+=getAttnItem(AT,i);
+  return sum;
+}
+
 void
 LineTrack::createAttenPath(std::vector<long int>& cVec,
 			   std::vector<double>& aVec) const
@@ -402,12 +449,8 @@ LineTrack::createAttenPath(std::vector<long int>& cVec,
       const int matN=(!ObjVec[i]) ? -1 : ObjVec[i]->getMat();
       if (matN>0)
 	{
-	  const MonteCarlo::Material& matInfo=DB.getMaterial(matN);
-	  const double density=matInfo.getAtomDensity();
-	  const double A=matInfo.getMeanA();
-	  const double sigma=Track[i]*density*std::pow(A,0.66);
 	  cVec.push_back(ObjVec[i]->getName());
-	  aVec.push_back(sigma);
+	  aVec.push_back(Track[i]*DB.getAttnFactor(matN));
 	}
     }
   return;
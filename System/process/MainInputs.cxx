@@ -87,6 +87,7 @@ createInputs(inputParam& IParam)
   IParam.regDefItem<std::string>("matDB","materialDatabase",1,
                                  std::string("shielding"));  
   IParam.regItem("matFile","matFile");
+  IParam.regItem("matSnap","matSnapshot");
   IParam.regFlag("M","mesh");
   IParam.regItem("MA","meshA");
   IParam.regItem("MB","meshB");
@@ -94,6 +95,8 @@ createInputs(inputParam& IParam)
   IParam.regFlag("md5","md5");
   IParam.regItem("memStack","memStack");
   IParam.regDefItem<int>("n","nps",1,10000);
+  IParam.regFlag("noCompileRule","noCompileRule");
+  IParam.regFlag("noTrace","noTrace");
   IParam.regFlag("p","PHITS");
   IParam.regFlag("fluka","FLUKA");
   IParam.regItem("povray","PovRay");
@@ -132,9 +135,11 @@ createInputs(inputParam& IParam)
   IParam.regMulti("TMod","tallyMod",8,1);
   IParam.regFlag("TW","tallyWeight");
   IParam.regItem("TX","Txml",1);
+  IParam.regDefItem<int>("threads","threads",1,1);
   IParam.regItem("targetType","targetType",1);
   IParam.regDefItem<int>("u","units",1,0);
   IParam.regItem("validCheck","validCheck",1);
+  IParam.regFlag("validFC","validFC");
   IParam.regMulti("validLine","validLine",1000);
   IParam.regItem("validPoint","validPoint",1);
   IParam.regFlag("um","voidUnMask");
@@ -145,6 +150,8 @@ createInputs(inputParam& IParam)
     
   IParam.regFlag("void","void");
   IParam.regFlag("vtk","vtk");
+  IParam.regFlag("vtkBinary","vtkBinary");
+  IParam.regFlag("vtkLine","vtkLine");
   IParam.regFlag("vcell","vcell");
   std::vector<std::string> VItems(15,"");
   IParam.regDefItemList<std::string>("vmat","vmat",15,VItems);
@@ -208,6 +215,8 @@ createInputs(inputParam& IParam)
   IParam.setDesc("matDB","Set the material database to use "
                  "(shielding or neutronics)");  
   IParam.setDesc("matFile","Set the materials from a file");
+  IParam.setDesc("matSnap","Binary snapshot of the default materials "
+                 "(read if valid / written otherwise)");
 
   IParam.setDesc("M","Add mesh tally");
   IParam.setDesc("MA","Lower Point in mesh tally");
@@ -215,6 +224,8 @@ createInputs(inputParam& IParam)
   IParam.setDesc("MN","Number of points [3]");
   IParam.setDesc("md5","MD5 track of cells");
   IParam.setDesc("memStack","Memstack verbrosity value");
+  IParam.setDesc("noCompileRule","Evaluate cells from the rule tree");
+  IParam.setDesc("noTrace","No call stack in log/exception output [faster]");
   IParam.setDesc("n","Number of starting particles");
   IParam.setDesc("MCNP","MCNP version");
   IParam.setDesc("FLUKA","FLUKA output");
@@ -246,6 +257,7 @@ createInputs(inputParam& IParam)
   IParam.setDesc("TGrid","Set a grid on a point tally [tallyN NXpts NZPts]");
   IParam.setDesc("TW","Activate tally pd weight system");
   IParam.setDesc("Txml","Tally xml file");
+  IParam.setDesc("threads","Threads for mesh tracking [0 : all cores]");
   IParam.setDesc("targetType","Name of target type");
   IParam.setDesc("u","Units in cm");
   IParam.setDesc("um","Unset spherical void area (from imp=0)");
@@ -254,11 +266,14 @@ createInputs(inputParam& IParam)
   IParam.setDesc("volCells","Cells [object/range]");
   IParam.setDesc("volCard","set/delete the vol card");
   IParam.setDesc("vtk","Write out VTK plot mesh");
+  IParam.setDesc("vtkBinary","Stream the VTK mesh as binary [low memory]");
+  IParam.setDesc("vtkLine","Track each VTK mesh row [not point tests]");
   IParam.setDesc("vcell","Use cell id rather than material");
   IParam.setDesc("vmat","Material sections to be written by vtk output");
   IParam.setDesc("VN","Number of points in the volume integration");
   IParam.setDesc("validCheck","Run simulation to check for validity");
   IParam.setDesc("validPoint","Point to start valid check from");
+  IParam.setDesc("validFC","Valid check from all link points [threaded]");
 
   IParam.setDesc("w","weightBias");
   IParam.setDesc("wExt","Extraction biasisng [see: -wExt help]");
@@ -266,7 +281,7 @@ createInputs(inputParam& IParam)
   IParam.setDesc("wDD","Dxtran Diagnostic [set -wDXT help] ");
   IParam.setDesc("wWWG","Weight WindowGenerator Mesh  ");
   IParam.setDesc("wwgCalc","Single step evolve for the calculate for WWG/WWCell  ");
-  IParam.setDesc("wwgMarkov","Evolve the calculate for WWG/WWCell  ");
+  IParam.setDesc("wwgMarkov","Markov iterations of the WWG flux [count]");
   IParam.setDesc("wIMP","set imp partile imp object(s)  ");
   IParam.setDesc("wFCL","Forced Collision ");
   IParam.setDesc("wPWT","Photon Bias [set -wPWT help]");
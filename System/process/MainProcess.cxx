@@ -63,6 +63,10 @@
 #include "SimMonte.h"
 #include "variableSetup.h"
 #include "defaultConfig.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
 #include "DBModify.h"
 #include "SimProcess.h"
 #include "DefPhysics.h"
@@ -78,6 +82,8 @@
 
 #include "surfRegister.h"
 #include "HeadRule.h"
+#include "Object.h"
+#include "ThreadControl.h"
 #include "LinkUnit.h"
 #include "FixedComp.h"
 
@@ -394,6 +400,16 @@ createSimulation(inputParam& IParam,
   
   IParam.processMainInput(Names);
 
+  if (IParam.flag("noCompileRule"))
+    MonteCarlo::Object::setCompileRule(0);
+  if (IParam.flag("noTrace"))
+    ELog::RegMethod::setTrace(0);
+
+  const int nThread=IParam.getValue<int>("threads");
+  if (nThread<0 || nThread>4096)
+    throw ColErr::RangeError<int>(nThread,0,4096,"threads");
+  ModelSupport::ThreadControl::setThreads(static_cast<size_t>(nThread));
+
   Simulation* SimPtr;
   if (IParam.flag("PHITS"))
     SimPtr=new SimPHITS;
@@ -439,6 +455,10 @@ setMaterialsDataBase(const inputParam& IParam)
 {
   ELog::RegMethod RegA("MainProcess","setMaterialsDataBase");
 
+  if (IParam.flag("matSnap"))
+    ModelSupport::DBMaterial::setSnapshot
+      (IParam.getValue<std::string>("matSnap"));
+
   const std::string materials=IParam.getValue<std::string>("matDB");
   
   // Add extra materials to the DBMaterials
@@ -501,7 +521,6 @@ buildFullSimulation(Simulation* SimPtr,
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimulation");
 
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
 
   tallyAddition(*SimPtr,IParam);
@@ -523,13 +542,8 @@ buildFullSimulation(Simulation* SimPtr,
 
   SDef::sourceSelection(*SimPtr,IParam);
   SimPtr->masterPhysicsRotation();
-  // Ensure we done loop
-  do
-    {
-      SimProcess::writeIndexSim(*SimPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  // Ensure we done loop : one render for all the seeds
+  SimProcess::writeMultiSim(*SimPtr,OName,multi);
 
   return;
 }
@@ -0,0 +1,285 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/ObjBoxIndex.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ObjBoxIndex.h"
+
+namespace ModelSupport
+{
+
+const double ObjBoxIndex::boxPad(1e-3);
+
+ObjBoxIndex::ObjBoxIndex() :
+  active(0),built(0),buildChange(0)
+ /*!
+   Constructor
+ */
+{}
+
+ObjBoxIndex::ObjBoxIndex(const ObjBoxIndex& A) :
+  active(0),built(0),buildChange(0)
+ /*!
+   Copy constructor : The index holds pointers to
+   the cells of the owner so it is not copied
+   \param A :: ObjBoxIndex to copy
+ */
+{
+  (void) A;
+}
+
+ObjBoxIndex&
+ObjBoxIndex::operator=(const ObjBoxIndex& A)
+ /*!
+   Assignment operator : drops the index [see copy constructor]
+   \param A :: ObjBoxIndex to copy
+   \return *this
+ */
+{
+  if (this!=&A)
+    clearAll();
+  return *this;
+}
+
+bool
+ObjBoxIndex::isBuilt() const
+  /*!
+    Determine if the tree is current : no cell has
+    changed its rule/surfaces since the build
+    \return true if the tree can be used
+  */
+{
+  return (built && buildChange==MonteCarlo::Object::getRuleChange());
+}
+
+void
+ObjBoxIndex::setActive()
+  /*!
+    Allow the index to be used. The tree is built 
+    on the next search
+  */
+{
+  active=1;
+  return;
+}
+
+void
+ObjBoxIndex::clearAll()
+  /*!
+    Drop the index and disable it until the next setActive
+  */
+{
+  active=0;
+  reset();
+  return;
+}
+
+void
+ObjBoxIndex::reset()
+  /*!
+    Drop the tree : it is rebuilt on the next search
+  */
+{
+  built=0;
+  Cells.clear();
+  CellBox.clear();
+  Items.clear();
+  OpenItems.clear();
+  Nodes.clear();
+  return;
+}
+
+size_t
+ObjBoxIndex::buildNode(const size_t first,const size_t last)
+  /*!
+    Build the tree node for the range of Items [first,last)
+    Splits at the median centre of the longest axis
+    \param first :: first item
+    \param last :: one past the last item
+    \return index of the node
+  */
+{
+  BoxNode Node;
+  Node.Box=Geometry::BoundBox::emptyBox();
+  Node.left=0;
+  Node.right=0;
+  Node.first=first;
+  Node.count=last-first;
+
+  Geometry::BoundBox CentreBox=Geometry::BoundBox::emptyBox();
+  for(size_t i=first;i<last;i++)
+    {
+      Node.Box.unite(CellBox[Items[i]]);
+      CentreBox.addPoint(CellBox[Items[i]].centre());
+    }
+  const size_t index=Nodes.size();
+  Nodes.push_back(Node);
+  if (last-first<=leafSize)
+    return index;
+
+  const size_t axis=CentreBox.longAxis();
+  const size_t mid=(first+last)/2;
+  std::nth_element
+    (Items.begin()+static_cast<long int>(first),
+     Items.begin()+static_cast<long int>(mid),
+     Items.begin()+static_cast<long int>(last),
+     [this,axis](const size_t A,const size_t B)
+     {
+       return (CellBox[A].low(axis)+CellBox[A].high(axis)) <
+	 (CellBox[B].low(axis)+CellBox[B].high(axis));
+     });
+
+  const size_t leftIndex=buildNode(first,mid);
+  const size_t rightIndex=buildNode(mid,last);
+  Nodes[index].left=leftIndex;
+  Nodes[index].right=rightIndex;
+  Nodes[index].count=0;
+  return index;
+}
+
+void
+ObjBoxIndex::build(const std::map<int,MonteCarlo::Qhull*>& OList)
+  /*!
+    Build the tree from the cell list. The cells need
+    to be populated.
+    \param OList :: Cell map
+  */
+{
+  ELog::RegMethod RegA("ObjBoxIndex","build");
+
+  reset();
+  buildChange=MonteCarlo::Object::getRuleChange();
+
+  for(const std::map<int,MonteCarlo::Qhull*>::value_type& OVal : OList)
+    {
+      if (OVal.second->isPlaceHold()) continue;
+
+      const size_t index(Cells.size());
+      Cells.push_back(OVal.second);
+      CellBox.push_back(OVal.second->getHeadRule().calcBoundBox());
+      Geometry::BoundBox& BBox=CellBox.back();
+      BBox.pad(boxPad);
+      // empty boxes are kept open : tolerance on the surfaces
+      if (BBox.isFinite())
+	Items.push_back(index);
+      else
+	OpenItems.push_back(index);
+    }
+  if (!Items.empty())
+    buildNode(0,Items.size());
+
+  built=1;
+  return;
+}
+
+void
+ObjBoxIndex::findCandidates(const Geometry::Vec3D& Pt,
+			    std::vector<size_t>& Out) const
+  /*!
+    Find all the cells in the tree that have a box containing Pt
+    \param Pt :: Point to test
+    \param Out :: Cell indexes [unsorted]
+  */
+{
+  if (Nodes.empty()) return;
+
+  // Median split : depth is bounded by log2(cells)
+  size_t Stack[64];
+  size_t nStack(1);
+  Stack[0]=0;
+  while(nStack)
+    {
+      const BoxNode& Node=Nodes[Stack[--nStack]];
+      if (!Node.Box.isValid(Pt)) continue;
+      if (!Node.left)
+	{
+	  for(size_t i=Node.first;i<Node.first+Node.count;i++)
+	    if (CellBox[Items[i]].isValid(Pt))
+	      Out.push_back(Items[i]);
+	}
+      else
+	{
+	  Stack[nStack++]=Node.right;
+	  Stack[nStack++]=Node.left;
+	}
+    }
+  return;
+}
+
+MonteCarlo::Object*
+ObjBoxIndex::findCell(const Geometry::Vec3D& Pt) const
+  /*!
+    Find the cell that contains Pt. The cells are tested
+    in the same order as the cell map so the result is
+    the same as a full search.
+    \param Pt :: Point to find
+    \return Object ptr / 0 if no cell found
+  */
+{
+  std::vector<size_t> Cand;
+  findCandidates(Pt,Cand);
+  std::sort(Cand.begin(),Cand.end());
+
+  size_t indexA(0);
+  size_t indexB(0);
+  while(indexA<Cand.size() || indexB<OpenItems.size())
+    {
+      size_t index;
+      if (indexB==OpenItems.size() ||
+	  (indexA<Cand.size() && Cand[indexA]<OpenItems[indexB]))
+	index=Cand[indexA++];
+      else
+	index=OpenItems[indexB++];
+      if (Cells[index]->isValid(Pt))
+	return Cells[index];
+    }
+  return 0;
+}
+
+}  // NAMESPACE ModelSupport
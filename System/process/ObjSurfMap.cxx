@@ -51,6 +51,7 @@
 #include "Quadratic.h"
 #include "Plane.h"
 #include "surfIndex.h"
+#include "SideCache.h"
 #include "surfEqual.h"
 #include "localRotate.h"
 #include "masterRotate.h"
@@ -264,6 +265,8 @@ ObjSurfMap::findNextObject(const int SN,
   const STYPE& MVec=getObjects(SN);
   STYPE::const_iterator mc;
 
+  // cells on SN share most of their surfaces
+  const Geometry::SideScope SScope;
   for(MonteCarlo::Object* MPtr : MVec)
     {
       if (MPtr->getName()!=objExclude && 
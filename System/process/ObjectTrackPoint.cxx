@@ -101,12 +101,14 @@ ObjectTrackPoint::operator=(const ObjectTrackPoint& A)
 void
 ObjectTrackPoint::addUnit(const Simulation& System,
 			const long int objN,
-			const Geometry::Vec3D& IPt)
+			const Geometry::Vec3D& IPt,
+			const double maxAttn)
   /*!
     Create a target track between the IPt and the target point
     \param System :: Simulation to use
     \param objN :: Index of object
     \param IPt :: initial point
+    \param maxAttn :: Stop the track at this attenuation [<0 : none]
   */
 {
   ELog::RegMethod RegA("ObjectTrackPoint","addUnit");
@@ -117,7 +119,7 @@ ObjectTrackPoint::addUnit(const Simulation& System,
     Items.erase(mc);
 
   LineTrack A(IPt,TargetPt);
-  A.calculate(System);
+  A.calculate(System,maxAttn);
   Items.insert(std::map<long int,LineTrack>::value_type(objN,A));
   return;
 }  
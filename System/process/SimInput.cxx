@@ -134,6 +134,15 @@ processExitChecks(Simulation& System,const mainSystem::inputParam& IParam)
 				    IParam.getValue<size_t>("validCheck")))
 	    errFlag += -1;
 	}
+      if (IParam.flag("validFC"))
+	{
+	  const size_t seed=
+	    static_cast<size_t>(IParam.getValue<long int>("random"));
+	  if (!SValidCheck.runFixedComp(System,
+					IParam.getValue<size_t>("validCheck"),
+					seed))
+	    errFlag += -1;
+	}
     }
 
   
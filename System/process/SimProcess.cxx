@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -33,6 +34,8 @@
 #include <iterator>
 #include <memory>
 #include <array>
+#include <functional>
+#include <typeinfo>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -64,6 +67,8 @@
 #include "LSwitchCard.h"
 #include "PhysicsCards.h"
 #include "Simulation.h"
+#include "ThreadControl.h"
+#include "version.h"
 #include "SimProcess.h"
 
 namespace SimProcess
@@ -115,6 +120,90 @@ writeIndexSim(Simulation& System,const std::string& FName,const int Number)
   return;
 }
   
+void
+writeMultiSim(Simulation& System,const std::string& FName,
+	      const int NFile)
+  /*!
+    Writes out NFile decks with the same random number seeds
+    and version numbers as NFile calls to writeIndexSim. 
+    The deck body [variables to source] is rendered once, the
+    head [version number] and physics cards [seed] are rendered 
+    for each file, and the files are then written in parallel.
+    \param System :: Simuation object [MCNP only]
+    \param FName :: basic filename
+    \param NFile :: number of files to write
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSim");
+
+  // Derived types write their own format
+  if (NFile<2 || typeid(System)!=typeid(Simulation))
+    {
+      int index(0);
+      do
+	{
+	  writeIndexSim(System,FName,index);
+	  index++;
+	}
+      while(index<NFile);
+      return;
+    }
+
+  physicsSystem::PhysicsCards& PC=System.getPC();
+  const size_t NF(static_cast<size_t>(NFile));
+
+  // seeds given by sequential writeIndexSim calls
+  std::vector<long int> Seed(NF);
+  long int seed(PC.getRNDseed());
+  for(size_t i=0;i<NF;i++)
+    {
+      const long int nextSeed(seed+static_cast<long int>(i)*10);
+      if (nextSeed) seed=nextSeed;
+      Seed[i]=seed;
+    }
+
+  System.prepareWrite();
+
+  std::ostringstream bx;
+  System.writeDeckBody(bx);
+  const std::string Body(bx.str());
+
+  // version increment given by sequential writeIndexSim calls
+  version& VInfo=version::Instance();
+  std::vector<std::string> Head(NF);
+  std::vector<std::string> Phys(NF);
+  for(size_t i=0;i<NF;i++)
+    {
+      std::ostringstream hx;
+      System.writeDeckHead(hx,VInfo.getIncrement());
+      Head[i]=hx.str();
+
+      PC.setRND(Seed[i]);
+      std::ostringstream px;
+      System.writePhysics(px);
+      Phys[i]=px.str();
+    }
+
+  ModelSupport::ThreadControl::runBlocks
+    (NF,1,
+     [&](const size_t first,const size_t last)
+     {
+       for(size_t i=first;i<last;i++)
+	 {
+	   std::ostringstream cx;
+	   cx<<FName<<i+1<<".x";
+	   std::ofstream OX(cx.str().c_str());
+	   OX.write(Head[i].data(),
+		    static_cast<std::streamsize>(Head[i].size()));
+	   OX.write(Body.data(),
+		    static_cast<std::streamsize>(Body.size()));
+	   OX.write(Phys[i].data(),
+		    static_cast<std::streamsize>(Phys[i].size()));
+	 }
+     });
+  return;
+}
+
 void
 writeIndexSimPHITS(Simulation& System,const std::string& FName,
 		   const int Number)
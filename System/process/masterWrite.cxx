@@ -93,7 +93,7 @@ masterWrite::Num(const double& D)
   if (fabs(D)<zeroTol)
     return "0.0";
 
-  return (FMTdouble % D).str();
+  return (boost::format(FMTdouble) % D).str();
 }
   
 std::string
@@ -104,7 +104,7 @@ masterWrite::Num(const int& I)
     \return formated number
   */
 {
-  return (FMTinteger % I).str();
+  return (boost::format(FMTinteger) % I).str();
 }
 
 std::string
@@ -119,7 +119,7 @@ masterWrite::Num(const Geometry::Vec3D& V)
   for(int i=0;i<3;i++)
     {
       Out +=(fabs(V[i])<zeroTol) ? "0.0" :
-	(FMTdouble % V[i]).str();
+	(boost::format(FMTdouble) % V[i]).str();
       if (i!=2) Out+=" ";
     }
   return Out;
@@ -137,7 +137,7 @@ masterWrite::NumComma(const Geometry::Vec3D& V)
   for(int i=0;i<3;i++)
     {
       Out +=(fabs(V[i])<zeroTol) ? "0.0" :
-	(FMTdouble % V[i]).str();
+	(boost::format(FMTdouble) % V[i]).str();
       if (i!=2) Out+=",";
     }
   return Out;
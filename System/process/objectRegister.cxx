@@ -172,7 +172,7 @@ objectRegister::inRange(const int Index) const
     \return string
    */
 {
-  static std::string prev;
+  static thread_local std::string prev;
   
   MTYPE::const_iterator mc;
   mc=regionMap.find(prev);
@@ -518,7 +518,7 @@ objectRegister::inRenumberRange(const int Index) const
     \return string of object
    */
 {
-  static std::string prev;
+  static thread_local std::string prev;
   
   MTYPE::const_iterator mc;
   // normally same as previous search
@@ -172,7 +172,7 @@ equalSurface(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  return FTYPE::dispatch(Index,SPtr,SurI.equalCandidates(SPtr));
 }
 
 Geometry::Surface*
@@ -194,7 +194,7 @@ equalSurface(Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  return FTYPE::dispatch(Index,SPtr,SurI.equalCandidates(SPtr));
 }
 
 
@@ -205,7 +205,7 @@ EqualSurf(SurfType surf,const SMAP& SurMap)
     Helper function to determine if the surface object
     is similar to any we currently have
     \param surf : Surface to find [Ptr]
-    \param SurMap :: surface map to objects
+    \param SurMap :: surface map to objects [or the hash candidates]
     \returns Surface Ptr (either new/old)
   */
 {
@@ -244,7 +244,8 @@ equalSurfNum(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  const Geometry::Surface* OutPtr=FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  const Geometry::Surface* OutPtr=
+    FTYPE::dispatch(Index,SPtr,SurI.equalCandidates(SPtr));
   return OutPtr->getName();
 }
 
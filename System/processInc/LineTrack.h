@@ -64,6 +64,7 @@ class LineTrack
   bool updateDistance(MonteCarlo::Object*,
 		      const Geometry::Surface*,
 		      const int,const double);
+  double getAttnItem(const std::vector<double>&,const size_t) const;
 
  public:
 
@@ -77,7 +78,7 @@ class LineTrack
   /// Determine if track is complete 
   bool isCompelete() const { return (aimDist-TDist) < -Geometry::zeroTol; }
 
-  void calculate(const Simulation&);
+  void calculate(const Simulation&,const double =-1.0);
   void calculateError(const Simulation&);
   /// Access Cells
   const std::vector<long int>& getCells() const
@@ -102,6 +103,7 @@ class LineTrack
   /// access total distance
   double getTotalDist() const { return aimDist; }
 
+  double getAttnSum() const;
   void createAttenPath(std::vector<long int>&,std::vector<double>&) const;
   void write(std::ostream&) const;
 };
@@ -0,0 +1,102 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/ObjBoxIndex.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_ObjBoxIndex_h
+#define ModelSupport_ObjBoxIndex_h
+
+namespace MonteCarlo
+{
+  class Object;
+  class Qhull;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class ObjBoxIndex
+  \version 1.0
+  \author S. Ansell
+  \date January 2018
+  \brief Bounding volume tree of cell boxes for point location
+
+  Each cell is given a conservative box from its HeadRule.
+  Finite boxes are held in a binary tree, cells that cannot be
+  bounded are always tested. The index is only enabled after
+  populateCells and is rebuilt when the cell list or any
+  cell rule changes.
+*/
+
+class ObjBoxIndex
+{
+ private:
+
+  /// Tree node
+  struct BoxNode
+  {
+    Geometry::BoundBox Box;    ///< Box of all items below node
+    size_t left;               ///< Left child [0 if leaf]
+    size_t right;              ///< Right child
+    size_t first;              ///< First item in leaf
+    size_t count;              ///< Number of items in leaf
+  };
+
+  static const size_t leafSize=4;     ///< Max items in a leaf
+  static const double boxPad;         ///< Padding on each cell box
+
+  bool active;                  ///< Index allowed [populated]
+  bool built;                   ///< Tree has been built
+  size_t buildChange;           ///< Object rule change count at build
+
+  std::vector<MonteCarlo::Object*> Cells;     ///< Cells in OList order
+  std::vector<Geometry::BoundBox> CellBox;    ///< Box of each cell
+  std::vector<size_t> Items;                  ///< Tree order of finite cells
+  std::vector<size_t> OpenItems;              ///< Unbounded cells [sorted]
+  std::vector<BoxNode> Nodes;                 ///< Tree nodes [0 is root]
+
+  size_t buildNode(const size_t,const size_t);
+  void findCandidates(const Geometry::Vec3D&,std::vector<size_t>&) const;
+
+ public:
+
+  ObjBoxIndex();
+  ObjBoxIndex(const ObjBoxIndex&);
+  ObjBoxIndex& operator=(const ObjBoxIndex&);
+  ~ObjBoxIndex() {}          ///< Destructor
+
+  /// Is the index allowed
+  bool isActive() const { return active; }
+  bool isBuilt() const;
+
+  void setActive();
+  void reset();
+  void clearAll();
+  void build(const std::map<int,MonteCarlo::Qhull*>&);
+
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&) const;
+  /// Number of cells that must be always tested
+  size_t nOpen() const { return OpenItems.size(); }
+
+};
+
+}
+
+#endif
@@ -69,7 +69,8 @@ class ObjectTrackPoint : public ObjectTrackAct
   /// Set target point
   void setTarget(const Geometry::Vec3D& Pt) { TargetPt=Pt; }
 
-  void addUnit(const Simulation&,const long int,const Geometry::Vec3D&);
+  void addUnit(const Simulation&,const long int,
+	       const Geometry::Vec3D&,const double =-1.0);
 
   /// Debug function effectivley
   //  const std::map<int,ObjTrackItem>& getMap() const { return Items; }
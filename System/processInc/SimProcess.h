@@ -38,6 +38,7 @@ namespace SimProcess
 
   void writeMany(Simulation&,const std::string&,const int);
   void writeIndexSim(Simulation&,const std::string&,const int);
+  void writeMultiSim(Simulation&,const std::string&,const int);
   void writeIndexSimPHITS(Simulation&,const std::string&,const int);
 
   template<typename T>
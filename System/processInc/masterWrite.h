@@ -28,6 +28,9 @@
   \date February 2011
   \author S. Ansell
   \brief Controls the tolerance of output
+
+  The formats are copied on use so that the surfaces and cells
+  can be written from several threads.
 */
 
 class masterWrite
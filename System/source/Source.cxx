@@ -312,6 +312,28 @@ Source::substituteSurface(const int originalSurface,const int newSurface)
   return;
 }
 
+void
+Source::substituteSurface(const std::map<int,int>& RMap)
+  /*!
+    Substitute the surface from a map of old:new surfaces.
+    The surface is changed at most once.
+    \param RMap :: Map of old surface : new surface
+  */
+{
+  sdMapTYPE::iterator mc=sdMap.find("sur");
+  if (mc!=sdMap.end()) 
+    {
+      SrcItem<int>* SI=dynamic_cast< SrcItem<int>* >(mc->second.get());
+      if (SI && SI->isData())
+	{
+	  std::map<int,int>::const_iterator rc=RMap.find(SI->getData());
+	  if (rc!=RMap.end())
+	    SI->setValue(rc->second);
+	}
+    }
+  return;
+}
+
 int
 Source::rotateMaster()
   /*!
@@ -94,6 +94,7 @@ class Source
   void cutEnergy(const double);
   void substituteCell(const int,const int);
   void substituteSurface(const int,const int);
+  void substituteSurface(const std::map<int,int>&);
   void addComp(const std::string&,const SrcBase*);
   /// Set the transform number if needed
   void setTransform(Geometry::Transform* TP) { transPTR=TP; }
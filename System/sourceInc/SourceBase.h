@@ -79,6 +79,8 @@ class SourceBase
   
   /// No-op to substitue
   virtual void substituteSurface(const int,const int) {}
+  /// No-op to substitue [map of old:new]
+  virtual void substituteSurface(const std::map<int,int>&) {}
   /// No-op to rotate
   virtual void rotate(const localRotate&) { } 
   virtual void createSource(SDef::Source&) const =0;
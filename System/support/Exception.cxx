@@ -51,7 +51,9 @@ ExBase::ExBase(const int A,const std::string& Err) :
     \param A :: State variable
     \param Err :: Class:method string
   */
-{}
+{
+  ELog::RegMethod::startUnwind();
+}
 
 ExBase::ExBase(const std::string& Err) :
   std::exception(),state(0),ErrLn(Err),
@@ -60,7 +62,9 @@ ExBase::ExBase(const std::string& Err) :
     Constructor
     \param Err :: Class:method string
   */
-{ }
+{
+  ELog::RegMethod::startUnwind();
+}
 
 ExBase::ExBase(const ExBase& A) :
   std::exception(A),state(A.state),ErrLn(A.ErrLn),
@@ -94,12 +98,16 @@ const char*
 ExBase::what() const throw()
    /*!
      Write out the code position using the RegMethod system
-     Note the used of a static string since exception is cleared later
+     Note the used of a static string since exception is cleared later.
+     With tracing off the frames unwound by the throw are added.
      \return const char* to the string 
    */ 
 {
   static std::string Item;
   Item=OutLine+"\nCode Stack:\n"+CodeLocation+"\n";
+  const std::string UStack=ELog::RegMethod::getUnwind();
+  if (!UStack.empty())
+    Item+="Unwound Stack:\n"+UStack+"\n";
   return Item.c_str();
 }
 
@@ -1387,7 +1395,9 @@ ExitAbort::ExitAbort(const std::string& Err,const int flag) :
     \param Err :: Class:method string
     \param flag :: Extract a full calling path info 
   */
-{ }
+{
+  ELog::RegMethod::startUnwind();
+}
 
 ExitAbort::ExitAbort(const ExitAbort& A) :
   std::exception(A),fullPath(A.fullPath),
@@ -1427,6 +1437,9 @@ ExitAbort::what() const throw()
 
   Item=OutLine+
     "\nExit Stack:\n"+CodeLocation;
+  const std::string UStack=ELog::RegMethod::getUnwind();
+  if (!UStack.empty())
+    Item+="\nUnwound Stack:\n"+UStack;
   return Item.c_str();
 }
 
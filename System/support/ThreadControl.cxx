@@ -0,0 +1,163 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   support/ThreadControl.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+#include "Exception.h"
+#include "ThreadControl.h"
+
+namespace ModelSupport
+{
+
+size_t ThreadControl::nThread(1);
+
+void
+ThreadControl::setThreads(const size_t N)
+  /*!
+    Set the number of threads
+    \param N :: Number of threads [0 : hardware count]
+  */
+{
+  if (N)
+    nThread=N;
+  else
+    {
+      const size_t NHard(std::thread::hardware_concurrency());
+      nThread=(NHard) ? NHard : 1;
+    }
+  return;
+}
+
+void
+ThreadControl::runBlocks(const size_t NItems,const BlockFunc& Func)
+  /*!
+    Run a loop over the threads with the default block size
+    [about 16 blocks per thread]
+    \param NItems :: Number of indexes
+    \param Func :: Function to call on each block [start,end)
+  */
+{
+  const size_t blockSize=std::max<size_t>(1,NItems/(16*nThread));
+  runBlocks(NItems,blockSize,Func);
+  return;
+}
+
+void
+ThreadControl::runBlocks(const size_t NItems,const size_t blockSize,
+			 const BlockFunc& Func)
+  /*!
+    Run a loop of NItems over the threads. The blocks are
+    taken in order by each free thread. The first exception 
+    (by block order) is re-thrown after all the threads finish.
+    \param NItems :: Number of indexes
+    \param blockSize :: Number of items in a block
+    \param Func :: Function to call on each block [start,end)
+  */
+{
+  if (!blockSize)
+    throw ColErr::EmptyValue<size_t>("blockSize");
+  
+  const size_t NBlock((NItems+blockSize-1)/blockSize);
+  const size_t NT(std::min(nThread,NBlock));
+  if (NT<=1)
+    {
+      if (NItems)
+	Func(0,NItems);
+      return;
+    }
+
+  std::atomic<size_t> nextBlock(0);
+  std::vector<std::exception_ptr> Error(NBlock);
+  
+  auto worker=[&]()
+    {
+      size_t index;
+      while((index=nextBlock++)<NBlock)
+	{
+	  const size_t start(index*blockSize);
+	  try
+	    {
+	      Func(start,std::min(start+blockSize,NItems));
+	    }
+	  catch(...)
+	    {
+	      Error[index]=std::current_exception();
+	    }
+	}
+    };
+
+  std::vector<std::thread> Workers;
+  for(size_t i=1;i<NT;i++)
+    Workers.push_back(std::thread(worker));
+  worker();
+  for(std::thread& T : Workers)
+    T.join();
+
+  for(const std::exception_ptr& EPtr : Error)
+    if (EPtr)
+      std::rethrow_exception(EPtr);
+  return;
+}
+
+void
+ThreadControl::writeBlocks(std::ostream& OX,const size_t NItems,
+			   const WriteFunc& Func)
+  /*!
+    Write NItems to a stream. Each block of items is formatted
+    (over the threads) into a string buffer with the format
+    state of OX, and the buffers are written in item order.
+    The output is the same as writing each item in turn to OX
+    provided that an item does not change the stream format.
+    \param OX :: Output stream
+    \param NItems :: Number of items
+    \param Func :: Function to write item [index] to a stream
+  */
+{
+  const size_t NBlock((NItems+writeBlock-1)/writeBlock);
+  std::vector<std::string> Buffer(NBlock);
+  runBlocks(NBlock,1,
+	    [&](const size_t first,const size_t last)
+	    {
+	      for(size_t index=first;index<last;index++)
+		{
+		  std::ostringstream cx;
+		  cx.copyfmt(OX);
+		  const size_t endItem(std::min(NItems,(index+1)*writeBlock));
+		  for(size_t i=index*writeBlock;i<endItem;i++)
+		    Func(i,cx);
+		  Buffer[index]=cx.str();
+		}
+	    });
+
+  for(const std::string& Unit : Buffer)
+    OX.write(Unit.data(),static_cast<std::streamsize>(Unit.size()));
+  return;
+}
+
+}  // NAMESPACE ModelSupport
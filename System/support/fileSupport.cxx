@@ -22,6 +22,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <sstream>
@@ -33,6 +34,9 @@
 #include <string>
 #include <algorithm>
 #include <functional>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -429,6 +433,146 @@ writeStream(const std::string& Fname,const std::string& Title,
   return 0;
 }
 
+template<typename T>
+void
+writeBinary(std::ostream& OX,const T& Value)
+  /*!
+    Write a plain value as raw bytes [native byte order]
+    \param OX :: Binary output stream
+    \param Value :: Value to write
+  */
+{
+  OX.write(reinterpret_cast<const char*>(&Value),sizeof(T));
+  return;
+}
+
+template<>
+void
+writeBinary(std::ostream& OX,const std::string& Value)
+  /*!
+    Write a string as length + characters
+    \param OX :: Binary output stream
+    \param Value :: String to write
+  */
+{
+  writeBinary(OX,Value.size());
+  OX.write(Value.data(),static_cast<std::streamsize>(Value.size()));
+  return;
+}
+
+template<typename T>
+bool
+readBinary(std::istream& IX,T& Value)
+  /*!
+    Read a plain value written by writeBinary
+    \param IX :: Binary input stream
+    \param Value :: Value to set
+    \return true on success
+  */
+{
+  IX.read(reinterpret_cast<char*>(&Value),sizeof(T));
+  return IX.good();
+}
+
+template<>
+bool
+readBinary(std::istream& IX,std::string& Value)
+  /*!
+    Read a string written by writeBinary
+    \param IX :: Binary input stream
+    \param Value :: String to set
+    \return true on success
+  */
+{
+  size_t N;
+  if (!readBinarySize(IX,N,1))
+    return 0;
+  Value.resize(N);
+  if (N)
+    IX.read(&Value[0],static_cast<std::streamsize>(N));
+  return IX.good();
+}
+
+bool
+readBinarySize(std::istream& IX,size_t& N,const size_t unitSize)
+  /*!
+    Read an item count written by writeBinary and check that
+    the rest of the stream can hold N items of at least unitSize
+    bytes each. Stops a corrupt count from forcing a huge
+    allocation. Non-seekable streams are capped at 2^24 items.
+    \param IX :: Binary input stream
+    \param N :: Item count to set
+    \param unitSize :: Minimum bytes written per item
+    \return true on success
+  */
+{
+  if (!readBinary(IX,N)) return 0;
+
+  const std::streampos cur=IX.tellg();
+  if (cur<0)
+    return (N<=(1UL << 24));
+
+  IX.seekg(0,std::ios::end);
+  const std::streampos last=IX.tellg();
+  IX.seekg(cur);
+  if (last<cur || !IX.good()) return 0;
+
+  const size_t remain=static_cast<size_t>(last-cur);
+  return (N<=remain/std::max<size_t>(unitSize,1));
+}
+
+std::string
+tempFileName(const std::string& FName)
+  /*!
+    Name of a temporary file next to FName that is unique
+    to this process/thread. Used to write a file in full
+    before it is moved into place with replaceFile.
+    \param FName :: Final file name
+    \return temporary file name
+  */
+{
+  static std::atomic<size_t> count(0);
+
+  const size_t tick=static_cast<size_t>
+    (std::chrono::steady_clock::now().time_since_epoch().count());
+  const size_t tid=std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::ostringstream cx;
+  cx<<FName<<".tmp"<<std::hex<<(tick ^ tid)<<"_"<<count++;
+  return cx.str();
+}
+
+std::string
+tempPathName(const std::string& FName)
+  /*!
+    Unique temporary file name in the system temporary
+    directory [TMPDIR or /tmp] rather than the working directory
+    \param FName :: Base file name
+    \return temporary path
+  */
+{
+  const char* TDir=std::getenv("TMPDIR");
+  const std::string Dir((TDir && *TDir) ? TDir : "/tmp");
+  return tempFileName(Dir+"/"+FName);
+}
+
+int
+replaceFile(const std::string& TmpName,const std::string& FName)
+  /*!
+    Move a completed temporary file over FName. A reader 
+    of FName sees either the old file or the new file, never
+    a partial write. The temporary file is removed on failure.
+    \param TmpName :: Temporary file [from tempFileName]
+    \param FName :: Final file name
+    \return 0 on success / -1 on failure
+  */
+{
+  if (std::rename(TmpName.c_str(),FName.c_str()))
+    {
+      std::remove(TmpName.c_str());
+      return -1;
+    }
+  return 0;
+}
 
 /// \cond TEMPLATE 
 
@@ -462,6 +606,15 @@ template int writeStream(const std::string&,const std::string&,
 			 const std::vector<DError::doubleErr>&,
 			 const int);
 
+template void writeBinary(std::ostream&,const int&);
+template void writeBinary(std::ostream&,const size_t&);
+template void writeBinary(std::ostream&,const char&);
+template void writeBinary(std::ostream&,const double&);
+
+template bool readBinary(std::istream&,int&);
+template bool readBinary(std::istream&,size_t&);
+template bool readBinary(std::istream&,char&);
+template bool readBinary(std::istream&,double&);
 
 /// \endcond TEMPLATE 
 
@@ -265,3 +265,100 @@ solveCubic(const double A,const double B,
   AnsC=std::complex<double>(-(r13+termR),0.0);
   return 2;
 }
+
+size_t
+solveQuartic(const double* D,std::complex<double>* Ans)
+/*!
+  Solves Quartic equation
+  Iterator over all the coefficients in the order
+  \f[ Ax^4+Bx^3+Cx^2+Dx+E \f].
+  \param D :: Parameters x^4 to const
+  \param Ans :: complex roots of the equation [size 4]
+  \return number of solutions 
+*/
+{
+  return solveQuartic(D[0],D[1],D[2],D[3],D[4],Ans);
+}
+
+size_t
+solveQuartic(const double A,const double B,const double C,
+	     const double D,const double E,std::complex<double>* Ans)
+  /*!
+    Solves Quartic equation of type
+    \f$ ax^4+bx^3+cx^2+dx+e=0 \f$
+    by Ferrari's method. The equation is reduced to 
+    \f$ y^4+py^2+qy+r=0 \f$ [x=y-b/4a] and a real root, m, of the 
+    resolvent cubic \f$ 8m^3+8pm^2+(2p^2-8r)m-q^2=0 \f$ 
+    splits it into two quadratics :
+    \f$ y^2 \pm sy + p/2+m \mp q/2s \f$ with \f$ s=\sqrt{2m} \f$
+    The depressed quartic is scaled by the root size
+    \f$ L=\max(|p|^{1/2},|q|^{1/3},|r|^{1/4}) \f$ so that
+    all the tolerances are relative.
+    \param A :: x^4 value
+    \param B :: x^3 value
+    \param C :: x^2 value
+    \param D :: x value
+    \param E :: const value
+    \param Ans :: complex roots of the equation [size 4]
+    \return number of solutions 
+  */
+{
+  if (std::abs(A)<1e-30)
+    return solveCubic(B,C,D,E,Ans[0],Ans[1],Ans[2]);
+
+  const double b = B/A;
+  const double c = C/A;
+  const double d = D/A;
+  const double e = E/A;
+
+  const double b2(b*b);
+  const double pU = c-3.0*b2/8.0;
+  const double qU = d-b*c/2.0+b2*b/8.0;
+  const double rU = e-b*d/4.0+b2*c/16.0-3.0*b2*b2/256.0;
+  const double shift(-b/4.0);
+  const double L=std::max(std::max(std::sqrt(std::abs(pU)),
+				   std::cbrt(std::abs(qU))),
+			  std::sqrt(std::sqrt(std::abs(rU))));
+  if (L<=0.0)                // four roots at the shift
+    {
+      for(size_t i=0;i<4;i++)
+	Ans[i]=std::complex<double>(shift,0.0);
+      return 4;
+    }
+  // unit scale : y=Lu
+  const double p(pU/(L*L));
+  const double q(qU/(L*L*L));
+  const double r(rU/(L*L*L*L));
+
+  if (std::abs(q)<=1e-13)   // biquadratic : z=u^2
+    {
+      std::complex<double> ZA,ZB;
+      if (solveQuadratic(1.0,p,r,ZA,ZB)==1) ZB=ZA;
+      const std::complex<double> YA=L*std::sqrt(ZA);
+      const std::complex<double> YB=L*std::sqrt(ZB);
+      Ans[0]=YA+shift;
+      Ans[1]=-YA+shift;
+      Ans[2]=YB+shift;
+      Ans[3]=-YB+shift;
+      return 4;
+    }
+
+  // Largest real root of the resolvent is positive (q!=0).
+  // For m<1 the resolvent is below 26m-q^2 so the root
+  // is at least q^2/26 : this keeps q/2s below 2
+  std::complex<double> MA,MB,MC;
+  solveCubic(8.0,8.0*p,2.0*p*p-8.0*r,-q*q,MA,MB,MC);
+  double m(MA.real());
+  if (std::abs(MB.imag())<1e-13 && MB.real()>m) m=MB.real();
+  if (std::abs(MC.imag())<1e-13 && MC.real()>m) m=MC.real();
+  m=std::max(m,q*q/26.0);
+  
+  const double s=std::sqrt(2.0*m);
+  const size_t NA=solveQuadratic(1.0,-s,p/2.0+m+q/(2.0*s),Ans[0],Ans[1]);
+  const size_t NB=solveQuadratic(1.0,s,p/2.0+m-q/(2.0*s),Ans[2],Ans[3]);
+  if (NA==1) Ans[1]=Ans[0];
+  if (NB==1) Ans[3]=Ans[2];
+  for(size_t i=0;i<4;i++)
+    Ans[i]=L*Ans[i]+shift;
+  return 4;
+}
@@ -0,0 +1,69 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   supportInc/ThreadControl.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_ThreadControl_h
+#define ModelSupport_ThreadControl_h
+
+namespace ModelSupport
+{
+
+/*!
+  \class ThreadControl
+  \version 1.0
+  \author S. Ansell
+  \date January 2018
+  \brief Runs independent loop blocks over a set of threads
+
+  The index range is split into fixed blocks that the threads
+  take in turn. Each index must write only to its own output so
+  the result does not depend on the thread count. Any reduction
+  is done by the caller in index order after the loop. 
+  The threads only exist for the length of the call, so thread
+  local caches (SimTrack/NameStack) do not outlive it.
+*/
+
+class ThreadControl
+{
+ private:
+
+  static size_t nThread;        ///< Number of threads [1 : serial]
+
+ public:
+
+  /// Block function [start,end)
+  typedef std::function<void(const size_t,const size_t)> BlockFunc;
+  /// Item write function [index,stream]
+  typedef std::function<void(const size_t,std::ostream&)> WriteFunc;
+
+  static const size_t writeBlock=256;   ///< Items in a write buffer
+
+  static void setThreads(const size_t);
+  /// Number of threads in use
+  static size_t getThreads() { return nThread; }
+
+  static void runBlocks(const size_t,const BlockFunc&);
+  static void runBlocks(const size_t,const size_t,const BlockFunc&);
+  static void writeBlocks(std::ostream&,const size_t,const WriteFunc&);
+};
+
+}
+
+#endif
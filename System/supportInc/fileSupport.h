@@ -50,6 +50,21 @@ int writeStream(const std::string&,const std::string&,
 		const std::vector<T>&,const std::vector<U>&,
 		const int);
 
+template<typename T>
+void writeBinary(std::ostream&,const T&);
+template<typename T>
+bool readBinary(std::istream&,T&);
+
+template<>
+void writeBinary(std::ostream&,const std::string&);
+template<>
+bool readBinary(std::istream&,std::string&);
+bool readBinarySize(std::istream&,size_t&,const size_t);
+
+std::string tempFileName(const std::string&);
+std::string tempPathName(const std::string&);
+int replaceFile(const std::string&,const std::string&);
+
 }  // NAMESPACE StrFunc
 
 #endif
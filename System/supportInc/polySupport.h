@@ -58,7 +58,14 @@ solveCubic(const double,const double,const double,
 	   const double,std::complex<double>&,
 	   std::complex<double>&,std::complex<double>&);
 
+/// Solve a Quartic equation
 
+size_t 
+solveQuartic(const double*,std::complex<double>*);
+
+size_t 
+solveQuartic(const double,const double,const double,
+	     const double,const double,std::complex<double>*);
 
 #endif
 
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <complex>
 #include <cmath>
+#include <cstdlib>
 #include <string>
 #include <list>
 #include <map>
@@ -526,6 +527,101 @@ Tally::setCinderEnergy(const std::string&)
   return;
 }
 
+std::vector<std::pair<int,int>>
+Tally::renumberSequence(const std::map<int,int>& RMap)
+  /*!
+    Order the [one-to-one] renumber map so that applying the
+    pairs in turn changes each item once. A pair a->b is only
+    applied after b has been renumbered itself. A cycle 
+    [a->b ... ->a] is broken by moving a to a number outside the
+    map and onto its final number at the end of the cycle.
+    \param RMap :: Map of old number : new number
+    \return pairs in the order to apply
+  */
+{
+  std::vector<std::pair<int,int>> Out;
+
+  // pending : old->new and new->old
+  std::map<int,int> Pend;
+  std::map<int,int> Rev;
+  int maxAbs(0);
+  for(const std::map<int,int>::value_type& RItem : RMap)
+    if (RItem.first!=RItem.second)
+      {
+	Pend.emplace(RItem.first,RItem.second);
+	Rev.emplace(RItem.second,RItem.first);
+	maxAbs=std::max(maxAbs,std::max(std::abs(RItem.first),
+					std::abs(RItem.second)));
+      }
+
+  // a->b is ready if b is not waiting to be renumbered 
+  std::vector<int> Ready;
+  for(const std::map<int,int>::value_type& PItem : Pend)
+    if (Pend.find(PItem.second)==Pend.end())
+      Ready.push_back(PItem.first);
+
+  // temporary numbers : far outside any cell/surface number
+  int tmpNum(std::min(-maxAbs-1,-(1 << 30)));
+  while(!Pend.empty())
+    {
+      if (Ready.empty())        // only cycles left
+	{
+	  std::map<int,int>::iterator mc=Pend.begin();
+	  const int A(mc->first);
+	  const int B(mc->second);
+	  Out.push_back(std::pair<int,int>(A,tmpNum));
+	  Pend.erase(mc);
+	  Rev.erase(B);
+	  Pend.emplace(tmpNum,B);
+	  Rev.emplace(B,tmpNum);
+	  std::map<int,int>::const_iterator rc=Rev.find(A);
+	  if (rc!=Rev.end())
+	    Ready.push_back(rc->second);
+	  tmpNum--;
+	  continue;
+	}
+      const int A(Ready.back());
+      Ready.pop_back();
+      std::map<int,int>::iterator mc=Pend.find(A);
+      Out.push_back(std::pair<int,int>(A,mc->second));
+      Rev.erase(mc->second);
+      Pend.erase(mc);
+      // anything moving onto A can now go
+      std::map<int,int>::const_iterator rc=Rev.find(A);
+      if (rc!=Rev.end())
+	Ready.push_back(rc->second);
+    }
+  return Out;
+}
+
+void
+Tally::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the cells in the map. Default is to
+    use the single cell renumber in an order that changes
+    each cell once.
+    \param RMap :: Map of old cell : new cell
+  */
+{
+  for(const std::pair<int,int>& RItem : renumberSequence(RMap))
+    renumberCell(RItem.first,RItem.second);
+  return;
+}
+
+void
+Tally::renumberSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in the map. Default is to
+    use the single surface renumber in an order that changes
+    each surface once.
+    \param RMap :: Map of old surface : new surface
+  */
+{
+  for(const std::pair<int,int>& RItem : renumberSequence(RMap))
+    renumberSurf(RItem.first,RItem.second);
+  return;
+}
+
 int
 Tally::addLine(const std::string& LX)
   /*!
@@ -214,6 +214,17 @@ cellFluxTally::renumberCell(const int oldCell,const int newCell)
   return;
 }
 
+void
+cellFluxTally::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumbers all the cells in the map from the active list
+    \param RMap :: Map of old cell : new cell
+  */
+{
+  cellList.changeItem(RMap);
+  return;
+}
+
 int
 cellFluxTally::mergeTally(const Tally& CT)
   /*!
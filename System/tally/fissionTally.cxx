@@ -199,6 +199,17 @@ fissionTally::renumberCell(const int oldCell,const int newCell)
   return;
 }
 
+void
+fissionTally::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumbers all the cells in the map from the active list
+    \param RMap :: Map of old cell : new cell
+  */
+{
+  cellList.changeItem(RMap);
+  return;
+}
+
 int
 fissionTally::makeSingle()
   /*!
@@ -182,6 +182,17 @@ heatTally::renumberCell(const int oldN,const int newN)
   return;
 }
 
+void
+heatTally::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumbers all the cells in the map from the active list
+    \param RMap :: Map of old cell : new cell
+  */
+{
+  cellList.changeItem(RMap);
+  return;
+}
+
 void
 heatTally::write(std::ostream& OX)  const
   /*!
@@ -147,6 +147,24 @@ sswTally::renumberSurf(const int oldN,const int newN)
   return;
 }
 
+void
+sswTally::renumberSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in the map [sign kept]
+    \param RMap :: Map of old surface : new surface
+  */
+{
+  ELog::RegMethod RegA("ssWTally","renumberSurf(map)");
+
+  for(int& SN : surfList)
+    {
+      const std::map<int,int>::const_iterator mc=RMap.find(std::abs(SN));
+      if (mc!=RMap.end())
+	SN=(SN>0) ? mc->second : -mc->second;
+    }
+  return;
+}
+
 void
 sswTally::write(std::ostream& OX) const
   /*!
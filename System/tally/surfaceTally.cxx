@@ -260,6 +260,39 @@ surfaceTally::renumberSurf(const int oldN,const int newN)
 		  -newN);
   return;
 }
+
+void
+surfaceTally::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the cells in the map
+    \param RMap :: Map of old cell : new cell
+   */
+{
+  ELog::RegMethod RegA("surfaceTally","renumberCell(map)");
+  CellFlag.changeItem(RMap);
+  return;
+}
+
+void
+surfaceTally::renumberSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in the map [sign kept]
+    \param RMap :: Map of old surface : new surface
+   */
+{
+  ELog::RegMethod RegA("surfaceTally","renumberSurf(map)");
+
+  SurfFlag.changeItem(RMap);
+
+  for(std::vector<int>* VPtr : {&SurfList,&FSfield})
+    for(int& SN : *VPtr)
+      {
+	const std::map<int,int>::const_iterator mc=RMap.find(std::abs(SN));
+	if (mc!=RMap.end())
+	  SN=(SN>0) ? mc->second : -mc->second;
+      }
+  return;
+}
   
 
 void
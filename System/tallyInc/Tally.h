@@ -60,6 +60,8 @@ class Tally
   void writeParticles(std::ostream&) const;
   void writeFields(std::ostream&) const;
   int processParticles(std::string&);
+  static std::vector<std::pair<int,int>>
+    renumberSequence(const std::map<int,int>&);
   
  public:
   
@@ -112,6 +114,8 @@ class Tally
   virtual void renumberCell(const int,const int) {}
   /// Renumber [not normally required]
   virtual void renumberSurf(const int,const int) {}
+  virtual void renumberCell(const std::map<int,int>&);
+  virtual void renumberSurf(const std::map<int,int>&);
   /// make a group sum into single units
   virtual int makeSingle() { return 0; }
 
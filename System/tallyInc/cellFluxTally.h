@@ -61,6 +61,7 @@ class cellFluxTally : public Tally
   
   virtual int addLine(const std::string&); 
   virtual void renumberCell(const int,const int);
+  virtual void renumberCell(const std::map<int,int>&);
   virtual int makeSingle();
   void writeHTape(const std::string&,const std::string&) const;
   virtual void write(std::ostream&) const;
@@ -57,6 +57,7 @@ class fissionTally : public Tally
 
   virtual int addLine(const std::string&); 
   virtual void renumberCell(const int,const int);
+  virtual void renumberCell(const std::map<int,int>&);
   virtual int makeSingle();
   virtual void write(std::ostream&) const;
   
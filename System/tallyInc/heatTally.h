@@ -55,6 +55,7 @@ class heatTally : public Tally
   void setPlus(const int V) { plus=V; } ///< Set the + flag
   
   virtual void renumberCell(const int,const int);
+  virtual void renumberCell(const std::map<int,int>&);
   virtual int addLine(const std::string&); 
   virtual void write(std::ostream&) const;
   
@@ -51,6 +51,7 @@ class sswTally : public Tally
 
   void addSurfaces(const std::vector<int>&);
   virtual void renumberSurf(const int,const int);
+  virtual void renumberSurf(const std::map<int,int>&);
 
   virtual void write(std::ostream&) const;
 };
@@ -65,6 +65,8 @@ class surfaceTally : public Tally
     
     virtual void renumberCell(const int,const int);
     virtual void renumberSurf(const int,const int);
+    virtual void renumberCell(const std::map<int,int>&);
+    virtual void renumberSurf(const std::map<int,int>&);
 
     virtual void write(std::ostream&) const;
     
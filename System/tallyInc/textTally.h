@@ -53,6 +53,10 @@ class textTally : public Tally
       { return Lines; }
     virtual void renumberCell(const int,const int);
     virtual void renumberSurf(const int,const int);
+    /// No cells to renumber
+    virtual void renumberCell(const std::map<int,int>&) {}
+    /// No surfaces to renumber
+    virtual void renumberSurf(const std::map<int,int>&) {}
     
     virtual void write(std::ostream&) const;      
   };
@@ -30,6 +30,10 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <cstdint>
 #include <boost/format.hpp>
 #include <boost/multi_array.hpp>
 
@@ -61,17 +65,19 @@
 #include "SimProcess.h"
 #include "SurInter.h"
 #include "Simulation.h"
+#include "LineTrack.h"
 #include "Visit.h"
+#include "ThreadControl.h"
 
 Visit::Visit() :
-  outType(VISITenum::cellID),nPts(0,0,0)
+  outType(VISITenum::cellID),lineFlag(0),nPts(0,0,0)
   /*!
     Constructor
   */
 {}
 
 Visit::Visit(const Visit& A) : 
-  outType(A.outType),Origin(A.Origin),
+  outType(A.outType),lineFlag(A.lineFlag),Origin(A.Origin),
   XYZ(A.XYZ),nPts(A.nPts),mesh(A.mesh)
   /*!
     Copy constructor
@@ -90,6 +96,7 @@ Visit::operator=(const Visit& A)
   if (this!=&A)
     {
       outType=A.outType;
+      lineFlag=A.lineFlag;
       Origin=A.Origin;
       XYZ=A.XYZ;
       nPts=A.nPts;
@@ -121,8 +128,8 @@ Visit::setBox(const Geometry::Vec3D& startPt,
 void
 Visit::setIndex(const size_t A,const size_t B,const size_t C)
   /*!
-    Set the index values , checks to ensure that 
-    they are greater than zero
+    Set the index values. The mesh is only sized by 
+    populate [not needed for the binary stream]
     \param A :: Xcoordinate division
     \param B :: Ycoordinate division
     \param C :: Zcoordinate division
@@ -131,7 +138,18 @@ Visit::setIndex(const size_t A,const size_t B,const size_t C)
   nPts=Triple<long int>(static_cast<long int>(A),
 			static_cast<long int>(B),
 			static_cast<long int>(C));
-  mesh.resize(boost::extents[nPts[0]][nPts[1]][nPts[2]]);
+  return;
+}
+
+void
+Visit::setLineForm(const bool A)
+  /*!
+    Set the row calculation to line tracking.
+    The Simulation ObjSurfMap must be built [createObjSurfMap]
+    \param A :: Track each row [false : test each point]
+  */
+{
+  lineFlag=A;
   return;
 }
 
@@ -170,63 +188,169 @@ Visit::getResult(const MonteCarlo::Object* ObjPtr) const
   return 0.0;
 }
 
+double
+Visit::getResult(const MonteCarlo::Object* ObjPtr,
+		 const std::set<std::string>& Active) const
+  /*!
+    Determine the result for an object if the object 
+    is in the active set
+    \param ObjPtr :: object to calculate for
+    \param Active :: Active set of cells to use (ranged) [empty for all]
+    \return determined value from the object
+  */
+{
+  if (Active.empty() || !ObjPtr)
+    return getResult(ObjPtr);
+
+  const ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
+  const std::string rangeStr=OR.inRange(ObjPtr->getName());
+  return (Active.find(rangeStr)!=Active.end()) ?
+    getResult(ObjPtr) : 0.0;
+}
+
 void
-Visit::populate(const Simulation* SimPtr,
-		const std::set<std::string>& Active)
+Visit::calcRow(const Simulation* SimPtr,
+	       const std::set<std::string>& Active,
+	       const Geometry::Vec3D& APt,const double stepX,
+	       double* Out) const
   /*!
-    The big population call
+    Calculate a row of x points by tracking a line from
+    the first to the last point. The cell only changes at 
+    the surface crossings. Points beyond the end of the 
+    track [unbounded cell] are found individually
     \param SimPtr :: Simulation system
     \param Active :: Active set of cells to use (ranged)
+    \param APt :: First point of the row
+    \param stepX :: Step between points
+    \param Out :: Output [nPts[0] values]
    */
 {
-  ELog::RegMethod RegA("Visit","populate(set)");
-
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
+  const Geometry::Vec3D BPt=
+    APt+Geometry::Vec3D(stepX*static_cast<double>(nPts[0]-1),0,0);
 
-  const ModelSupport::objectRegister& OR=
-    ModelSupport::objectRegister::Instance();
+  MonteCarlo::Object* ObjPtr=SimPtr->findCell(APt,0);
+  if (!ObjPtr || nPts[0]<2)
+    {
+      Out[0]=getResult(ObjPtr,Active);
+      for(long int i=1;i<nPts[0];i++)
+	{
+	  const Geometry::Vec3D Pt=
+	    APt+Geometry::Vec3D(stepX*static_cast<double>(i),0,0);
+	  ObjPtr=SimPtr->findCell(Pt,ObjPtr);
+	  Out[i]=getResult(ObjPtr,Active);
+	}
+      return;
+    }
   
-  const bool aEmptyFlag=Active.empty();
+  ModelSupport::LineTrack LT(APt,BPt);
+  LT.calculate(*SimPtr);
+  const std::vector<MonteCarlo::Object*>& OVec=LT.getObjVec();
+  const std::vector<double>& TVec=LT.getTrack();
+
+  // no track [unbounded start cell] : all points are found
+  size_t index(0);
+  double segEnd(TVec.empty() ? -1.0 : TVec[0]);
+  double segValue(OVec.empty() ? 0.0 : getResult(OVec[0],Active));
+  for(long int i=0;i<nPts[0];i++)
+    {
+      const double D(stepX*static_cast<double>(i));
+      while(D>=segEnd && index+1<TVec.size())
+	{
+	  index++;
+	  segEnd+=TVec[index];
+	  segValue=getResult(OVec[index],Active);
+	}
+      if (D<segEnd+Geometry::zeroTol)
+	Out[i]=segValue;
+      else
+	{
+	  const Geometry::Vec3D Pt=APt+Geometry::Vec3D(D,0,0);
+	  ObjPtr=SimPtr->findCell(Pt,ObjPtr);
+	  Out[i]=getResult(ObjPtr,Active);
+	}
+    }
+  return;
+}
 
+void
+Visit::calcSlab(const Simulation* SimPtr,
+		const std::set<std::string>& Active,
+		const long int kStart,const long int kEnd,
+		double* Out) const
+  /*!
+    Calculate the results of the z planes [kStart,kEnd).
+    Each slab keeps its own last cell found.
+    \param SimPtr :: Simulation system
+    \param Active :: Active set of cells to use (ranged)
+    \param kStart :: first z index
+    \param kEnd :: one past the last z index
+    \param Out :: Output [x fastest : VTK order]
+   */
+{
   double stepXYZ[3];
   for(size_t i=0;i<3;i++)
     stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
 
-  for(long int i=0;i<nPts[0];i++)
+  MonteCarlo::Object* ObjPtr(0);
+  Geometry::Vec3D aVec;
+  for(long int k=kStart;k<kEnd;k++)
     {
-      aVec[0]=stepXYZ[0]*(static_cast<double>(i)+0.5);
+      aVec[2]=stepXYZ[2]*(0.5+static_cast<double>(k));
       for(long int j=0;j<nPts[1];j++)
         {
 	  aVec[1]=stepXYZ[1]*(0.5+static_cast<double>(j));
-	  for(long int k=0;k<nPts[2];k++)
+	  if (lineFlag)
+	    {
+	      aVec[0]=stepXYZ[0]*0.5;
+	      calcRow(SimPtr,Active,Origin+aVec,stepXYZ[0],Out);
+	      Out+=nPts[0];
+	      continue;
+	    }
+	  for(long int i=0;i<nPts[0];i++)
 	    {
-	      aVec[2]=stepXYZ[2]*(0.5+static_cast<double>(k));
+	      aVec[0]=stepXYZ[0]*(static_cast<double>(i)+0.5);
 	      const Geometry::Vec3D Pt=Origin+aVec;
 	      ObjPtr=SimPtr->findCell(Pt,ObjPtr);
-
-	      // Active Set Code:
-	      if (!aEmptyFlag)
-		{
-
-		  const std::string rangeStr=OR.inRange(ObjPtr->getName());
-		  if (Active.find(rangeStr)!=Active.end())
-		    mesh[i][j][k]=getResult(ObjPtr);
-		  else
-		    mesh[i][j][k]=0.0;
-		}
-	      // OLD Code:
-	      else
-		{
-		  mesh[i][j][k]=getResult(ObjPtr);
-		}
-
+	      *Out++=getResult(ObjPtr,Active);
 	    }
 	}
     }
   return;
 }
 
+void
+Visit::populate(const Simulation* SimPtr,
+		const std::set<std::string>& Active)
+  /*!
+    The big population call. The z planes are 
+    split over the threads.
+    \param SimPtr :: Simulation system
+    \param Active :: Active set of cells to use (ranged)
+   */
+{
+  ELog::RegMethod RegA("Visit","populate(set)");
+
+  mesh.resize(boost::extents[nPts[0]][nPts[1]][nPts[2]]);
+  SimPtr->buildCellIndex();
+
+  const size_t NXY(static_cast<size_t>(nPts[0]*nPts[1]));
+  ModelSupport::ThreadControl::runBlocks
+    (static_cast<size_t>(nPts[2]),1,[&](const size_t A,const size_t B)
+     {
+       std::vector<double> Slab(NXY*(B-A));
+       calcSlab(SimPtr,Active,static_cast<long int>(A),
+		static_cast<long int>(B),Slab.data());
+       const double* SPtr=Slab.data();
+       for(long int k=static_cast<long int>(A);
+	   k<static_cast<long int>(B);k++)
+	 for(long int j=0;j<nPts[1];j++)
+	   for(long int i=0;i<nPts[0];i++)
+	     mesh[i][j][k]= *SPtr++;
+     });
+  return;
+}
+
 void
 Visit::populate(const Simulation* SimPtr)
   /*!
@@ -292,3 +416,99 @@ Visit::writeVTK(const std::string& FName) const
   OX.close();
   return;
 }
+
+void
+Visit::writeBinary(std::ostream& OX,const double* Data,const size_t N)
+  /*!
+    Write values as big-endian float [VTK legacy binary]
+    \param OX :: Output stream
+    \param Data :: Values to write
+    \param N :: Number of values
+  */
+{
+  const uint32_t testValue(1);
+  const bool swapFlag(*reinterpret_cast<const char*>(&testValue)==1);
+
+  std::vector<char> Buffer(4*N);
+  char* BPtr=Buffer.data();
+  for(size_t i=0;i<N;i++)
+    {
+      const float FValue(static_cast<float>(Data[i]));
+      char Item[4];
+      std::memcpy(Item,&FValue,4);
+      if (swapFlag)
+	{
+	  std::swap(Item[0],Item[3]);
+	  std::swap(Item[1],Item[2]);
+	}
+      std::memcpy(BPtr,Item,4);
+      BPtr+=4;
+    }
+  OX.write(Buffer.data(),static_cast<std::streamsize>(Buffer.size()));
+  return;
+}
+
+void
+Visit::writeBinaryVTK(const Simulation* SimPtr,
+		      const std::set<std::string>& Active,
+		      const std::string& FName) const
+  /*!
+    Calculate and write out a binary VTK file. A group of 
+    z planes is calculated over the threads and written
+    before the next group is started so the mesh is not held. 
+    \param SimPtr :: Simulation system
+    \param Active :: Active set of cells to use (ranged)
+    \param FName :: filename 
+  */
+{
+  ELog::RegMethod RegA("Visit","writeBinaryVTK");
+  
+  if (FName.empty()) return;
+  std::ofstream OX(FName.c_str(),std::ios::binary);
+  
+  double stepXYZ[3];
+  for(size_t i=0;i<3;i++)
+    stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
+  
+  OX<<"# vtk DataFile Version 2.0\n";
+  OX<<"chipIR Data\n";
+  OX<<"BINARY\n";
+  OX<<"DATASET RECTILINEAR_GRID\n";
+  OX<<"DIMENSIONS "<<nPts[0]<<" "<<nPts[1]<<" "<<nPts[2]<<"\n";
+  
+  const char* coordName[3]={"X","Y","Z"};
+  for(size_t index=0;index<3;index++)
+    {
+      std::vector<double> Coord(static_cast<size_t>(nPts[index]));
+      for(size_t i=0;i<Coord.size();i++)
+	Coord[i]=Origin[index]+stepXYZ[index]*(static_cast<double>(i)+0.5);
+      OX<<coordName[index]<<"_COORDINATES "<<nPts[index]<<" float\n";
+      writeBinary(OX,Coord.data(),Coord.size());
+      OX<<"\n";
+    }
+
+  OX<<"POINT_DATA "<<nPts[0]*nPts[1]*nPts[2]<<"\n";
+  OX<<"SCALARS cellID float 1\n";
+  OX<<"LOOKUP_TABLE default\n";
+
+  SimPtr->buildCellIndex();
+  const size_t NXY(static_cast<size_t>(nPts[0]*nPts[1]));
+  const size_t NZ(static_cast<size_t>(nPts[2]));
+  const size_t groupSize(ModelSupport::ThreadControl::getThreads());
+  std::vector<double> Slab;
+  for(size_t kStart=0;kStart<NZ;kStart+=groupSize)
+    {
+      const size_t kEnd(std::min(NZ,kStart+groupSize));
+      Slab.resize(NXY*(kEnd-kStart));
+      ModelSupport::ThreadControl::runBlocks
+	(kEnd-kStart,1,[&](const size_t A,const size_t B)
+	 {
+	   calcSlab(SimPtr,Active,static_cast<long int>(kStart+A),
+		    static_cast<long int>(kStart+B),&Slab[NXY*A]);
+	 });
+      writeBinary(OX,Slab.data(),Slab.size());
+    }
+  OX<<"\n";
+  OX.close();
+  return;
+}
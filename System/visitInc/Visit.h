@@ -34,10 +34,12 @@ class Object;
   \date August 2010
   \author S. Ansell
   \version 1.0
-  \todo Move to a binary/xml output schema
 
-  This allows comparison of the vector for removing non-unique
-  Vec3D from a list
+  The mesh is calculated in z-slabs over the threads. The
+  binary writer streams the slabs to the file as they are 
+  calculated so the full mesh is never held. In line form each
+  x row is a single track and the points between surface
+  crossings are filled from the track.
 */
 						
 class Visit
@@ -50,6 +52,7 @@ class Visit
  private:
   
   VISITenum outType;          ///< Output type
+  bool lineFlag;              ///< Track each x row
   Geometry::Vec3D Origin;     ///< Origin
   Geometry::Vec3D XYZ;        ///< XYZ extent
 
@@ -57,6 +60,13 @@ class Visit
   boost::multi_array<double,3> mesh;  ///< results mesh
 
   double getResult(const MonteCarlo::Object*) const;
+  double getResult(const MonteCarlo::Object*,
+		   const std::set<std::string>&) const;
+  void calcRow(const Simulation*,const std::set<std::string>&,
+	       const Geometry::Vec3D&,const double,double*) const;
+  void calcSlab(const Simulation*,const std::set<std::string>&,
+		const long int,const long int,double*) const;
+  static void writeBinary(std::ostream&,const double*,const size_t);
 
  public:
 
@@ -66,13 +76,18 @@ class Visit
   ~Visit();
 
   void setType(const VISITenum&);
+  void setLineForm(const bool);
   void setBox(const Geometry::Vec3D&,
               const Geometry::Vec3D&);
   void setIndex(const size_t,const size_t,const size_t);
+  /// Access results mesh [after populate]
+  const boost::multi_array<double,3>& getMesh() const { return mesh; }
 
   void populate(const Simulation*);
   void populate(const Simulation*,const std::set<std::string>&);
   void writeVTK(const std::string&) const;
+  void writeBinaryVTK(const Simulation*,const std::set<std::string>&,
+		      const std::string&) const;
 };
 
 
@@ -3,7 +3,7 @@
  
  * File:   weight/MarkovProcess.cxx
  *
- * Copyright (c) 2004-2017 by Stuart Ansell
+ * Copyright (c) 2004-2018 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -31,6 +31,8 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <limits>
+#include <functional>
 #include <boost/multi_array.hpp>
 
 #include "Exception.h"
@@ -67,21 +69,26 @@
 #include "WWG.h"
 
 #include "MarkovProcess.h"
+#include "ThreadControl.h"
 
 
 namespace WeightSystem
 {
 
 
-MarkovProcess::MarkovProcess()
+const double MarkovProcess::cutValue(-20.0);
+
+MarkovProcess::MarkovProcess() :
+  nIteration(0),WX(0),WY(0),WZ(0),WE(0),FSize(0)
  /*! 
     Constructor 
   */
 {}
 
 MarkovProcess::MarkovProcess(const MarkovProcess& A) : 
-  nIteration(A.nIteration),WX(A.WX),WY(A.WY),WZ(A.WZ),
-  FSize(A.FSize),fluxField(A.fluxField)
+  nIteration(A.nIteration),WX(A.WX),WY(A.WY),WZ(A.WZ),WE(A.WE),
+  FSize(A.FSize),rowIndex(A.rowIndex),colIndex(A.colIndex),
+  matValue(A.matValue),fluxField(A.fluxField),logScale(A.logScale)
   /*!
     Copy constructor
     \param A :: MarkovProcess to copy
@@ -102,8 +109,13 @@ MarkovProcess::operator=(const MarkovProcess& A)
       WX=A.WX;
       WY=A.WY;
       WZ=A.WZ;
+      WE=A.WE;
       FSize=A.FSize;
+      rowIndex=A.rowIndex;
+      colIndex=A.colIndex;
+      matValue=A.matValue;
       fluxField=A.fluxField;
+      logScale=A.logScale;
     }
   return *this;
 }
@@ -130,8 +142,13 @@ MarkovProcess::initializeData(const WWG& wSet)
   WZ=static_cast<long int>(grid.getZSize());
 
   FSize=WX*WY*WZ;
-  
-  fluxField.resize(boost::extents[FSize][FSize]);
+  nIteration=0;
+  WE=0;
+  rowIndex.clear();
+  colIndex.clear();
+  matValue.clear();
+  fluxField.clear();
+  logScale.clear();
   
   return;
 }
@@ -143,7 +160,12 @@ MarkovProcess::computeMatrix(const Simulation& System,
 			     const double r2Length,
 			     const double r2Power)
   /*!
-    Calculate the makov chain process
+    Calculate the makov chain process. Each row tracks 
+    the upper triangle [j>i] over the threads and the 
+    symmetric rows are then assembled in order.
+    As the attenuation is positive, pairs with 1/r^2 factor
+    below cutValue are not tracked and a track is stopped
+    once its attenuation takes WFactor below cutValue.
     \param System :: Simualation
     \param wSet :: WWG set for grid
     \param densityFactor :: Scaling factor for density
@@ -153,46 +175,194 @@ MarkovProcess::computeMatrix(const Simulation& System,
 {
   ELog::RegMethod RegA("MarkovProcess","computeMatrix");
 
-  const Geometry::Mesh3D& grid=wSet.getGrid();
-  const std::vector<Geometry::Vec3D> midPts=wSet.getMidPoints();
+  const std::vector<Geometry::Vec3D>& midPts=wSet.getMidPoints();
 
   if (static_cast<long int>(midPts.size())!=FSize)
     throw ColErr::MisMatch<long int>
       (static_cast<long int>(midPts.size()),FSize,"MidPts.size != FSize");
 
-  for(long int i=0;i<FSize;i++)
-    fluxField[i][i]=1.0;
+  const size_t NF(static_cast<size_t>(FSize));
+  std::vector<std::vector<size_t>> upperCol(NF);
+  std::vector<std::vector<double>> upperValue(NF);
 
-  for(long int i=0;i<FSize;i++)
+  System.buildCellIndex();
+  // early rows have the most tracks : keep the blocks small
+  const size_t blockSize=
+    std::max<size_t>(1,NF/(64*ModelSupport::ThreadControl::getThreads()));
+  ModelSupport::ThreadControl::runBlocks
+    (NF,blockSize,[&](const size_t A,const size_t B)
+     {
+       for(size_t uI=A;uI<B;uI++)
+	 {
+	   ModelSupport::ObjectTrackPoint OTrack(midPts[uI]); 
+	   for(size_t uJ=uI+1;uJ<NF;uJ++)
+	     {
+	       double DistT=midPts[uI].Distance(midPts[uJ])/r2Length;
+	       if (DistT<1.0) DistT=1.0;
+	       // WFactor with no material
+	       const double RFactor= -r2Power*log(DistT);
+	       if (RFactor<=cutValue) continue;
+	       const double maxAttn=(densityFactor>0.0) ?
+		 (RFactor-cutValue)/densityFactor : -1.0;
+
+	       // single unit : replaced by each track
+	       OTrack.addUnit(System,1,midPts[uJ],maxAttn);
+	       const double AT=OTrack.getAttnSum(1);
+	       const double WFactor=RFactor-densityFactor*AT;
+	       if (WFactor>cutValue)
+		 {
+		   upperCol[uI].push_back(uJ);
+		   upperValue[uI].push_back(exp(WFactor));
+		 }
+	     }
+	 }
+     });
+
+  // Row sizes : diagonal + upper + mirrored lower
+  rowIndex.assign(NF+1,0);
+  for(size_t i=0;i<NF;i++)
+    {
+      rowIndex[i+1]+=1+upperCol[i].size();
+      for(const size_t j : upperCol[i])
+	rowIndex[j+1]++;
+    }
+  for(size_t i=0;i<NF;i++)
+    rowIndex[i+1]+=rowIndex[i];
+
+  colIndex.resize(rowIndex[NF]);
+  matValue.resize(rowIndex[NF]);
+  // lower entries of row i are added by rows before i : columns sorted
+  std::vector<size_t> fillIndex(rowIndex.begin(),rowIndex.end()-1);
+  for(size_t i=0;i<NF;i++)
     {
-      const size_t uI(static_cast<size_t>(i));
-      ModelSupport::ObjectTrackPoint OTrack(midPts[uI]); 
-      for(long int j=i+1;j<FSize;j++)
+      colIndex[fillIndex[i]]=i;
+      matValue[fillIndex[i]++]=1.0;
+      for(size_t k=0;k<upperCol[i].size();k++)
 	{
-	  const size_t uJ(static_cast<size_t>(i));
-	  OTrack.addUnit(System,j,midPts[uJ]);
-	  double DistT=OTrack.getDistance(j)/r2Length;
-	  if (DistT<1.0) DistT=1.0;
-	  const double AT=OTrack.getAttnSum(j);  // this can take an
-	  const double WFactor= -densityFactor*AT-r2Power*log(DistT);
-	  if (WFactor>-20)
-	    fluxField[i][j]=fluxField[j][i]= -WFactor;
-	  else
-	    fluxField[i][j]=fluxField[j][i]=0.0;
+	  const size_t j=upperCol[i][k];
+	  colIndex[fillIndex[i]]=j;
+	  matValue[fillIndex[i]++]=upperValue[i][k];
+	  colIndex[fillIndex[j]]=i;
+	  matValue[fillIndex[j]++]=upperValue[i][k];
 	}
+      std::vector<size_t>().swap(upperCol[i]);
+      std::vector<double>().swap(upperValue[i]);
     }
+
+  ELog::EM<<"Markov matrix entries == "<<matValue.size()<<" of "
+	  <<NF*NF<<ELog::endDiag;
   return;
 }
 
 void
-MarkovProcess::multiplyOut(const size_t index)
+MarkovProcess::setFlux(const WWGWeight& wMesh)
+  /*!
+    Set the starting flux from a [log] weight mesh
+    \param wMesh :: Weight mesh to use
+   */
 {
+  ELog::RegMethod RegA("MarkovProcess","setFlux");
+
+  if (!wMesh.isSized(WX,WY,WZ,wMesh.getESize()))
+    throw ColErr::MisMatch<long int>
+      (wMesh.getXSize()*wMesh.getYSize()*wMesh.getZSize(),
+       FSize,"WWGWeight/Markov grid");
+
+  WE=wMesh.getESize();
+  const size_t NF(static_cast<size_t>(FSize));
+  const size_t NE(static_cast<size_t>(WE));
+  // [x,y,z,E] storage : E fastest
+  const double* WData=wMesh.getGrid().data();
+
+  logScale.assign(NE,-std::numeric_limits<double>::max());
+  for(size_t i=0;i<NF;i++)
+    for(size_t e=0;e<NE;e++)
+      logScale[e]=std::max(logScale[e],WData[i*NE+e]);
+
+  fluxField.resize(NF*NE);
+  for(size_t i=0;i<NF;i++)
+    for(size_t e=0;e<NE;e++)
+      fluxField[i*NE+e]=exp(WData[i*NE+e]-logScale[e]);
+  nIteration=0;
   return;
 }
 
 void
-MarkovProcess::rePopulateWWG() 
+MarkovProcess::multiplyOut(const size_t nMult)
+  /*!
+    Power iteration of the flux by the transfer matrix.
+    Each row is independent so the rows are split over 
+    the threads. The flux is rescaled to the original 
+    maximum of each energy bin after each step.
+    \param nMult :: Number of multiplications
+   */
+{
+  ELog::RegMethod RegA("MarkovProcess","multiplyOut");
+
+  const size_t NF(static_cast<size_t>(FSize));
+  const size_t NE(static_cast<size_t>(WE));
+  if (rowIndex.size()!=NF+1)
+    throw ColErr::EmptyValue<void>("MarkovProcess::matrix");
+  if (fluxField.size()!=NF*NE)
+    throw ColErr::EmptyValue<void>("MarkovProcess::fluxField");
+
+  std::vector<double> nextField(NF*NE);
+  std::vector<double> maxFlux(NE);
+  for(size_t index=0;index<nMult;index++)
+    {
+      ModelSupport::ThreadControl::runBlocks
+	(NF,[&](const size_t A,const size_t B)
+	 {
+	   for(size_t i=A;i<B;i++)
+	     {
+	       double* FOut= &nextField[i*NE];
+	       std::fill(FOut,FOut+NE,0.0);
+	       for(size_t k=rowIndex[i];k<rowIndex[i+1];k++)
+		 {
+		   const double M=matValue[k];
+		   const double* FIn= &fluxField[colIndex[k]*NE];
+		   for(size_t e=0;e<NE;e++)
+		     FOut[e]+=M*FIn[e];
+		 }
+	     }
+	 });
+
+      std::fill(maxFlux.begin(),maxFlux.end(),0.0);
+      for(size_t i=0;i<NF;i++)
+	for(size_t e=0;e<NE;e++)
+	  maxFlux[e]=std::max(maxFlux[e],nextField[i*NE+e]);
+      for(size_t i=0;i<NF;i++)
+	for(size_t e=0;e<NE;e++)
+	  if (maxFlux[e]>0.0)
+	    nextField[i*NE+e]/=maxFlux[e];
+
+      fluxField.swap(nextField);
+      nIteration++;
+    }
+  return;
+}
+
+void
+MarkovProcess::rePopulateWWG(WWGWeight& wMesh) const
+  /*!
+    Write the flux back into the [log] weight mesh
+    \param wMesh :: Weight mesh to set
+   */
 {
+  ELog::RegMethod RegA("MarkovProcess","rePopulateWWG");
+
+  if (!wMesh.isSized(WX,WY,WZ,WE))
+    throw ColErr::MisMatch<long int>
+      (wMesh.getESize(),WE,"WWGWeight/Markov energy");
+
+  const double logMin(std::log(std::numeric_limits<double>::min()));
+  for(long int i=0;i<FSize;i++)
+    for(long int e=0;e<WE;e++)
+      {
+	const double F=fluxField[static_cast<size_t>(i*WE+e)];
+	wMesh.setLogPoint(i,e,(F>0.0) ?
+			  log(F)+logScale[static_cast<size_t>(e)] : logMin);
+      }
   return;
 }
   
@@ -450,6 +450,30 @@ WCells::renumberCell(const int oldIndex,const int newIndex)
   return;
 }
 
+void
+WCells::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the cells in the map in one pass.
+    The new numbers can be old numbers of other cells.
+    \param RMap :: Map of old cell : new cell
+  */
+{
+  ELog::RegMethod RegA("WCells","renumberCell(map)");
+
+  if (RMap.empty()) return;
+  ItemTYPE newWVal;
+  for(ItemTYPE::value_type& WV : WVal)
+    {
+      std::map<int,int>::const_iterator mc=RMap.find(WV.first);
+      const int cellN((mc!=RMap.end()) ? mc->second : WV.first);
+      WV.second.setCellNumber(cellN);
+      if (!newWVal.insert(ItemTYPE::value_type(cellN,WV.second)).second)
+	ELog::EM<<"New point found "<<WV.first<<" "<<cellN<<ELog::endErr;
+    }
+  WVal.swap(newWVal);
+  return;
+}
+
 void
 WCells::writeTable(std::ostream& OX) const
   /*!
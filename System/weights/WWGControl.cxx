@@ -318,20 +318,26 @@ WWGControl::wwgMarkov(const Simulation& System,
   WeightSystem::weightManager& WM=
     WeightSystem::weightManager::Instance();
   WWG& wwg=WM.getWWG();
-  const std::vector<double> EBin=wwg.getEBin();
-  const std::vector<Geometry::Vec3D> GridMidPt=wwg.getMidPoints();
+
+  // matrix is independent of the flux : calculate once
+  MarkovProcess MCalc;
+  MCalc.initializeData(wwg);
+  MCalc.computeMatrix(System,wwg,density,r2Length,r2Power);
   
   for(size_t index=0;index<NSetCnt;index++)
     {
       const size_t nMult=IParam.getValueError<size_t>
 	("wwgMarkov",index,0,"Mult count not set");
-      if (nMarkov)
+      if (nMult)
 	{
-	  MarkovProcess MCalc;
-	  MCalc.initializeData(wwg);
-	  MCalc.computeMatrix(System,wwg,density,r2Length,r2Power);
-	  MCalc.multiplyOut(nMult);
-	  MCalc.rePopulateWWG();
+	  // matrix is symmetric : same transfer for the adjoint
+	  for(WWGWeight* WPtr : {sourceFlux,adjointFlux})
+	    {
+	      MCalc.setFlux(*WPtr);
+	      MCalc.multiplyOut(nMult);
+	      MCalc.rePopulateWWG(*WPtr);
+	    }
+	  nMarkov+=nMult;
 	}
     }
 
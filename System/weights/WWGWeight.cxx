@@ -31,6 +31,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
 #include <boost/multi_array.hpp>
 #include <boost/format.hpp>
 
@@ -76,6 +77,7 @@
 #include "weightManager.h"
 #include "WWGItem.h"
 #include "WWGWeight.h"
+#include "ThreadControl.h"
 
 namespace WeightSystem
 {
@@ -467,29 +469,57 @@ WWGWeight::wTrack(const Simulation& System,
   long int cN(1);
   ELog::EM<<"Processing  "<<MidPt.size()<<" for WWG"<<ELog::endDiag;
 
+  std::vector<double> EVal(static_cast<size_t>(WE));
+  for(size_t index=0;index<EVal.size();index++)
+    EVal[index]=1e-6+EBand[index];
+
+  const size_t NE(EVal.size());
+  const size_t NPts(MidPt.size());
+  // tracks are calculated over the threads a block of points
+  // at a time and then added to the grid in point order
+  const size_t blockPts(4096*ModelSupport::ThreadControl::getThreads());
+  std::vector<double> DTGrid;
+  System.buildCellIndex();
+  
   const long int NCut(static_cast<long int>(MidPt.size())/10);
-  for(const Geometry::Vec3D& Pt : MidPt)
+  for(size_t first=0;first<NPts;first+=blockPts)
     {
-      for(long int index=0;index<WE;index++)
+      const size_t last(std::min(NPts,first+blockPts));
+      DTGrid.resize((last-first)*NE);
+      ModelSupport::ThreadControl::runBlocks
+	(last-first,[&](const size_t A,const size_t B)
+	 {
+	   std::vector<double> DTVec(NE);
+	   for(size_t i=A;i<B;i++)
+	     {
+	       // one track for all the energies
+	       distTrack(System,initPt,EVal,MidPt[first+i],densityFactor,
+			 r2Length,r2Power,DTVec);
+	       std::copy(DTVec.begin(),DTVec.end(),DTGrid.begin()+
+			 static_cast<long int>(i*NE));
+	     }
+	 });
+
+      for(size_t i=0;i<last-first;i++)
 	{
-	  const double EVal=1e-6+EBand[static_cast<size_t>(index)];
-	  const double DT=
-	    distTrack(System,initPt,EVal,Pt,densityFactor,r2Length,r2Power);
-                                                // energy
-	  if (!((cN-1) % NCut))
-	    ELog::EM<<"WTRAC["<<cN<<"] "<<DT<<ELog::endDiag;
-	  
-	  if (!zeroFlag)
-	    addLogPoint(cN-1,index,DT);
-	  else
-	    setLogPoint(cN-1,index,DT);
-	  
-	  if (!(cN % NCut))
-	    ELog::EM<<"Item[ "<<index<<"] == "
-		    <<cN<<" "<<MidPt.size()<<" "<<densityFactor<<" "
-		    <<r2Length<<ELog::endDiag;
+	  for(long int index=0;index<WE;index++)
+	    {
+	      const double DT=DTGrid[i*NE+static_cast<size_t>(index)];
+	      if (!((cN-1) % NCut))
+		ELog::EM<<"WTRAC["<<cN<<"] "<<DT<<ELog::endDiag;
+	      
+	      if (!zeroFlag)
+		addLogPoint(cN-1,index,DT);
+	      else
+		setLogPoint(cN-1,index,DT);
+	      
+	      if (!(cN % NCut))
+		ELog::EM<<"Item[ "<<index<<"] == "
+			<<cN<<" "<<MidPt.size()<<" "<<densityFactor<<" "
+			<<r2Length<<ELog::endDiag;
+	    }
+	  cN++;
 	}
-      cN++;
     }
   zeroFlag =0;
   
@@ -498,22 +528,28 @@ WWGWeight::wTrack(const Simulation& System,
 
 
 template<typename T>
-double
+void
 WWGWeight::distTrack(const Simulation& System,
 		     const T& aimPt,
-		     const double E,
+		     const std::vector<double>& EVal,
 		     const Geometry::Vec3D& gridPt,
 		     const double densityFactor,
 		     const double r2Length,
-		     const double r2Power) const
+		     const double r2Power,
+		     std::vector<double>& DTVec) const
   /*!
-    Calculate a specific track from sourcePoint to position
+    Calculate a specific track from sourcePoint to position.
+    The track is only calculated once for all the energies
+    since only the attenuation depends on energy
+    [ObjectTrackAct::getAttnSum(objN,E) == getAttnSum(objN)/E]
     \param System :: Simulation to use    
     \param aimPt :: Point for outgoing track
+    \param EVal :: Energies [MeV]
     \param gridPt :: Grid points
     \param densityFactor :: Scaling factor for density
     \param r2Length :: scale factor for length
     \param r2Power :: power of 1/r^2 factor
+    \param DTVec :: Log weight for each energy [resized]
   */
 {
   ELog::RegMethod RegA("WWGWeight","distTrack");
@@ -529,9 +565,14 @@ WWGWeight::distTrack(const Simulation& System,
   OTrack.addUnit(System,1,gridPt);
   double DistT=OTrack.getDistance(1)*r2Length;
   if (DistT<1.0) DistT=1.0;
+  const double logDist=r2Power*log(DistT);
   // returns density * Dist * AtomicMass^0.66
-  const double AT=OTrack.getAttnSum(1,E);
-  return -densityFactor*AT-r2Power*log(DistT);
+  const double AT=OTrack.getAttnSum(1);
+
+  DTVec.resize(EVal.size());
+  for(size_t i=0;i<EVal.size();i++)
+    DTVec[i]= -densityFactor*(AT/EVal[i])-logDist;
+  return;
 }
 
 
@@ -576,42 +617,63 @@ WWGWeight::CADISnorm(const Simulation& System,
 
   std::vector<double> sumR(EnergyStride);
   std::vector<double> sumRA(EnergyStride);
+
+  std::vector<double> EVal(EnergyStride);
+  for(size_t j=0;j<EnergyStride;j++)
+    EVal[j]=1e-6+EBand[j];
+  const size_t blockPts(4096*ModelSupport::ThreadControl::getThreads());
+  std::vector<double> WGridBlock;
   
   if (!zeroFlag && !Adjoint.zeroFlag)
     {
       const size_t tenthValue(gridPts.size()/10);
       ELog::EM<<"Source Point == "<<sourcePt<<ELog::endDiag;
+      System.buildCellIndex();
       // STILL in log space
-      for(size_t i=0;i<gridPts.size();i++)
+      for(size_t first=0;first<gridPts.size();first+=blockPts)
 	{
-	  for(size_t j=0;j<EnergyStride;j++)
+	  const size_t last(std::min(gridPts.size(),first+blockPts));
+	  WGridBlock.resize((last-first)*EnergyStride);
+	  ModelSupport::ThreadControl::runBlocks
+	    (last-first,[&](const size_t A,const size_t B)
+	     {
+	       std::vector<double> WVec(EnergyStride);
+	       for(size_t i=A;i<B;i++)
+		 {
+		   distTrack(System,sourcePt,EVal,gridPts[first+i],
+			     1.0,1.0,2.0,WVec);
+		   std::copy(WVec.begin(),WVec.end(),WGridBlock.begin()+
+			     static_cast<long int>(i*EnergyStride));
+		 }
+	     });
+	  // sums in point order : independent of thread number
+	  for(size_t i=first;i<last;i++)
 	    {
-	      const double EVal=1e-6+EBand[j];
-	      const double W=distTrack(System,sourcePt,EVal,
-				       gridPts[i],1.0,1.0,2.0);
-	      sumR[j]=(i) ? mathFunc::logAdd(sumR[j],SData[i*EnergyStride+j]+W) :
-		SData[i*EnergyStride+j]+W;
-	      
-	      sumRA[j]=(i) ? mathFunc::logAdd(sumRA[j],AData[i*EnergyStride+j]+W) :
-		AData[i*EnergyStride+j]+W;
-
-	      
-	      if (j==0 && !(i % tenthValue) )
-		ELog::EM<<"CADIS norm["<<i<<"]:"<<SData[i*EnergyStride]<<" "
-			<<AData[i*EnergyStride]<<" == "
-			<<gridPts[i]<<ELog::endDiag;
-
-	  //	  SData[i*EnergyStride]-=AData[i*EnergyStride];
+	      const double* WVec= &WGridBlock[(i-first)*EnergyStride];
+	      for(size_t j=0;j<EnergyStride;j++)
+		{
+		  const double W=WVec[j];
+		  sumR[j]=(i) ?
+		    mathFunc::logAdd(sumR[j],SData[i*EnergyStride+j]+W) :
+		    SData[i*EnergyStride+j]+W;
+		  
+		  sumRA[j]=(i) ?
+		    mathFunc::logAdd(sumRA[j],AData[i*EnergyStride+j]+W) :
+		    AData[i*EnergyStride+j]+W;
+		  
+		  if (j==0 && !(i % tenthValue) )
+		    ELog::EM<<"CADIS norm["<<i<<"]:"<<SData[i*EnergyStride]
+			    <<" "<<AData[i*EnergyStride]<<" == "
+			    <<gridPts[i]<<ELog::endDiag;
+		}
 	    }
-
 	}
 
       for(size_t j=0;j<EnergyStride;j++)
 	{
-	  const double EVal=1e-6+EBand[j];
-	  ELog::EM<<"sumR["<<EVal<<"]  == "<<sumR[j]<<" "
+	  ELog::EM<<"sumR["<<EVal[j]<<"]  == "<<sumR[j]<<" "
 		  <<exp(sumR[j])<<ELog::endDiag;
-	  ELog::EM<<"sumRA["<<EVal<<"]  == "<<sumRA[j]<<" "
+	  ELog::EM<<"sumRA["<<EVal[j]<<"]  == "<<sumRA[j]<<" "
 		  <<exp(sumRA[j])<<ELog::endDiag;
 	}
       
@@ -700,15 +762,15 @@ WWGWeight::write(std::ostream& OX) const
 ///\cond TEMPLATE
 
 template
-double WWGWeight::distTrack(const Simulation&,const Geometry::Plane&,
-			    const double,const Geometry::Vec3D&,
-			    const double,const double,
-			    const double) const;
+void WWGWeight::distTrack(const Simulation&,const Geometry::Plane&,
+			  const std::vector<double>&,const Geometry::Vec3D&,
+			  const double,const double,
+			  const double,std::vector<double>&) const;
 template
-double WWGWeight::distTrack(const Simulation&,const Geometry::Vec3D&,
-			    const double,const Geometry::Vec3D&,
-			    const double,const double,
-			    const double) const;
+void WWGWeight::distTrack(const Simulation&,const Geometry::Vec3D&,
+			  const std::vector<double>&,const Geometry::Vec3D&,
+			  const double,const double,
+			  const double,std::vector<double>&) const;
 
 template
 void WWGWeight::wTrack(const Simulation&,const Geometry::Vec3D&,
@@ -188,11 +188,21 @@ weightManager::renumberCell(const int OCell,const int NCell)
   */
 {
   ELog::RegMethod RegA("weightManager","renumberCell");
-  for_each(WMap.begin(),WMap.end(),
-	   std::bind(&WForm::renumberCell,
-		     std::bind(&CtrlTYPE::value_type::second,
-				 std::placeholders::_1),
-		       OCell,NCell));
+  for(CtrlTYPE::value_type& wf : WMap)
+    wf.second->renumberCell(OCell,NCell);
+  return;
+}
+
+void
+weightManager::renumberCell(const std::map<int,int>& RMap)  
+  /*!
+    Renumber all the cells in the map
+    \param RMap :: Map of original cell : new cell number
+  */
+{
+  ELog::RegMethod RegA("weightManager","renumberCell(map)");
+  for(CtrlTYPE::value_type& wf : WMap)
+    wf.second->renumberCell(RMap);
   return;
 }
 
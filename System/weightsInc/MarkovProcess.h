@@ -3,7 +3,7 @@
  
  * File:   weightsInc/MarkovProcess.h
  *
- * Copyright (c) 2004-2017 by Stuart Ansell
+ * Copyright (c) 2004-2018 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -46,27 +46,40 @@ namespace WeightSystem
   
   /*!
     \class MarkovProcess
-    \version 1.0
+    \version 1.1
     \author S. Ansell
     \date October 2015
-    \brief Input to Weights controller
+    \brief Transfer matrix between the WWG mesh points
+
+    The matrix is the point to point attenuation exp(WFactor)
+    and is symmetric with a unit diagonal. Entries with 
+    WFactor below cutValue are dropped and the remainder 
+    held as compressed sparse rows. The flux is held relative
+    to the maximum of each energy bin [logScale].
   */
   
 class MarkovProcess
 {
  private:
 
+  static const double cutValue;   ///< Min WFactor [log] kept
   
   size_t nIteration;       ///< number of iterations
 
   long int WX;             ///< WX size of WWG
   long int WY;             ///< WY size of WWG 
   long int WZ;             ///< WZ size of WWG
+  long int WE;             ///< Energy size of flux
 
   long int FSize;          ///< size of fluxField [square]
 
-  /// Array of interaction [initialCell][finalCell]
-  boost::multi_array<double,2> fluxField;
+  std::vector<size_t> rowIndex;     ///< Start of each row [FSize+1]
+  std::vector<size_t> colIndex;     ///< Column of each entry
+  std::vector<double> matValue;     ///< Transfer factor of each entry
+
+  /// Flux [point*WE+energy] relative to logScale
+  std::vector<double> fluxField;
+  std::vector<double> logScale;     ///< Log max flux of each energy
   
  public:
 
@@ -75,12 +88,17 @@ class MarkovProcess
   MarkovProcess& operator=(const MarkovProcess&);
   ~MarkovProcess();
 
+  /// Number of non-zero matrix entries
+  size_t nEntry() const { return matValue.size(); }
+  /// Number of iterations applied
+  size_t getIteration() const { return nIteration; }
 
   void initializeData(const WWG&);
   void computeMatrix(const Simulation&,const WWG&,const double,
 		     const double,const double);
+  void setFlux(const WWGWeight&);
   void multiplyOut(const size_t);
-  void rePopulateWWG();
+  void rePopulateWWG(WWGWeight&) const;
   
 };
 
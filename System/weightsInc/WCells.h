@@ -60,6 +60,7 @@ class WCells : public WForm
   bool isMasked(const int) const;
 
   void renumberCell(const int,const int);  
+  void renumberCell(const std::map<int,int>&);
   void populateCells(const std::map<int,MonteCarlo::Qhull*>&);
   void maskCell(const int); 
   void maskCellComp(const int,const size_t); 
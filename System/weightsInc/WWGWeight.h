@@ -100,11 +100,11 @@ class WWGWeight
 
 
   template<typename T>
-  double distTrack(const Simulation&,const T&,
-		   const double,
-		   const Geometry::Vec3D&,
-		   const double,const double,
-		   const double) const;
+  void distTrack(const Simulation&,const T&,
+		 const std::vector<double>&,
+		 const Geometry::Vec3D&,
+		 const double,const double,
+		 const double,std::vector<double>&) const;
 
   template<typename T>
   void wTrack(const Simulation&,const T&,
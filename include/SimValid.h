@@ -74,16 +74,37 @@ struct simPoint
   \author S. Ansell
   \version 1.0
   \date March 2013
+
+  runMultiPoint tracks rays from several start points over
+  the threads. Ray directions come from a counter-based stream 
+  [seed,ray index] so the result is independent of the 
+  number of threads. Only the index of a failed ray is kept.
 */
 
 class SimValid
 {
  private:
 
-  Geometry::Vec3D Centre;   // Centre for tracks
+  static const size_t maxReport=10;   ///< Failures given diagnostics
+  
+  Geometry::Vec3D Centre;   ///< Centre for tracks
 
+  static double streamRand(const size_t,const size_t,const size_t);
+  static Geometry::Vec3D rayDirection(const size_t,const size_t);
+  
   void diagnostics(const Simulation&,
 		   const std::vector<simPoint>&) const;
+  bool trackRay(const Simulation&,MonteCarlo::Object*,const int,
+		const Geometry::Vec3D&,const Geometry::Vec3D&,
+		std::vector<simPoint>&) const;
+  void setStartPoints(const Simulation&,const std::vector<Geometry::Vec3D>&,
+		      std::vector<Geometry::Vec3D>&,
+		      std::vector<MonteCarlo::Object*>&,
+		      std::vector<int>&) const;
+  std::vector<size_t>
+    failRays(const Simulation&,const std::vector<Geometry::Vec3D>&,
+	     const std::vector<MonteCarlo::Object*>&,
+	     const std::vector<int>&,const size_t,const size_t) const;
   
  public:
   
@@ -97,8 +118,13 @@ class SimValid
 
   // MAIN RUN:
   int runPoint(const Simulation&,const Geometry::Vec3D&,const size_t) const;
+  std::vector<size_t>
+    calcFailRays(const Simulation&,const std::vector<Geometry::Vec3D>&,
+		 const size_t,const size_t) const;
+  int runMultiPoint(const Simulation&,const std::vector<Geometry::Vec3D>&,
+		    const size_t,const size_t) const;
   
-  int runFixedComp(const Simulation&,const size_t) const;
+  int runFixedComp(const Simulation&,const size_t,const size_t) const;
 
 };
 
@@ -25,6 +25,7 @@
 namespace Geometry
 {
   class Transform;
+  class Surface;
 }
 
 namespace tallySystem
@@ -48,6 +49,7 @@ class RemoveCell;
 namespace ModelSupport
 {
   class ObjSurfMap;
+  class ObjBoxIndex;
 }
 
 namespace WeightSystem
@@ -95,6 +97,7 @@ class Simulation
   int CNum;                             ///< Number of complementary components
   FuncDataBase DB;                      ///< DataBase of variables
   ModelSupport::ObjSurfMap* OSMPtr;     ///< Object surface map [if required]
+  ModelSupport::ObjBoxIndex* OBIPtr;    ///< Cell box index [for findCell]
 
   TransTYPE TList;                      ///< Transforms List (key=Transform)
 
@@ -116,6 +119,10 @@ class Simulation
   int readTally(std::istream&);        
 
   // ALL THE sub-write stuff
+  void writeCellBlocks(std::ostream&,
+	void (MonteCarlo::Object::*)(std::ostream&) const) const;
+  void writeSurfaceBlocks(std::ostream&,
+	void (Geometry::Surface::*)(std::ostream&) const) const;
   void writeCells(std::ostream&) const;
   void writeSurfaces(std::ostream&) const;
   void writeMaterial(std::ostream&) const;
@@ -123,8 +130,9 @@ class Simulation
   void writeTransform(std::ostream&) const;
   void writeTally(std::ostream&) const;
   void writeSource(std::ostream&) const;
-  void writePhysics(std::ostream&) const;
-  void writeVariables(std::ostream&,const char ='c') const;
+  void writeVersion(std::ostream&,const char,const int) const;
+  void writeVariables(std::ostream&,const char ='c',
+		      const bool =1) const;
 
   // The Cinder Write stuff
   void writeCinderMat() const;
@@ -157,6 +165,7 @@ class Simulation
   MonteCarlo::Object* findCell(const Geometry::Vec3D&,
 			       MonteCarlo::Object*) const;
   int findCellNumber(const Geometry::Vec3D&,const int) const;  
+  void buildCellIndex() const;
 
   int existCell(const int) const;              ///< check if cell exist
   int getCellMaterial(const int) const;        ///< return cell material
@@ -183,7 +192,7 @@ class Simulation
   int populateCells(const std::vector<int>&);  
 
   int calcVertex(const int); 
-  void calcAllVertex();
+  void calcAllVertex(const bool =1);
   
   void masterRotation();
   void masterPhysicsRotation();
@@ -218,6 +227,7 @@ class Simulation
   void removeCell(const int);
   int removeAllSurface(const int);
   int substituteAllSurface(const int,const int);
+  int substituteAllSurface(const std::map<int,int>&);
   void voidObject(const std::string&);
   void updateSurface(const int,const std::string&);
 
@@ -252,7 +262,11 @@ class Simulation
   void prepareWrite();
   void writeCinder() const;          
 
-  virtual void write(const std::string&) const;  
+  virtual void write(const std::string&) const;
+  void writeDeck(std::ostream&) const;  
+  void writeDeckHead(std::ostream&,const int) const;
+  void writeDeckBody(std::ostream&) const;
+  void writePhysics(std::ostream&) const;
     
   // Debug stuff
   
@@ -23,6 +23,6 @@
 #define MainJobs_h
 
 int createVTK(const mainSystem::inputParam&,
-	      const Simulation*,const std::string&);
+	      Simulation*,const std::string&);
 
 #endif 
@@ -372,6 +372,34 @@ NList<Unit>::changeItem(const Unit& oldI,const Unit& newI)
   return 0;
 }
 
+template<typename Unit>
+int
+NList<Unit>::changeItem(const std::map<Unit,Unit>& RMap)
+  /*!
+    Change all the actual items in the map in one pass.
+    Each item is changed once.
+    \param RMap :: Map of old value : new value
+    \return number of items changed
+  */
+{
+  int cnt(0);
+  typename std::vector<CompUnit>::iterator vc;
+  for(vc=Items.begin();vc!=Items.end();vc++)
+    {
+      if (vc->first==0)
+	{
+	  typename std::map<Unit,Unit>::const_iterator mc=
+	    RMap.find(vc->second);
+	  if (mc!=RMap.end())
+	    {
+	      vc->second=mc->second;
+	      cnt++;
+	    }
+	}
+    }
+  return cnt;
+}
+
 template<typename Unit>
 void
 NList<Unit>::write(std::ostream& OX) const
@@ -190,9 +190,7 @@ SimFLUKA::writeCells(std::ostream& OX) const
   ELog::RegMethod RegA("SimFLUKA","writeCells");
   OX<<"* CELL CARDS "<<std::endl;
 
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writeFLUKA(OX);
+  writeCellBlocks(OX,&MonteCarlo::Object::writeFLUKA);
   OX<<"END"<<std::endl;
   return;
 }
@@ -207,11 +205,7 @@ SimFLUKA::writeSurfaces(std::ostream& OX) const
 {
   OX<<"* SURFACE CARDS "<<std::endl;
 
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
-
-  for(const ModelSupport::surfIndex::STYPE::value_type& sm : SurMap)
-    sm.second->writeFLUKA(OX);
+  writeSurfaceBlocks(OX,&Geometry::Surface::writeFLUKA);
   OX<<"END"<<std::endl;
   return;
 } 
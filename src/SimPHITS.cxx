@@ -212,13 +212,12 @@ SimPHITS::writeCells(std::ostream& OX) const
 {
   boost::format FmtStr("  %1$d%|20t|%2$d\n");
   OX<<"[cell]"<<std::endl;
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writePHITS(OX);
+  writeCellBlocks(OX,&MonteCarlo::Object::writePHITS);
 
   OX<<std::endl;  // Empty line manditory for MCNPX
 
   OX<<"[temperature]"<<std::endl;
+  OTYPE::const_iterator mp;
   for(mp=OList.begin();mp!=OList.end();mp++)
     {
       const double T=mp->second->getTemp();
@@ -243,13 +242,7 @@ SimPHITS::writeSurfaces(std::ostream& OX) const
 {
   OX<<"  [surface] " <<std::endl;
 
-  const ModelSupport::surfIndex::STYPE& SurMap=
-    ModelSupport::surfIndex::Instance().surMap();
-  std::map<int,Geometry::Surface*>::const_iterator mp;
-  for(mp=SurMap.begin();mp!=SurMap.end();mp++)
-    {
-      (mp->second)->write(OX);
-    }
+  writeSurfaceBlocks(OX,&Geometry::Surface::write);
   return;
 } 
 
@@ -110,9 +110,7 @@ SimPOVRay::writeCells(std::ostream& OX) const
 {
   ELog::RegMethod RegA("SimPOVRay","writeCells");
     
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writePOVRay(OX);
+  writeCellBlocks(OX,&MonteCarlo::Object::writePOVRay);
   return;
 }
 
@@ -124,11 +122,7 @@ SimPOVRay::writeSurfaces(std::ostream& OX) const
     \param OX :: Output stream
   */
 {
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
-
-  for(const ModelSupport::surfIndex::STYPE::value_type& sm : SurMap)
-    sm.second->writePOVRay(OX);
+  writeSurfaceBlocks(OX,&Geometry::Surface::writePOVRay);
   OX<<std::endl;
   return;
 } 
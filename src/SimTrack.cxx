@@ -52,11 +52,12 @@ SimTrack::SimTrack()
 SimTrack&
 SimTrack::Instance()
   /*!
-    Singleton this
+    Singleton this : one per thread so that tracks in 
+    different threads do not share the last cell
     \return SimTrack object
    */
 {
-  static SimTrack ST;
+  static thread_local SimTrack ST;
   return ST;
 }
 
@@ -92,21 +93,15 @@ SimTrack::addSim(const Simulation* SimPtr)
 void
 SimTrack::setCell(const Simulation* SimPtr,MonteCarlo::Object* OPtr)
   /*!
-    Set the current cell pointer
-    \param SimPtr :: Significant figures
+    Set the current cell pointer. The simulation is added
+    if it is new [first use in a thread]
+    \param SimPtr :: Simulation pointer
     \param OPtr :: Object Pointer
   */
 {
-  ELog::RegMethod RegA("SimTrack","setCell");
-
-  fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
-  fcTYPE::iterator mc=findCell.find(sInt);
-  if (mc==findCell.end())
-    {
-      throw ColErr::InContainerError<fcTYPE::key_type>
-	(sInt,"sInt not fould in findCell");
-    }
-  mc->second=OPtr;
+  const fcTYPE::key_type sInt=
+    reinterpret_cast<fcTYPE::key_type>(SimPtr);
+  findCell[sInt]=OPtr;
   return;
 }
 
@@ -114,18 +109,14 @@ MonteCarlo::Object*
 SimTrack::curCell(const Simulation* SimPtr) const
   /*!
     Get the current cell
-    \param SimPtr :: Significant figures
-    \return :: Object Pointer
+    \param SimPtr :: Simulation pointer
+    \return :: Object Pointer [0 if not set in this thread]
   */
 {
-  ELog::RegMethod RegA("SimTrack","curCell");
-
-  fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
+  const fcTYPE::key_type sInt=
+    reinterpret_cast<fcTYPE::key_type>(SimPtr);
   fcTYPE::const_iterator mc=findCell.find(sInt);
-  if (mc==findCell.end())
-    throw ColErr::InContainerError<fcTYPE::key_type>
-      (sInt,"simluation<long Int>");
-  return mc->second;
+  return (mc!=findCell.end()) ? mc->second : 0;
 }
 
 void
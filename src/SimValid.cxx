@@ -31,6 +31,9 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <cstdint>
+#include <algorithm>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -63,6 +66,7 @@
 #include "FixedComp.h"
 #include "Simulation.h"
 #include "SimValid.h"
+#include "ThreadControl.h"
 
 #include "debugMethod.h"
 
@@ -171,6 +175,78 @@ SimValid::diagnostics(const Simulation& System,
   return;
 }
 
+
+double
+SimValid::streamRand(const size_t seed,const size_t index,
+		     const size_t sub)
+  /*!
+    Counter based random number : the value only depends 
+    on the arguments [splitmix64 finalizer on each key]
+    \param seed :: Random seed
+    \param index :: Stream index [ray number]
+    \param sub :: Number within stream
+    \return value [0-1)
+  */
+{
+  auto mix=[](uint64_t X) -> uint64_t
+    {
+      X+=0x9e3779b97f4a7c15ULL;
+      X=(X ^ (X >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      X=(X ^ (X >> 27)) * 0x94d049bb133111ebULL;
+      return X ^ (X >> 31);
+    };
+
+  const uint64_t V=mix(mix(mix(static_cast<uint64_t>(seed)) ^
+			   static_cast<uint64_t>(index)) ^
+		       static_cast<uint64_t>(sub));
+  return static_cast<double>(V >> 11)*(1.0/9007199254740992.0);
+}
+
+bool
+SimValid::trackRay(const Simulation& System,
+		   MonteCarlo::Object* InitObj,
+		   const int initSurfNum,
+		   const Geometry::Vec3D& CP,
+		   const Geometry::Vec3D& uVec,
+		   std::vector<simPoint>& Pts) const
+  /*!
+    Track a single ray out of the model. Nothing is 
+    written to the log [can be called from threads]
+    \param System :: Simulation to use
+    \param InitObj :: Cell containing CP
+    \param initSurfNum :: Surface that CP is on [0 if none]
+    \param CP :: Start point
+    \param uVec :: Direction
+    \param Pts :: Points of the track [for diagnostics]
+    \return true if the track reached an imp=0 cell
+  */
+{
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+  const Geometry::Surface* SPtr;          // Output surface
+  double aDist;       
+
+  MonteCarlo::neutron TNeut(1,CP,uVec);
+
+  MonteCarlo::Object* OPtr=InitObj;
+  int SN(-initSurfNum);
+
+  Pts.clear();
+  Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
+  while(OPtr && OPtr->getImp())
+    {
+      // Note: Need OPPOSITE Sign on exiting surface
+      SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
+      // Fail on first step with infinite distance : step off
+      if (aDist>1e30 && Pts.size()<=1)
+	aDist=1e-5;
+      
+      TNeut.moveForward(aDist);
+      Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
+      OPtr=(SN) ?
+	OSMPtr->findNextObject(SN,TNeut.Pos,OPtr->getName()) : 0;	    
+    }
+  return (OPtr!=0);
+}
   
 int
 SimValid::runPoint(const Simulation& System,
@@ -187,72 +263,240 @@ SimValid::runPoint(const Simulation& System,
   ELog::RegMethod RegA("SimValid","run");
   ELog::debugMethod DebA;
   
-  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
-  MonteCarlo::Object* InitObj(0);
-  const Geometry::Surface* SPtr;          // Output surface
-  double aDist;       
-
   // Note for sphere that you can use X,Y,Z in any orthogonal 
   // directiron
   double phi,theta;
 
   // Find Initial cell [Store for next time]
-  //  Centre+=Geometry::Vec3D(0.001,0.001,0.001);
-  InitObj=System.findCell(CP,InitObj);  
+  MonteCarlo::Object* InitObj=System.findCell(CP,0);  
+  if (!InitObj)
+    throw ColErr::InContainerError<Geometry::Vec3D>(CP,"Point not in cell");
   const int initSurfNum=InitObj->isOnSide(CP);
 
   // check surfaces
+  std::vector<simPoint> Pts;
   for(size_t i=0;i<nAngle;i++)
     {
-      std::vector<simPoint> Pts;
       // Get random starting point on edge of volume
       phi=RNG.rand()*M_PI;
       theta=2.0*RNG.rand()*M_PI;
-      Geometry::Vec3D uVec(cos(theta)*sin(phi),
-			     sin(theta)*sin(phi),
-			     cos(phi));
-      MonteCarlo::neutron TNeut(1,Centre,uVec);
+      const Geometry::Vec3D uVec(cos(theta)*sin(phi),
+				 sin(theta)*sin(phi),
+				 cos(phi));
+      if (!trackRay(System,InitObj,initSurfNum,CP,uVec,Pts))
+	{
+	  ELog::EM<<"Failed to calculate cell correctly: "<<i<<ELog::endCrit;
+	  diagnostics(System,Pts);
+	  return 0;
+	}
+    }
+  return 1;
+}
 
-      MonteCarlo::Object* OPtr=InitObj;
-      int SN(-initSurfNum);
+Geometry::Vec3D
+SimValid::rayDirection(const size_t seed,const size_t index)
+  /*!
+    Direction of a ray [uniform on the sphere] from the 
+    counter based random stream
+    \param seed :: Random seed
+    \param index :: Ray number
+    \return unit vector
+  */
+{
+  const double cosTheta=2.0*streamRand(seed,index,0)-1.0;
+  const double sinTheta=sqrt(1.0-cosTheta*cosTheta);
+  const double phi=2.0*M_PI*streamRand(seed,index,1);
+  return Geometry::Vec3D(cos(phi)*sinTheta,sin(phi)*sinTheta,cosTheta);
+}
 
-      Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
-      while(OPtr && OPtr->getImp())
-	{
-	  // Note: Need OPPOSITE Sign on exiting surface
-	  SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
-	  if (aDist>1e30 && Pts.size()<=1)
+void
+SimValid::setStartPoints(const Simulation& System,
+			 const std::vector<Geometry::Vec3D>& CPts,
+			 std::vector<Geometry::Vec3D>& StartPts,
+			 std::vector<MonteCarlo::Object*>& StartObj,
+			 std::vector<int>& StartSurf) const
+  /*!
+    Find the start points : coincident points are removed
+    [first kept] and points that are not in a cell or in 
+    an imp=0 cell are skipped.
+    \param System :: Simulation to use
+    \param CPts :: Points to test
+    \param StartPts :: Unique valid points
+    \param StartObj :: Cell of each point
+    \param StartSurf :: Surface each point is on [0 if none]
+  */
+{
+  ELog::RegMethod RegA("SimValid","setStartPoints");
+
+  // coincident points are adjacent when sorted
+  std::vector<size_t> Index(CPts.size());
+  for(size_t i=0;i<Index.size();i++)
+    Index[i]=i;
+  std::sort(Index.begin(),Index.end(),
+	    [&CPts](const size_t A,const size_t B)
 	    {
-	      ELog::EM<<"Fail on Pts==1 and aDist inf"<<ELog::endDiag;
-	      ELog::EM<<"Index == "<<Pts.size()-2<<ELog::endDiag;
-	      ELog::EM<<"Pts[0] == "<<Pts[0].Pt<<ELog::endDiag;
-	      ELog::EM<<"SN == "<<SN<<ELog::endDiag;
-	      aDist=1e-5;
-	    }
-
-	  TNeut.moveForward(aDist);
-	  Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
-	  OPtr=(SN) ?
-	    OSMPtr->findNextObject(SN,TNeut.Pos,OPtr->getName()) : 0;	    
-	}
+	      const Geometry::Vec3D& PA=CPts[A];
+	      const Geometry::Vec3D& PB=CPts[B];
+	      if (PA[0]!=PB[0]) return PA[0]<PB[0];
+	      if (PA[1]!=PB[1]) return PA[1]<PB[1];
+	      if (PA[2]!=PB[2]) return PA[2]<PB[2];
+	      return A<B;
+	    });
+  std::vector<bool> Repeat(CPts.size(),0);
+  for(size_t i=1,keep=0;i<Index.size();i++)
+    {
+      if (CPts[Index[i]]==CPts[Index[keep]])
+	Repeat[Index[i]]=1;
+      else
+	keep=i;
+    }
 
-      if (!OPtr)
+  StartPts.clear();
+  StartObj.clear();
+  StartSurf.clear();
+  for(size_t i=0;i<CPts.size();i++)
+    {
+      if (Repeat[i]) continue;
+      const Geometry::Vec3D& CP(CPts[i]);
+      MonteCarlo::Object* OPtr=System.findCell(CP,0);
+      if (OPtr && OPtr->getImp())
 	{
-	  ELog::EM<<"Failed to calculate cell correctly: "<<i<<ELog::endCrit;
-	  diagnostics(System,Pts);
-	  return 0;
+	  StartPts.push_back(CP);
+	  StartObj.push_back(OPtr);
+	  StartSurf.push_back(OPtr->isOnSide(CP));
 	}
     }
+  return;
+}
+
+std::vector<size_t>
+SimValid::failRays(const Simulation& System,
+		   const std::vector<Geometry::Vec3D>& StartPts,
+		   const std::vector<MonteCarlo::Object*>& StartObj,
+		   const std::vector<int>& StartSurf,
+		   const size_t nAngle,const size_t seed) const
+  /*!
+    Track nAngle rays from each start point over the threads.
+    Each block only keeps the index of its failed rays and 
+    the blocks are joined in order.
+    \param System :: Simulation to use
+    \param StartPts :: Start points
+    \param StartObj :: Cell of each start point
+    \param StartSurf :: Surface of each start point
+    \param nAngle :: Number of rays from each point
+    \param seed :: Random seed for the ray directions
+    \return failed rays [point*nAngle+ray] in order
+  */
+{
+  const size_t NRay(StartPts.size()*nAngle);
+  const size_t blockSize=std::max<size_t>
+    (1,NRay/(16*ModelSupport::ThreadControl::getThreads()));
+  const size_t NBlock((NRay+blockSize-1)/blockSize);
+
+  std::vector<std::vector<size_t>> BlockFail(NBlock);
+  ModelSupport::ThreadControl::runBlocks
+    (NRay,blockSize,[&](const size_t A,const size_t B)
+     {
+       std::vector<size_t>& Fail=BlockFail[A/blockSize];
+       std::vector<simPoint> Pts;
+       for(size_t i=A;i<B;i++)
+	 {
+	   const size_t ptIndex(i/nAngle);
+	   if (!trackRay(System,StartObj[ptIndex],StartSurf[ptIndex],
+			 StartPts[ptIndex],rayDirection(seed,i),Pts))
+	     Fail.push_back(i);
+	 }
+     });
+
+  std::vector<size_t> Out;
+  for(const std::vector<size_t>& Fail : BlockFail)
+    Out.insert(Out.end(),Fail.begin(),Fail.end());
+  return Out;
+}
+
+std::vector<size_t>
+SimValid::calcFailRays(const Simulation& System,
+		       const std::vector<Geometry::Vec3D>& CPts,
+		       const size_t nAngle,const size_t seed) const
+  /*!
+    Get the failed rays from a set of points 
+    [the result does not depend on the number of threads]
+    \param System :: Simulation to use
+    \param CPts :: Points to test [repeats removed]
+    \param nAngle :: Number of rays from each point
+    \param seed :: Random seed for the ray directions
+    \return failed rays [point*nAngle+ray] in order
+  */
+{
+  ELog::RegMethod RegA("SimValid","calcFailRays");
+
+  System.buildCellIndex();
+  std::vector<Geometry::Vec3D> StartPts;
+  std::vector<MonteCarlo::Object*> StartObj;
+  std::vector<int> StartSurf;
+  setStartPoints(System,CPts,StartPts,StartObj,StartSurf);
+  return failRays(System,StartPts,StartObj,StartSurf,nAngle,seed);
+}
+
+int
+SimValid::runMultiPoint(const Simulation& System,
+			const std::vector<Geometry::Vec3D>& CPts,
+			const size_t nAngle,const size_t seed) const
+  /*!
+    Track nAngle rays from each point over the threads.
+    Repeated points, points that are not in a cell or in an 
+    imp=0 cell are skipped. All failures are counted and the 
+    first maxReport [in ray order] are given diagnostics.
+    \param System :: Simulation to use
+    \param CPts :: Start points
+    \param nAngle :: Number of rays from each point
+    \param seed :: Random seed for the ray directions
+    \return true if valid
+  */
+{
+  ELog::RegMethod RegA("SimValid","runMultiPoint");
+
+  System.buildCellIndex();
+
+  std::vector<Geometry::Vec3D> StartPts;
+  std::vector<MonteCarlo::Object*> StartObj;
+  std::vector<int> StartSurf;
+  setStartPoints(System,CPts,StartPts,StartObj,StartSurf);
+  ELog::EM<<"Valid check from "<<StartPts.size()<<" / "<<CPts.size()
+	  <<" points : "<<nAngle<<" rays each"<<ELog::endDiag;
+
+  const std::vector<size_t> Fail=
+    failRays(System,StartPts,StartObj,StartSurf,nAngle,seed);
+
+  // Retrack the reported rays for the diagnostics
+  std::vector<simPoint> Pts;
+  for(size_t i=0;i<Fail.size() && i<maxReport;i++)
+    {
+      const size_t ptIndex(Fail[i]/nAngle);
+      trackRay(System,StartObj[ptIndex],StartSurf[ptIndex],
+	       StartPts[ptIndex],rayDirection(seed,Fail[i]),Pts);
+      ELog::EM<<"Failed to calculate cell correctly: Point "
+	      <<StartPts[ptIndex]<<" ray "<<Fail[i] % nAngle<<ELog::endCrit;
+      diagnostics(System,Pts);
+    }
+  if (!Fail.empty())
+    {
+      ELog::EM<<"Failed rays == "<<Fail.size()<<" / "
+	      <<StartPts.size()*nAngle<<ELog::endCrit;
+      return 0;
+    }
   return 1;
 }
 
 int
 SimValid::runFixedComp(const Simulation& System,
-		       const size_t N) const
+		       const size_t N,const size_t seed) const
   /*!
-    Calculate the tracking from fixedcomp
+    Calculate the tracking from all the link points 
+    of the fixedcomp [in name order]
     \param System :: Simulation to use
-    \param N :: Number of points to test
+    \param N :: Number of rays from each point
+    \param seed :: Random seed for the ray directions
     \return true if valid
   */
 {
@@ -266,17 +510,18 @@ SimValid::runFixedComp(const Simulation& System,
 
   const cMapTYPE& CM=OR.getComponents();
 
+  std::vector<Geometry::Vec3D> CPts;
   for(const cMapTYPE::value_type& FCitem : CM)
     {
       const CTYPE& FC = FCitem.second;
       const std::vector<Geometry::Vec3D> FCPts=
 	FC->getAllLinkPts();
-      for(const Geometry::Vec3D& Pt : FCPts)
-	ELog::EM<<"PT == "<<FC->getKeyName()<<" :: "<<Pt<<ELog::endDiag;
+      CPts.insert(CPts.end(),FCPts.begin(),FCPts.end());
     }
-  
+
+  const int flag=runMultiPoint(System,CPts,N,seed);
   ELog::EM<<"Finished Validation check"<<ELog::endDiag;
-  return 1;
+  return flag;
 }
 
 } // NAMESPACE ModelSupport
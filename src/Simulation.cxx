@@ -35,6 +35,8 @@
 #include <iterator>
 #include <memory>
 #include <array>
+#include <tuple>
+#include <mutex>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -73,6 +75,7 @@
 #include "Transform.h"
 #include "Surface.h"
 #include "surfIndex.h"
+#include "SideCache.h"
 #include "surfEqual.h"
 #include "Quadratic.h"
 #include "surfaceFactory.h"
@@ -83,6 +86,7 @@
 #include "FItem.h"
 #include "FuncDataBase.h"
 #include "SurInter.h"
+#include "TripleCache.h"
 #include "BnId.h"
 #include "Acomp.h"
 #include "Algebra.h"
@@ -100,6 +104,9 @@
 #include "sourceDataBase.h"
 #include "KCode.h"
 #include "ObjSurfMap.h"
+#include "BoundBox.h"
+#include "ObjBoxIndex.h"
+#include "ThreadControl.h"
 #include "PhysicsCards.h"
 #include "ReadFunctions.h"
 #include "BaseMap.h"
@@ -109,6 +116,7 @@
 
 Simulation::Simulation()  :
   mcnpVersion(6),CNum(100000),OSMPtr(new ModelSupport::ObjSurfMap),
+  OBIPtr(new ModelSupport::ObjBoxIndex),
   PhysPtr(new physicsSystem::PhysicsCards)
   /*!
     Start of simulation Object
@@ -121,6 +129,7 @@ Simulation::Simulation(const Simulation& A)  :
   mcnpVersion(A.mcnpVersion),inputFile(A.inputFile),
   CNum(A.CNum),DB(A.DB),
   OSMPtr(new ModelSupport::ObjSurfMap),
+  OBIPtr(new ModelSupport::ObjBoxIndex),
   TList(A.TList),  cellOutOrder(A.cellOutOrder),
   PhysPtr(new physicsSystem::PhysicsCards(*A.PhysPtr))
   /*!
@@ -202,6 +211,7 @@ Simulation::~Simulation()
   delete OSMPtr;
   deleteObjects();
   deleteTally();
+  delete OBIPtr;
   ModelSupport::SimTrack::Instance().clearSim(this);
 
 }
@@ -234,6 +244,7 @@ Simulation::deleteObjects()
   ELog::RegMethod RegA("Simulation","deleteObjects");
   
   ModelSupport::SimTrack::Instance().setCell(this,0);
+  OBIPtr->clearAll();
   for(OTYPE::value_type& mc : OList)
     delete mc.second;
   
@@ -395,6 +406,7 @@ Simulation::checkInsert(const MonteCarlo::Qhull& A)
 
   const int cellNumber=A.getName();
   OTYPE::iterator mpt=OList.find(cellNumber);
+  OBIPtr->reset();
   
   if (mpt!=OList.end())
     {
@@ -478,6 +490,7 @@ Simulation::addCell(const int cellNumber,const MonteCarlo::Qhull& A)
     ModelSupport::objectRegister::Instance();
 
   OTYPE::iterator mpt=OList.find(cellNumber);
+  OBIPtr->reset();
   
   // Adding existing cell:
   if (mpt!=OList.end())
@@ -735,6 +748,7 @@ Simulation::removeCells(const int startN,const int endN)
   ModelSupport::objectRegister& OR=
     ModelSupport::objectRegister::Instance();
 
+  OBIPtr->reset();
   // It seems quicker to create a new map and copy
   OTYPE newOList;
   OTYPE::iterator vc;
@@ -777,6 +791,7 @@ Simulation::removeCell(const int cellNumber)
   
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
   ST.checkDelete(this,vc->second);
+  OBIPtr->reset();
   delete vc->second;
   OList.erase(vc);
 
@@ -849,6 +864,40 @@ Simulation::substituteAllSurface(const int KeyN,const int NsurfN)
   return 0;
 }
 
+int 
+Simulation::substituteAllSurface(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in the map in every cell, tally
+    and the source. Each is processed once. The surfaces must
+    already have their new numbers in surfIndex.
+    \param RMap :: Map of old surface : new surface
+    \returns Number of cells changed
+  */
+{
+  ELog::RegMethod RegA("Simulation","substituteAllSurface(map)");
+  SDef::sourceDataBase& SDB=SDef::sourceDataBase::Instance();
+
+  if (RMap.empty()) return 0;
+  
+  int cnt(0);
+  for(OTYPE::value_type& OV : OList)
+    if (OV.second->substituteSurf(RMap))
+      cnt++;
+
+  for(TallyTYPE::value_type& TI : TItem)
+    TI.second->renumberSurf(RMap);
+
+  // Source:
+  if (!sourceName.empty())
+    {
+      SDef::SourceBase* SPtr=
+	SDB.getSourceThrow<SDef::SourceBase>(sourceName,"Source not known");
+      SPtr->substituteSurface(RMap);
+    }
+
+  return cnt;
+}
+
 int
 Simulation::bindCell(const int CellVirtual,const int CellBound)
   /*!
@@ -894,6 +943,7 @@ Simulation::makeVirtual(const int CellN)
     {
       return -1;
     }
+  OBIPtr->reset();
   vc->second->setPlaceHold(1);
   return 0;
 }
@@ -1100,6 +1150,8 @@ Simulation::populateCells()
 	  throw;
 	}
     }
+  // all cells valid : allow the box index to be built
+  OBIPtr->setActive();
   return -retVal;
 }
 
@@ -1147,17 +1199,20 @@ Simulation::applyTransforms()
 {
   
   ELog::RegMethod RegA("Simulation","applyTransforms");
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
+  OBIPtr->reset();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  const ModelSupport::surfIndex::STYPE& SurMap=SurI.surMap();
   std::map<int,Geometry::Surface*>::const_iterator sm;
   for(sm=SurMap.begin();sm!=SurMap.end();sm++)
     {
       if (sm->second->applyTransform(TList)<0)
         {
 	  ELog::EM<<"Failed on "<<sm->first<<ELog::endErr;
+	  SurI.reindex();
 	  return 1;
 	}
     }
+  SurI.reindex();
   return 0;
 }
 
@@ -1209,23 +1264,36 @@ Simulation::calcVertex(const int CellN)
 }
 
 void
-Simulation::calcAllVertex()
+Simulation::calcAllVertex(const bool cacheFlag)
   /*! 
      Calculates the vertexes in the Cell and stores
-     in the Qhull. The number of vertexes found are returned. 
+     in the Qhull. The cells are split over the threads.
+     \param cacheFlag :: share the triple surface points between cells
   */
 {
   ELog::RegMethod RegA("Simulation","calcAllVertex");
 
-
-  OTYPE::iterator mc;
-
-  for(mc=OList.begin();mc!=OList.end();mc++)
+  // population changes the global rule count : do it in this thread
+  std::vector<MonteCarlo::Qhull*> Cells;
+  for(OTYPE::value_type& OVal : OList)
     {
-      // This point may be outside of the point
-      if (!mc->second->calcVertex())   
-	mc->second->calcMidVertex();
+      OVal.second->populate();
+      Cells.push_back(OVal.second);
     }
+
+  Geometry::TripleCache TCache;
+  Geometry::TripleCache* TCPtr=(cacheFlag) ? &TCache : 0;
+  ModelSupport::ThreadControl::runBlocks
+    (Cells.size(),1,
+     [&Cells,TCPtr](const size_t first,const size_t last)
+     {
+       for(size_t i=first;i<last;i++)
+	 {
+	   // This point may be outside of the point
+	   if (!Cells[i]->calcVertex(TCPtr))   
+	     Cells[i]->calcMidVertex();
+	 }
+     });
   return;
 }
 
@@ -1529,6 +1597,8 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
   */
 {
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
+  // each surface side is calculated once over all the cells
+  const Geometry::SideScope SScope;
   // First test users guess:
   if (testCell && testCell->isValid(Pt))
     {
@@ -1541,6 +1611,16 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
       && curObjPtr->isValid(Pt))
     return curObjPtr;
       
+  // use the box index if the cells are populated
+  if (OBIPtr->isActive())
+    {
+      if (!OBIPtr->isBuilt())
+	OBIPtr->build(OList);
+      MonteCarlo::Object* OPtr=OBIPtr->findCell(Pt);
+      ST.setCell(this,OPtr);
+      return OPtr;
+    }
+      
   // now we need to search everthing
   OTYPE::const_iterator mpc;
   for(mpc=OList.begin();mpc!=OList.end();mpc++)
@@ -1557,6 +1637,21 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
   return 0;
 }
 
+void
+Simulation::buildCellIndex() const
+  /*!
+    Build the box index [if active and out of date]. 
+    This must be called before findCell is used from 
+    several threads since the normal build is lazy.
+  */
+{
+  ELog::RegMethod RegA("Simulation","buildCellIndex");
+  
+  if (OBIPtr->isActive() && !OBIPtr->isBuilt())
+    OBIPtr->build(OList);
+  return;
+}
+
 void
 Simulation::writeTally(std::ostream& OX) const
   /*!
@@ -1639,6 +1734,63 @@ Simulation::writeTransform(std::ostream& OX) const
 }
 
 
+void
+Simulation::writeCellBlocks(std::ostream& OX,
+  void (MonteCarlo::Object::*writeFunc)(std::ostream&) const) const
+  /*!
+    Write all the cells with a given write function. 
+    The cells are formated in blocks over the threads and
+    written in OList order.
+    \param OX :: Output stream
+    \param writeFunc :: Object write function
+  */
+{
+  ELog::RegMethod RegA("Simulation","writeCellBlocks");
+
+  std::vector<const MonteCarlo::Qhull*> Cells;
+  Cells.reserve(OList.size());
+  for(const OTYPE::value_type& OVal : OList)
+    Cells.push_back(OVal.second);
+
+  ModelSupport::ThreadControl::writeBlocks
+    (OX,Cells.size(),
+     [&Cells,writeFunc](const size_t index,std::ostream& cx)
+     {
+       (Cells[index]->*writeFunc)(cx);
+     });
+  return;
+}
+
+void
+Simulation::writeSurfaceBlocks(std::ostream& OX,
+  void (Geometry::Surface::*writeFunc)(std::ostream&) const) const
+  /*!
+    Write all the surfaces with a given write function. 
+    The surfaces are formated in blocks over the threads and
+    written in surfIndex order.
+    \param OX :: Output stream
+    \param writeFunc :: Surface write function [virtual]
+  */
+{
+  ELog::RegMethod RegA("Simulation","writeSurfaceBlocks");
+
+  const ModelSupport::surfIndex::STYPE& SurMap =
+    ModelSupport::surfIndex::Instance().surMap();
+
+  std::vector<const Geometry::Surface*> Surf;
+  Surf.reserve(SurMap.size());
+  for(const ModelSupport::surfIndex::STYPE::value_type& SM : SurMap)
+    Surf.push_back(SM.second);
+
+  ModelSupport::ThreadControl::writeBlocks
+    (OX,Surf.size(),
+     [&Surf,writeFunc](const size_t index,std::ostream& cx)
+     {
+       (Surf[index]->*writeFunc)(cx);
+     });
+  return;
+}
+
 void
 Simulation::writeCells(std::ostream& OX) const
   /*!
@@ -1651,11 +1803,7 @@ Simulation::writeCells(std::ostream& OX) const
   OX<<"c -------------------------------------------------------"<<std::endl;
   OX<<"c --------------- CELL CARDS --------------------------"<<std::endl;
   OX<<"c -------------------------------------------------------"<<std::endl;
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    {
-      mp->second->write(OX);
-    }
+  writeCellBlocks(OX,&MonteCarlo::Object::write);
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;  // Empty line manditory for MCNPX
   return;
@@ -1675,14 +1823,7 @@ Simulation::writeSurfaces(std::ostream& OX) const
   OX<<"c --------------- SURFACE CARDS -------------------------"<<std::endl;
   OX<<"c -------------------------------------------------------"<<std::endl;
 
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
-
-  std::map<int,Geometry::Surface*>::const_iterator mp;
-  for(mp=SurMap.begin();mp!=SurMap.end();mp++)
-    {
-      (mp->second)->write(OX);
-    }
+  writeSurfaceBlocks(OX,&Geometry::Surface::write);
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;
   return;
@@ -1823,20 +1964,36 @@ Simulation::writePhysics(std::ostream& OX) const
 }
 
 void
-Simulation::writeVariables(std::ostream& OX,
-			   const char commentChar) const
+Simulation::writeVersion(std::ostream& OX,const char commentChar,
+			 const int vNum) const
   /*!
-    Write all the variables in standard MCNPX output format
+    Write the version number block
     \param OX :: Output stream
     \param commentChar :: character for comments
+    \param vNum :: version number to write
   */
 {
-  ELog::RegMethod RegA("Simulation","writeVaraibles");
   OX<<commentChar<<" ---------- VERSION NUMBER ------------------"<<std::endl;
   OX<<commentChar<<"  ===Git: "<<version::Instance().getBuildTag()
     <<" ====== "<<std::endl;
-  OX<<commentChar<<"  ========= "<<version::Instance().getIncrement()
-    <<" ========== "<<std::endl;
+  OX<<commentChar<<"  ========= "<<vNum<<" ========== "<<std::endl;
+  return;
+}
+
+void
+Simulation::writeVariables(std::ostream& OX,
+			   const char commentChar,
+			   const bool versionFlag) const
+  /*!
+    Write all the variables in standard MCNPX output format
+    \param OX :: Output stream
+    \param commentChar :: character for comments
+    \param versionFlag :: write [and increment] the version number
+  */
+{
+  ELog::RegMethod RegA("Simulation","writeVaraibles");
+  if (versionFlag)
+    writeVersion(OX,commentChar,version::Instance().getIncrement());
   OX<<commentChar<<" ----------------------------------------------"<<std::endl;
   OX<<commentChar<<" --------------- VARIABLE CARDS ---------------"<<std::endl;
   OX<<commentChar<<" ----------------------------------------------"<<std::endl;
@@ -2117,10 +2274,13 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
   WeightSystem::weightManager& WM=
     WeightSystem::weightManager::Instance();
 
+  OBIPtr->reset();
   //Offset index  
   const int cIndex(10000);
 
   OTYPE newMap;           // New map with correct numbering
+  std::map<int,int> cellMap;     // Changed cells : old : new
+  std::map<int,int> physMap;     // Changed non-placeholder cells
   int nNum(0);
   int index(1);
 
@@ -2155,13 +2315,11 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
       // Do renumber:
       vc->second->setName(nNum);      
       newMap.insert(OTYPE::value_type(nNum,vc->second));
-      WM.renumberCell(cNum,nNum);
-
-      if (!vc->second->isPlaceHold())
+      if (cNum!=nNum)
 	{
-	  PhysPtr->substituteCell(cNum,nNum);
-	  for(TallyTYPE::value_type& TI : TItem)
-	    TI.second->renumberCell(cNum,nNum);
+	  cellMap.emplace(cNum,nNum);
+	  if (!vc->second->isPlaceHold())
+	    physMap.emplace(cNum,nNum);
 	}
       if (keyUnit!=oldUnit)
 	{
@@ -2191,6 +2349,12 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
   // Last item
   OR.setRenumber(keyUnit,startNum,nNum);
   OList=newMap;
+
+  // All the cards in one pass
+  WM.renumberCell(cellMap);
+  PhysPtr->substituteCell(physMap);
+  for(TallyTYPE::value_type& TI : TItem)
+    TI.second->renumberCell(physMap);
   return;
 }
 
@@ -2225,13 +2389,16 @@ Simulation::renumberSurfaces(const std::vector<int>& rLow,
   
   if (SI.calcRenumber(rLow,rHigh,10000,ChangeList))
     {
+      std::map<int,int> RMap;
       std::vector< std::pair<int,int> >::const_iterator dc;
       for(dc=ChangeList.begin();dc!=ChangeList.end();dc++)
 	{
 	  ELog::RN<<"Surf Change:"<<dc->first<<" "<<dc->second<<ELog::endDiag;
-	  SI.renumber(dc->first,dc->second);
-	  substituteAllSurface(dc->first,dc->second);		    
+	  if (dc->first!=dc->second)
+	    RMap.emplace(dc->first,dc->second);
 	}
+      SI.renumber(RMap);
+      substituteAllSurface(RMap);
     }
   return;
 }
@@ -2300,13 +2467,14 @@ Simulation::masterRotation()
 
   ModelSupport::objectRegister& OR=
     ModelSupport::objectRegister::Instance();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
 
   masterRotate& MR = masterRotate::Instance();
   
-  const ModelSupport::surfIndex::STYPE& SurMap=
-    ModelSupport::surfIndex::Instance().surMap();
+  const ModelSupport::surfIndex::STYPE& SurMap=SurI.surMap();
 
   std::map<int,Geometry::Surface*>::const_iterator sc;
+  OBIPtr->reset();
   for(sc=SurMap.begin();sc!=SurMap.end();sc++)
     MR.applyFull(sc->second);
 
@@ -2316,7 +2484,8 @@ Simulation::masterRotation()
     MR.applyFull(oc->second);
 
   OR.rotateMaster();
-  
+  // surfaces have moved : rebuild the equal-surface hash
+  SurI.reindex();
   return;
 }
 
@@ -2349,10 +2518,49 @@ Simulation::write(const std::string& Fname) const
   */
 {
   std::ofstream OX(Fname.c_str());
-  
+  writeDeck(OX);
+  OX.close();
+  return;
+}
+
+void
+Simulation::writeDeck(std::ostream& OX) const
+  /*!
+    Write out the full deck (in MCNPX output format)
+    The version number is incremented.
+    \param OX :: Output stream
+  */
+{
+  writeDeckHead(OX,version::Instance().getIncrement());
+  writeDeckBody(OX);
+  writePhysics(OX);
+  return;
+}
+
+void
+Simulation::writeDeckHead(std::ostream& OX,const int vNum) const
+  /*!
+    Write the start of the deck : title and version block
+    \param OX :: Output stream
+    \param vNum :: version number to write
+  */
+{
   OX<<"Input File:"<<inputFile<<std::endl;
   StrFunc::writeMCNPXcomment("RunCmd:"+cmdLine,OX);
-  writeVariables(OX);
+  writeVersion(OX,'c',vNum);
+  return;
+}
+
+void
+Simulation::writeDeckBody(std::ostream& OX) const
+  /*!
+    Write the deck between the version block and
+    the physics cards. This does not depend on the version
+    number or the random number seed.
+    \param OX :: Output stream
+  */
+{
+  writeVariables(OX,'c',0);
   writeCells(OX);
   writeSurfaces(OX);
   writeMaterial(OX);
@@ -2360,7 +2568,5 @@ Simulation::write(const std::string& Fname) const
   writeWeights(OX);
   writeTally(OX);
   writeSource(OX);
-  writePhysics(OX);
-  OX.close();
   return;
 }
@@ -30,6 +30,7 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <array>
 #include <memory>
 #include <boost/multi_array.hpp>
 
@@ -71,12 +72,12 @@
 
 int
 createVTK(const mainSystem::inputParam& IParam,
-	  const Simulation* SimPtr,
+	  Simulation* SimPtr,
 	  const std::string& Oname)
   /*!
     Run the VTK box
     \param IParam :: Inpup parameters
-    \param SimPtr :: Simulation
+    \param SimPtr :: Simulation [ObjSurfMap built for vtkLine]
     \param Oname :: Output name
     \retval +ve : successfull completion 
     \retval -ve : Error of attempted completion
@@ -122,6 +123,12 @@ createVTK(const mainSystem::inputParam& IParam,
 	    VTK.setType(Visit::VISITenum::cellID);
 	  else
 	    VTK.setType(Visit::VISITenum::material);
+	  if (IParam.flag("vtkLine"))
+	    {
+	      // line tracking needs the surface->cell map
+	      SimPtr->createObjSurfMap();
+	      VTK.setLineForm(1);
+	    }
 	  
 	  std::set<std::string> Active;
 	  for(size_t i=0;i<15;i++)
@@ -134,9 +141,13 @@ createVTK(const mainSystem::inputParam& IParam,
 	  // PROCESS VTK:
 	  VTK.setBox(MeshA,MeshB);
 	  VTK.setIndex(MPts[0],MPts[1],MPts[2]);
-	  VTK.populate(SimPtr,Active);
-	  
-	  VTK.writeVTK(Oname);
+	  if (IParam.flag("vtkBinary"))
+	    VTK.writeBinaryVTK(SimPtr,Active,Oname);
+	  else
+	    {
+	      VTK.populate(SimPtr,Active);
+	      VTK.writeVTK(Oname);
+	    }
 	  return 2;
 	}
     }
@@ -53,6 +53,7 @@
 #include "surfRegister.h"
 #include "surfIndex.h"
 #include "HeadRule.h"
+#include "BoundBox.h"
 #include "Object.h"
 #include "Qhull.h"
 #include "varList.h"
@@ -65,6 +66,7 @@
 #include "simpleObj.h"
 #include "Simulation.h"
 #include "World.h"
+#include "AttachSupport.h"
 
 #include "Debug.h"
 
@@ -122,11 +124,13 @@ testAttachSupport::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testAttachSupport::testBoundaryValid,
+      &testAttachSupport::testCheckIntersect,
       &testAttachSupport::testInsertComponent
     };
   const std::string TestName[]=
     {
       "BoundaryValid",
+      "CheckIntersect",
       "InsertComponent"
     };
   
@@ -199,6 +203,84 @@ testAttachSupport::testBoundaryValid()
   return 0;
 }
 
+int
+testAttachSupport::testCheckIntersect()
+  /*!
+    Test the intersection of a ContainedComp with
+    cells that overlap/contain/miss it and with a cell
+    bounded by a slightly tilted plane
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testAttachSupport","testCheckIntersect");
+
+  initSim();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(90001,"px -5");
+  SurI.createSurface(90002,"px 5");
+  SurI.createSurface(90003,"py -1");
+  SurI.createSurface(90004,"py 1");
+  SurI.createSurface(90005,"pz -20");
+  SurI.createSurface(90006,"pz 20");
+  SurI.createSurface(90011,"px 100");
+  SurI.createSurface(90012,"px 110");
+  SurI.createSurface(90013,"so 50");
+  SurI.createSurface(90014,"s 200 0 0 20");
+  
+  std::shared_ptr<testSystem::simpleObj> 
+    CC(new testSystem::simpleObj("A"));
+  CC->createAll(ASim,World::masterOrigin());
+
+  typedef std::tuple<std::string,bool> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("90001 -90002 90003 -90004 90005 -90006",1),  // cuts
+      TTYPE("90011 -90012 90003 -90004 90005 -90006",0),  // far
+      TTYPE("-90013",1),                                  // contains
+      TTYPE("-90014 90003 -90004",0),                     // far sphere
+      TTYPE("90013 -90014",0)                             // shell
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      MonteCarlo::Qhull A(7001,0,0.0,std::get<0>(tc));
+      A.populate();
+      A.createSurfaceList();
+      const bool R=checkIntersect(*CC,A,A.getSurList());
+      if (R!=std::get<1>(tc))
+	{
+	  ELog::EM<<"Failed Test "<<cnt<<" : "<<R<<ELog::endDiag;
+	  ELog::EM<<"Cell == "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Box == "<<A.getBoundBox()<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+
+  // Cell bounded by a plane tilted by 5e-5 : at the far 
+  // object [y=1e4] it is 0.5 beyond the plane distance
+  SurI.createSurface(90015,"p 1 -5e-5 0 -7.9");
+  SurI.createSurface(90016,"px -100");
+  SurI.createSurface(90017,"py 9000");
+  SurI.createSurface(90018,"py 11000");
+  std::shared_ptr<testSystem::simpleObj> 
+    FarCC(new testSystem::simpleObj("B"));
+  FarCC->setOffset(Geometry::Vec3D(0,10000,0));
+  FarCC->createAll(ASim,World::masterOrigin());
+
+  MonteCarlo::Qhull B(7002,0,0.0,"-90015 90016 90017 -90018 90005 -90006");
+  B.populate();
+  B.createSurfaceList();
+  if (!checkIntersect(*FarCC,B,B.getSurList()))
+    {
+      ELog::EM<<"Failed tilted plane cell"<<ELog::endDiag;
+      ELog::EM<<"Box == "<<B.getBoundBox()<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
 int
 testAttachSupport::testInsertComponent()
   /*!
@@ -32,6 +32,8 @@
 #include <string>
 #include <algorithm>
 #include <tuple>
+#include <iterator>
+#include <cstdio>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -43,6 +45,7 @@
 #include "BaseModVisit.h"
 #include "support.h"
 #include "stringCombine.h"
+#include "fileSupport.h"
 #include "RefCon.h"
 #include "Element.h"
 #include "Zaid.h"
@@ -84,11 +87,13 @@ testDBMaterial::applyTest(const int extra)
   typedef int (testDBMaterial::*testPtr)();
   testPtr TPtr[]=
     {
-      &testDBMaterial::testCombine
+      &testDBMaterial::testCombine,
+      &testDBMaterial::testSnapshot
     };
   const std::string TestName[]=
     {
-      "Combine"
+      "Combine",
+      "Snapshot"
     };
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
   if (!extra)
@@ -167,6 +172,94 @@ testDBMaterial::testCombine()
   return 0;
 }
 
-  
-  
+int
+testDBMaterial::testSnapshot()
+  /*!
+    Test the binary snapshot round trip of the material store
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testDBMaterial","testSnapshot");
+
+  const std::string FName(StrFunc::tempPathName("testDBMaterial.snap"));
+  DBMaterial& DB=DBMaterial::Instance();
+
+  // hold the text form of each material
+  std::map<int,std::string> MText;
+  for(const std::map<int,MonteCarlo::Material>::value_type& MI :
+	DB.getStore())
+    {
+      std::ostringstream cx;
+      cx<<MI.second;
+      MText.emplace(MI.first,cx.str());
+    }
+  const int HIndex=DB.getIndex("H2O");
+
+  DB.writeSnapshot(FName);
+  // Wrong file must fail and leave the store
+  if (DB.readSnapshot(FName+".none") ||
+      DB.getStore().size()!=MText.size())
+    {
+      ELog::EM<<"Failed on missing file"<<ELog::endDiag;
+      std::remove(FName.c_str());
+      return -1;
+    }
 
+  // Truncated file / other build stamp must fail and leave the store
+  const std::string TName(FName+".part");
+  std::ifstream IX(FName.c_str(),std::ios::binary);
+  const std::string Buffer((std::istreambuf_iterator<char>(IX)),
+			   std::istreambuf_iterator<char>());
+  IX.close();
+  const std::string TestName[]={"truncated file","stamp"};
+  for(size_t i=0;i<2;i++)
+    {
+      std::string Item(Buffer);
+      if (i)   // first character of the stamp [after its size]
+	Item[sizeof(size_t)]='X';
+      else
+	Item.resize(Buffer.size()/2);
+      std::ofstream OX(TName.c_str(),std::ios::binary);
+      OX.write(Item.data(),static_cast<std::streamsize>(Item.size()));
+      OX.close();
+      const bool partFlag=DB.readSnapshot(TName);
+      std::remove(TName.c_str());
+      if (partFlag || DB.getStore().size()!=MText.size())
+	{
+	  ELog::EM<<"Failed on "<<TestName[i]<<ELog::endDiag;
+	  std::remove(FName.c_str());
+	  return -1;
+	}
+    }
+
+  const bool readFlag=DB.readSnapshot(FName);
+  std::remove(FName.c_str());
+  if (!readFlag)
+    {
+      ELog::EM<<"Failed to read snapshot"<<ELog::endDiag;
+      return -1;
+    }
+
+  if (DB.getStore().size()!=MText.size() ||
+      DB.getIndex("H2O")!=HIndex)
+    {
+      ELog::EM<<"Store size/index changed :"<<DB.getStore().size()
+	      <<" "<<MText.size()<<ELog::endDiag;
+      return -1;
+    }
+  for(const std::map<int,MonteCarlo::Material>::value_type& MI :
+	DB.getStore())
+    {
+      std::ostringstream cx;
+      cx<<MI.second;
+      std::map<int,std::string>::const_iterator mc=MText.find(MI.first);
+      if (mc==MText.end() || mc->second!=cx.str())
+	{
+	  ELog::EM<<"Material "<<MI.first<<" differs"<<ELog::endDiag;
+	  ELog::EM<<"Read :\n"<<cx.str()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
@@ -0,0 +1,249 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testENDF.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "support.h"
+#include "fileSupport.h"
+#include "SQWtable.h"
+#include "SEtable.h"
+
+#include "testFunc.h"
+#include "testENDF.h"
+
+using namespace ENDF;
+
+testENDF::testENDF()
+  /*!
+    Constructor
+   */
+{}
+
+testENDF::~testENDF()
+  /*!
+    Destructor
+  */
+{}
+
+int 
+testENDF::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Index of test
+    \returns -ve on error 0 on success.
+  */
+{
+  ELog::RegMethod RegA("testENDF","applyTest");
+  TestFunc::regSector("testENDF");
+
+  typedef int (testENDF::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testENDF::testSabBatch,
+      &testENDF::testSECache
+    };
+
+  const std::string TestName[]=
+    {
+      "SabBatch",
+      "SECache"
+    };
+
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testENDF::testSabBatch()
+  /*!
+    Test that the batched S(alpha,beta) is the same as
+    the single point form, including points on the grid
+    and points outside the valid range.
+    \retval -1 :: batch/single mismatch
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testENDF","testSabBatch");
+
+  const std::vector<double> AVec({0.1,0.3,0.7,1.2,2.0,3.5});
+  const std::vector<double> BVec({0.0,0.25,0.6,1.0,1.8});
+
+  SQWtable SQ;
+  SQ.setNAlpha(AVec.size());
+  SQ.setNBeta(BVec.size());
+  SQ.Beta=BVec;
+  for(size_t j=0;j<BVec.size();j++)
+    {
+      std::vector<double> SVec;
+      for(size_t i=0;i<AVec.size();i++)
+	SVec.push_back(exp(-AVec[i]-0.5*BVec[j])*(1.0+0.1*static_cast<double>(i*j)));
+      SQ.setData(j,AVec,SVec);
+    }
+
+  // smooth path / grid points / jumps / out of range 
+  std::vector<double> alphaV,betaV;
+  for(size_t i=0;i<40;i++)
+    {
+      alphaV.push_back(0.05+0.09*static_cast<double>(i));
+      betaV.push_back(-0.1+0.05*static_cast<double>(i));
+    }
+  for(size_t i=0;i<AVec.size();i++)
+    for(size_t j=0;j<BVec.size();j++)
+      {
+	alphaV.push_back(AVec[i]);
+	betaV.push_back(BVec[j]);
+      }
+  for(size_t i=0;i<30;i++)
+    {
+      alphaV.push_back(0.15+static_cast<double>((i*7) % 11)*0.2);
+      betaV.push_back(0.05+static_cast<double>((i*5) % 9)*0.1);
+    }
+
+  std::vector<double> SOut;
+  SQ.Sab(alphaV,betaV,SOut);
+  size_t nonZero(0);
+  for(size_t i=0;i<alphaV.size();i++)
+    {
+      const double S=SQ.Sab(alphaV[i],betaV[i]);
+      if (S!=0.0) nonZero++;
+      if (S!=SOut[i])
+	{
+	  ELog::EM<<"Point["<<i<<"] "<<alphaV[i]<<" "<<betaV[i]
+		  <<ELog::endDiag;
+	  ELog::EM<<"Single == "<<S<<ELog::endDiag;
+	  ELog::EM<<"Batch  == "<<SOut[i]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  if (!nonZero || nonZero==alphaV.size())
+    {
+      ELog::EM<<"Range not tested : "<<nonZero<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testENDF::testSECache()
+  /*!
+    Test that the SEtable is the same after a round trip
+    through a cache file and that a truncated cache fails
+    \retval -1 :: failed to write/read
+    \retval -2 :: table changed
+    \retval -3 :: truncated cache accepted
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testENDF","testSECache");
+
+  SEtable SA;
+  for(size_t i=1;i<50;i++)
+    {
+      const double E(0.004*static_cast<double>(i*i));
+      SA.addEnergy(E,20.0/sqrt(E)+static_cast<double>(i % 3));
+    }
+
+  const std::string FName(StrFunc::tempFileName("testENDF.SEcache"));
+  {
+    std::ofstream OX(FName.c_str(),std::ios::binary);
+    SA.writeBinary(OX);
+  }
+  std::string full;
+  {
+    std::ifstream IX(FName.c_str(),std::ios::binary);
+    std::ostringstream cx;
+    cx<<IX.rdbuf();
+    full=cx.str();
+  }
+  std::remove(FName.c_str());
+
+  SEtable SB;
+  std::istringstream IX(full);
+  if (!SB.readBinary(IX))
+    {
+      ELog::EM<<"Failed to read cache :"<<full.size()<<ELog::endDiag;
+      return -1;
+    }
+  if (SA.getE()!=SB.getE())
+    {
+      ELog::EM<<"Energy size "<<SA.getE().size()<<" "
+	      <<SB.getE().size()<<ELog::endDiag;
+      return -2;
+    }
+  for(size_t i=0;i<300;i++)
+    {
+      const double E(0.001+0.035*static_cast<double>(i));
+      if (SA.STotal(E)!=SB.STotal(E))
+	{
+	  ELog::EM<<"STotal["<<E<<"] "<<SA.STotal(E)<<" "
+		  <<SB.STotal(E)<<ELog::endDiag;
+	  return -2;
+	}
+    }
+
+  SEtable SC;
+  std::istringstream TX(full.substr(0,full.size()-5));
+  if (SC.readBinary(TX) || !SC.getE().empty())
+    {
+      ELog::EM<<"Truncated cache read"<<ELog::endDiag;
+      return -3;
+    }
+  return 0;
+}
@@ -32,6 +32,9 @@
 #include <algorithm>
 #include <iterator>
 #include <tuple>
+#include <set>
+#include <memory>
+#include <chrono>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -43,10 +46,21 @@
 #include "Matrix.h"
 #include "Vec3D.h"
 #include "support.h"
+#include "surfRegister.h"
 #include "funcList.h"
 #include "varList.h"
 #include "Code.h"
+#include "FItem.h"
 #include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "inputParam.h"
+#include "MainInputs.h"
+#include "Simulation.h"
+#include "LinkUnit.h"
+#include "FixedComp.h"
+#include "World.h"
+#include "variableSetup.h"
+#include "makeESS.h"
 
 #include "testFunc.h"
 #include "testFunction.h"
@@ -82,10 +96,14 @@ testFunction::applyTest(const int extra)
       &testFunction::testBuiltIn,
       &testFunction::testCopyVarSet,
       &testFunction::testEval,
+      &testFunction::testEvalCache,
+      &testFunction::testLookup,
       &testFunction::testString, 
       &testFunction::testVariable,
       &testFunction::testVec3D,
-      &testFunction::testVec3DFunctions
+      &testFunction::testVec3DFunctions,
+      // benchmarks : only run when selected
+      &testFunction::testLookupTiming
     };
 
   const std::string TestName[]=
@@ -94,13 +112,17 @@ testFunction::applyTest(const int extra)
       "BuiltIn",
       "CopyVarSet",
       "Eval",
+      "EvalCache",
+      "Lookup",
       "String",
       "Variable",
       "Vec3D",
-      "Vec3DFunctions"
+      "Vec3DFunctions",
+      "LookupTiming"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  const int NTiming(1);
   if (!extra)
     {
       std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
@@ -113,7 +135,7 @@ testFunction::applyTest(const int extra)
     }
   for(int i=0;i<TSize;i++)
     {
-      if (extra<0 || extra==i+1)
+      if ((extra<0 && i<TSize-NTiming) || extra==i+1)
         {
 	  TestFunc::regTest(TestName[i]);
 	  const int retValue= (this->*TPtr[i])();
@@ -241,6 +263,81 @@ testFunction::testCopyVarSet()
 }
 
 
+int
+testFunction::testEvalCache()
+  /*!
+    Test the cached function values are cleared when 
+    an input variable [direct or indirect] changes and 
+    that inputs are active again after resetActive
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testFunction","testEvalCache");
+
+  FuncDataBase XX;
+  XX.addVariable("a",2.0);
+  XX.Parse("a*3");
+  XX.addVariable("bb");
+  // [single letter name before +/- is read as an exponent]
+  XX.Parse("bb+1");
+  XX.addVariable("c");
+  XX.addVariable("v",Geometry::Vec3D(1,2,3));
+  XX.Parse("v*a");
+  XX.addVariable("w");
+
+  const FFunc* CPtr=dynamic_cast<const FFunc*>(XX.findItem("c"));
+  if (!CPtr || CPtr->isCached())
+    {
+      ELog::EM<<"Function c cached before evaluation"<<ELog::endDiag;
+      return -1;
+    }
+  const double cA=XX.EvalVar<double>("c");
+  const Geometry::Vec3D wA=XX.EvalVar<Geometry::Vec3D>("w");
+  const bool cacheA=CPtr->isCached();
+
+  XX.setVariable("a",5.0);
+  const bool cacheB=CPtr->isCached();
+  const double cB=XX.EvalVar<double>("c");
+  const Geometry::Vec3D wB=XX.EvalVar<Geometry::Vec3D>("w");
+
+  XX.setVariable("v",Geometry::Vec3D(0,0,1));
+  const Geometry::Vec3D wC=XX.EvalVar<Geometry::Vec3D>("w");
+
+  // copy is independent of the original
+  FuncDataBase YY(XX);
+  YY.setVariable("a",1.0);
+  const double cYY=YY.EvalVar<double>("c");
+  const double cXX=XX.EvalVar<double>("c");
+  
+  if (!cacheA || cacheB ||
+      std::abs(cA-7.0)>1e-8 || std::abs(cB-16.0)>1e-8 ||
+      wA.Distance(Geometry::Vec3D(2,4,6))>1e-8 ||
+      wB.Distance(Geometry::Vec3D(5,10,15))>1e-8 ||
+      wC.Distance(Geometry::Vec3D(0,0,5))>1e-8 ||
+      std::abs(cYY-4.0)>1e-8 || std::abs(cXX-16.0)>1e-8)
+    {
+      ELog::EM<<"Cache     "<<cacheA<<" "<<cacheB<<ELog::endDiag;
+      ELog::EM<<"c         "<<cA<<" "<<cB<<ELog::endDiag;
+      ELog::EM<<"w         "<<wA<<" : "<<wB<<" : "<<wC<<ELog::endDiag;
+      ELog::EM<<"Copy c    "<<cYY<<" "<<cXX<<ELog::endDiag;
+      return -1;
+    }
+
+  // after resetActive the inputs of a cached function 
+  // must be marked active again [for writeVariables]
+  XX.resetActive();
+  XX.EvalVar<double>("c");
+  const FItem* APtr=XX.findItem("a");
+  const FItem* BPtr=XX.findItem("bb");
+  if (!APtr || !BPtr || !APtr->isActive() || !BPtr->isActive())
+    {
+      ELog::EM<<"Input variables not active after resetActive"
+	      <<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
 int
 testFunction::testEval()
   /*!
@@ -289,6 +386,188 @@ testFunction::testEval()
 }
 
 
+int
+testFunction::testLookup()
+  /*!
+    Test the hashed two part variable lookup against
+    building the full name. The variable set is the 
+    same size as the ESS variable set.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testFunction","testLookup");
+
+  const std::vector<std::string> Tail=
+    {"Length","Width","Height","Depth","XStep","YStep","ZStep",
+     "XYAngle","ZAngle","WallThick","WallMat","Mat","NLayers",
+     "Radius","FrontThick","BackThick"};
+  const size_t NComp(2500);
+
+  FuncDataBase XX;
+  std::vector<std::string> KeyName;
+  for(size_t i=0;i<NComp;i++)
+    {
+      KeyName.push_back("essComp"+std::to_string(i));
+      for(size_t j=0;j<Tail.size();j++)
+	if ((i+j) % 3)
+	  XX.addVariable(KeyName.back()+Tail[j],static_cast<double>(i*j));
+    }
+  XX.addVariable("essCompBase"+Tail[0],-1.0);
+  // replace/remove must keep the index consistent
+  XX.addVariable("essComp7Width",Geometry::Vec3D(1,0,0));
+  XX.addVariable("essComp7Width",70.0);
+  XX.removeVariable("essComp9Width");
+
+  // check against full name
+  for(size_t i=0;i<NComp;i++)
+    for(const std::string& TItem : Tail)
+      {
+	const FItem* APtr=XX.findItem(KeyName[i]+TItem);
+	const FItem* BPtr=XX.findItem(KeyName[i],TItem);
+	if (APtr!=BPtr || (!APtr && XX.hasVariable(KeyName[i]+TItem)))
+	  {
+	    ELog::EM<<"Lookup failed :"<<KeyName[i]+TItem<<ELog::endDiag;
+	    return -1;
+	  }
+      }
+  if (XX.EvalVar<double>("essComp7Width")!=70.0 ||
+      XX.findItem("essComp9","Width") ||
+      XX.EvalPair<double>("essComp3","essCompBase",Tail[0])!=-1.0)
+    {
+      ELog::EM<<"Replace/remove failed "<<ELog::endDiag;
+      return -1;
+    }
+
+  // model build traffic : EvalDefPair(keyName,baseName,tail)
+  double sumA(0.0);
+  double sumB(0.0);
+  for(size_t i=0;i<NComp;i++)
+    for(const std::string& TItem : Tail)
+      {
+	sumA+=XX.EvalDefVar<double>(KeyName[i]+TItem,
+		     XX.EvalDefVar<double>(KeyName[0]+TItem,0.0));
+	sumB+=XX.EvalDefPair<double>(KeyName[i],KeyName[0],TItem,0.0);
+      }
+
+  if (std::abs(sumA-sumB)>1e-6*std::abs(sumA))
+    {
+      ELog::EM<<"Sum difference "<<sumA<<" "<<sumB<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testFunction::testLookupTiming()
+  /*!
+    Timing of the variable lookup [benchmark]. The real
+    ESS variable set is built [EssVariables] and the reads 
+    of makeESS::build are replayed against the hash index
+    and against an ordered map [the store before the hash].
+    The pair lookup is then timed against building the full
+    name on a synthetic set of the same size.
+    \return 0
+  */
+{
+  ELog::RegMethod RegA("testFunction","testLookupTiming");
+
+  typedef std::chrono::high_resolution_clock CLK;
+  typedef std::chrono::duration<double> DTYPE;
+
+  mainSystem::inputParam IParam;
+  mainSystem::createESSInputs(IParam);
+
+  Simulation ASim;
+  FuncDataBase& Control=ASim.getDataBase();
+  const CLK::time_point tA=CLK::now();
+  setVariable::EssVariables(Control,std::set<std::string>());
+  Control.resetActive();
+  const CLK::time_point tB=CLK::now();
+  essSystem::makeESS ESSObj;
+  World::createOuterObjects(ASim);
+  ESSObj.build(ASim,IParam);
+  const CLK::time_point tC=CLK::now();
+
+  // variable traffic of the build : each read name by its count
+  const varList& VL=Control.getVarList();
+  std::map<std::string,const FItem*> MapStore;
+  std::vector<std::string> Traffic;
+  for(const varList::varStore::value_type& VItem : VL)
+    {
+      MapStore.emplace(VItem.first,VItem.second);
+      for(int i=0;i<VItem.second->isActive();i++)
+	Traffic.push_back(VItem.first);
+    }
+  std::random_shuffle(Traffic.begin(),Traffic.end());
+
+  const size_t NLoop(20);
+  size_t cntA(0);
+  size_t cntB(0);
+  const CLK::time_point tD=CLK::now();
+  for(size_t loop=0;loop<NLoop;loop++)
+    for(const std::string& Name : Traffic)
+      if (Control.findItem(Name)) cntA++;
+  const CLK::time_point tE=CLK::now();
+  for(size_t loop=0;loop<NLoop;loop++)
+    for(const std::string& Name : Traffic)
+      if (MapStore.find(Name)!=MapStore.end()) cntB++;
+  const CLK::time_point tF=CLK::now();
+
+  const double scaleT(1e9/static_cast<double>
+		      (NLoop*std::max<size_t>(Traffic.size(),1)));
+  ELog::EM<<"ESS variables == "<<MapStore.size()
+	  <<" : build reads == "<<Traffic.size()<<"\n"
+	  <<"EssVariables (s) == "
+	  <<std::chrono::duration_cast<DTYPE>(tB-tA).count()<<"\n"
+	  <<"makeESS::build (s) == "
+	  <<std::chrono::duration_cast<DTYPE>(tC-tB).count()<<"\n"
+	  <<"Build reads : hash (ns/call) == "
+	  <<scaleT*std::chrono::duration_cast<DTYPE>(tE-tD).count()<<"\n"
+	  <<"Build reads : map (ns/call) == "
+	  <<scaleT*std::chrono::duration_cast<DTYPE>(tF-tE).count()
+	  <<" ["<<cntA<<" "<<cntB<<"]"<<ELog::endDiag;
+
+  // model build traffic : EvalDefPair(keyName,baseName,tail)
+  const std::vector<std::string> Tail=
+    {"Length","Width","Height","Depth","XStep","YStep","ZStep",
+     "XYAngle","ZAngle","WallThick","WallMat","Mat","NLayers",
+     "Radius","FrontThick","BackThick"};
+  const size_t NComp(MapStore.size()/Tail.size()+1);
+
+  FuncDataBase XX;
+  std::vector<std::string> KeyName;
+  for(size_t i=0;i<NComp;i++)
+    {
+      KeyName.push_back("essComp"+std::to_string(i));
+      for(size_t j=0;j<Tail.size();j++)
+	if ((i+j) % 3)
+	  XX.addVariable(KeyName.back()+Tail[j],static_cast<double>(i*j));
+    }
+
+  double sumA(0.0);
+  double sumB(0.0);
+  const CLK::time_point tG=CLK::now();
+  for(size_t loop=0;loop<NLoop;loop++)
+    for(size_t i=0;i<NComp;i++)
+      for(const std::string& TItem : Tail)
+	sumA+=XX.EvalDefVar<double>(KeyName[i]+TItem,
+		     XX.EvalDefVar<double>(KeyName[0]+TItem,0.0));
+  const CLK::time_point tH=CLK::now();
+  for(size_t loop=0;loop<NLoop;loop++)
+    for(size_t i=0;i<NComp;i++)
+      for(const std::string& TItem : Tail)
+	sumB+=XX.EvalDefPair<double>(KeyName[i],KeyName[0],TItem,0.0);
+  const CLK::time_point tI=CLK::now();
+
+  const double scale(1e9/static_cast<double>(NLoop*NComp*Tail.size()));
+  ELog::EM<<"Full name lookup (ns/call) == "
+	  <<scale*std::chrono::duration_cast<DTYPE>(tH-tG).count()<<"\n"
+	  <<"Pair/tail lookup (ns/call) == "
+	  <<scale*std::chrono::duration_cast<DTYPE>(tI-tH).count()
+	  <<" ["<<sumA-sumB<<"]"<<ELog::endDiag;
+  return 0;
+}
+
 int
 testFunction::testString()
   /*!
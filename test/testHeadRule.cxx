@@ -128,6 +128,7 @@ testHeadRule::applyTest(const int extra)
       &testHeadRule::testPartEqual,
       &testHeadRule::testRemoveSurf,
       &testHeadRule::testReplacePart,
+      &testHeadRule::testSubstituteSurf,
       &testHeadRule::testSurfSet
     };
   const std::string TestName[]=
@@ -144,6 +145,7 @@ testHeadRule::applyTest(const int extra)
       "PartEqual",
       "RemoveSurf",      
       "ReplacePart",      
+      "SubstituteSurf",
       "SurfSet"
     };
   
@@ -783,6 +785,50 @@ testHeadRule::testRemoveSurf()
   return 0;
 }
 
+int
+testHeadRule::testSubstituteSurf()
+  /*!
+    Check the substitution of a map of surfaces in one pass.
+    New numbers can be old numbers.
+    \return 0 :: success / -ve on error
+   */
+{
+  ELog::RegMethod RegA("testHeadRule","testSubstituteSurf");
+
+  createSurfaces();
+
+  typedef std::tuple<std::string,std::map<int,int>,std::string,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("1 -2 3 -4",{{1,2},{2,1}},"2 -1 3 -4",2),
+      TTYPE("1 -2 (3 : -4) #(5 -6)",{{1,11},{2,1},{4,14},{5,-15}},
+	    "11 -1 (3 : -14) #(-15 -6)",4),
+      TTYPE("1 -2 1",{{1,12}},"12 -2 12",2),
+      TTYPE("1 -2",{{3,13}},"1 -2",0)
+    };
+  
+  HeadRule A;
+  HeadRule B;
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      A.procString(std::get<0>(tc));
+      B.procString(std::get<2>(tc));
+      const int NS=A.substituteSurf(std::get<1>(tc));
+      if (B!=A || NS!=std::get<3>(tc))
+	{
+	  ELog::EM<<"Test Failed:"<<cnt<<ELog::endDiag;
+	  ELog::EM<<"A:"<<A.display()<<ELog::endDiag;
+	  ELog::EM<<"B:"<<B.display()<<ELog::endDiag;
+	  ELog::EM<<"N:"<<NS<<" "<<std::get<3>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testHeadRule::testSurfSet()
   /*!
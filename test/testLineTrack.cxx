@@ -71,8 +71,13 @@
 #include "ModelSupport.h"
 #include "neutron.h"
 #include "Simulation.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
 #include "LineTrack.h"
 #include "Cone.h"
+#include "ThreadControl.h"
 
 #include "testFunc.h"
 #include "testLineTrack.h"
@@ -195,11 +200,15 @@ testLineTrack::applyTest(const int extra)
   typedef int (testLineTrack::*testPtr)();
   testPtr TPtr[]=
     {
-      &testLineTrack::testLine
+      &testLineTrack::testAttnSum,
+      &testLineTrack::testLine,
+      &testLineTrack::testThreadTrack
     };
   const std::string TestName[]=
     {
-      "Line"
+      "AttnSum",
+      "Line",
+      "ThreadTrack"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -274,6 +283,134 @@ testLineTrack::testLine()
   return 0;
 }
 
+int
+testLineTrack::testAttnSum()
+  /*!
+    Tests the one pass attenuation sum of a track against
+    the material by material calculation
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testLineTrack","testAttnSum");
+
+  initSim();
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+
+  const size_t NPts(2000);
+  std::vector<LineTrack> LTVec;
+  for(size_t i=0;i<NPts;i++)
+    {
+      const double theta(M_PI*static_cast<double>(i)/NPts);
+      const double phi(11.0*M_PI*static_cast<double>(i)/NPts);
+      LTVec.push_back(LineTrack(Geometry::Vec3D(0.1,0.2,0.3),
+				Geometry::Vec3D(sin(theta)*cos(phi),
+						sin(theta)*sin(phi),
+						cos(theta))*20.0));
+      LTVec.back().calculate(ASim);
+    }
+
+  // material by material sum
+  std::vector<double> matSum;
+  for(const LineTrack& LT : LTVec)
+    {
+      const std::vector<MonteCarlo::Object*>& OVec=LT.getObjVec();
+      const std::vector<double>& TVec=LT.getTrack();
+      double sum(0.0);
+      for(size_t j=0;j<TVec.size();j++)
+	{
+	  const int matN=OVec[j]->getMat();
+	  if (matN)
+	    {
+	      const MonteCarlo::Material& matInfo=DB.getMaterial(matN);
+	      sum+=TVec[j]*matInfo.getAtomDensity()*
+		std::pow(matInfo.getMeanA(),0.66);
+	    }
+	}
+      matSum.push_back(sum);
+    }
+  std::vector<double> tableSum;
+  for(const LineTrack& LT : LTVec)
+    tableSum.push_back(LT.getAttnSum());
+
+  for(size_t i=0;i<NPts;i++)
+    if (std::abs(matSum[i]-tableSum[i])>1e-10*(1.0+matSum[i]))
+      {
+	ELog::EM<<"Failed on line "<<i<<ELog::endDiag;
+	ELog::EM<<"Material == "<<matSum[i]<<" table == "
+		<<tableSum[i]<<ELog::endDiag;
+	return -1;
+      }
+  if (matSum[NPts/4]<1e-5)
+    {
+      ELog::EM<<"Line not attenuated :"<<matSum[NPts/4]<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testLineTrack::testThreadTrack()
+  /*!
+    Tracks a fan of lines through the system over 
+    several threads and checks the result against the 
+    serial calculation
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testLineTrack","testThreadTrack");
+
+  initSim();
+
+  const size_t NPts(500);
+  std::vector<Geometry::Vec3D> EndPts;
+  for(size_t i=0;i<NPts;i++)
+    {
+      const double theta(M_PI*static_cast<double>(i)/NPts);
+      const double phi(7.0*M_PI*static_cast<double>(i)/NPts);
+      EndPts.push_back(Geometry::Vec3D(sin(theta)*cos(phi),
+				       sin(theta)*sin(phi),
+				       cos(theta))*20.0);
+    }
+  const Geometry::Vec3D InitPt(0.1,0.2,0.3);
+
+  std::vector<double> serialTrack(NPts);
+  std::vector<double> threadTrack(NPts);
+  // sum of cell*track for each line
+  auto trackBlock=[&](std::vector<double>& Out,
+		      const size_t A,const size_t B)
+    {
+      for(size_t i=A;i<B;i++)
+	{
+	  LineTrack LT(InitPt,EndPts[i]);
+	  LT.calculate(ASim);
+	  const std::vector<long int>& cells=LT.getCells();
+	  const std::vector<double>& tLen=LT.getTrack();
+	  Out[i]=0.0;
+	  for(size_t j=0;j<cells.size();j++)
+	    Out[i]+=tLen[j]*static_cast<double>(cells[j]);
+	}
+    };
+
+  trackBlock(serialTrack,0,NPts);
+
+  ThreadControl::setThreads(4);
+  ThreadControl::runBlocks
+    (NPts,7,[&](const size_t A,const size_t B)
+     { trackBlock(threadTrack,A,B); });
+  ThreadControl::setThreads(1);
+
+  for(size_t i=0;i<NPts;i++)
+    if (serialTrack[i]!=threadTrack[i])
+      {
+	ELog::EM<<"Failed on line "<<i<<" "<<EndPts[i]<<ELog::endDiag;
+	ELog::EM<<"Serial == "<<serialTrack[i]<<" thread == "
+		<<threadTrack[i]<<ELog::endDiag;
+	return -1;
+      }
+  return 0;
+}
+
 int
 testLineTrack::checkResult(const LineTrack& LT,
 			   const long int CSum,const double TSum) const
@@ -30,6 +30,10 @@
 #include <complex>
 #include <string>
 #include <algorithm>
+#include <cstdio>
+#include <chrono>
+#include <functional>
+#include <thread>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -37,6 +41,8 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "fileSupport.h"
+#include "ThreadControl.h"
 
 #include "testFunc.h"
 #include "testLog.h" 
@@ -65,14 +71,24 @@ testLog::applyTest(const int extra)
   typedef int (testLog::*testPtr)();
   testPtr TPtr[]=
     {
-      &testLog::testENDL
+      &testLog::testENDL,
+      &testLog::testRegMethod,
+      &testLog::testThreadLog,
+      &testLog::testTrace,
+      // benchmarks : only run when selected
+      &testLog::testRegTiming
     };
   const std::string TestName[]=
     {
-      "ENDL"
+      "ENDL",
+      "RegMethod",
+      "ThreadLog",
+      "Trace",
+      "RegTiming"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  const int NTiming(1);
   if (!extra)
     {
       std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
@@ -85,7 +101,7 @@ testLog::applyTest(const int extra)
     }
   for(int i=0;i<TSize;i++)
     {
-      if (extra<0 || extra==i+1)
+      if ((extra<0 && i<TSize-NTiming) || extra==i+1)
         {
 	  TestFunc::regTest(TestName[i]);
 	  const int retValue= (this->*TPtr[i])();
@@ -130,3 +146,261 @@ testLog::testENDL()
   ELog::EM<<"END of EMPTY LINE:"<<ELog::endDebug;
   return 0;
 }
+
+int
+testLog::testRegMethod()
+  /*!
+    Test the stack of the RegMethod with literal and 
+    built names and the exception location
+    \retval -1 :: failed
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testLog","testRegMethod");
+
+  const std::string Extra("Item");
+  std::string Location;
+  {
+    ELog::RegMethod RegB("testLog","inner:"+Extra);
+    ELog::RegMethod RegC("testLog","param",3);
+    if (ELog::RegMethod::getBase()!="testLog<3>::param" ||
+	ELog::RegMethod::getItem(-1)!="testLog::inner:Item")
+      {
+	ELog::EM<<"Base == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+	ELog::EM<<"Item == "<<ELog::RegMethod::getItem(-1)<<ELog::endDiag;
+	return -1;
+      }
+    try
+      {
+	throw ColErr::ExitAbort("testRegMethod");
+      }
+    catch (ColErr::ExitAbort& EA)
+      {
+	Location=EA.what();
+      }
+  }
+  if (ELog::RegMethod::getBase()!="testLog::testRegMethod")
+    {
+      ELog::EM<<"Base == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+      return -1;
+    }
+  if (Location.find("testLog::inner:Item")==std::string::npos ||
+      Location.find("testLog<3>::param")==std::string::npos)
+    {
+      ELog::EM<<"Location == "<<Location<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testLog::testRegTiming()
+  /*!
+    Timing of the RegMethod registration [benchmark]. The 
+    literal names [normal use] are compared to built names,
+    to the string copies of the stack and to tracing off.
+    \return 0
+   */
+{
+  ELog::RegMethod RegA("testLog","testRegTiming");
+
+  typedef std::chrono::high_resolution_clock CLK;
+  const size_t NLoop(2000000);
+  const std::string CName("testLog");
+  const std::string MName("testRegTiming");
+
+  // string copy stack : the cost before pointer registration
+  std::vector<std::string> CStack;
+  std::vector<std::string> MStack;
+  const CLK::time_point tA=CLK::now();
+  for(size_t i=0;i<NLoop;i++)
+    {
+      CStack.push_back(CName);
+      MStack.push_back(MName);
+      CStack.pop_back();
+      MStack.pop_back();
+    }
+  const CLK::time_point tB=CLK::now();
+  for(size_t i=0;i<NLoop;i++)
+    {
+      ELog::RegMethod RegB("testLog","testRegTiming");
+    }
+  const CLK::time_point tC=CLK::now();
+  for(size_t i=0;i<NLoop;i++)
+    {
+      ELog::RegMethod RegB(CName,MName);
+    }
+  const CLK::time_point tD=CLK::now();
+  ELog::RegMethod::setTrace(0);
+  for(size_t i=0;i<NLoop;i++)
+    {
+      ELog::RegMethod RegB("testLog","testRegTiming");
+    }
+  const CLK::time_point tE=CLK::now();
+  for(size_t i=0;i<NLoop;i++)
+    {
+      ELog::RegMethod RegB(CName,MName);
+    }
+  const CLK::time_point tF=CLK::now();
+  ELog::RegMethod::setTrace(1);
+
+  const double scale(1e9/static_cast<double>(NLoop));
+  typedef std::chrono::duration<double> DTYPE;
+  ELog::EM<<"String stack (ns/call) == "
+	  <<scale*std::chrono::duration_cast<DTYPE>(tB-tA).count()<<"\n"
+	  <<"Literal RegMethod (ns/call) == "
+	  <<scale*std::chrono::duration_cast<DTYPE>(tC-tB).count()<<"\n"
+	  <<"String RegMethod (ns/call) == "
+	  <<scale*std::chrono::duration_cast<DTYPE>(tD-tC).count()<<"\n"
+	  <<"Literal RegMethod [noTrace] (ns/call) == "
+	  <<scale*std::chrono::duration_cast<DTYPE>(tE-tD).count()<<"\n"
+	  <<"String RegMethod [noTrace] (ns/call) == "
+	  <<scale*std::chrono::duration_cast<DTYPE>(tF-tE).count()
+	  <<ELog::endDiag;
+  return 0;
+}
+
+int
+testLog::testThreadLog()
+  /*!
+    Test that messages written to a log from many threads
+    are each reported complete 
+    \retval -1 :: message lost/interleaved
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testLog","testThreadLog");
+
+  const size_t NItem(2000);
+  const std::string FName(StrFunc::tempFileName("testThreadLog.log"));
+  {
+    ELog::OutputLog<ELog::FileReport> TLog(FName);
+    TLog.setLocFlag(0);
+    TLog.setTypeFlag(0);
+    
+    ModelSupport::ThreadControl::setThreads(4);
+    ModelSupport::ThreadControl::runBlocks
+      (NItem,7,[&TLog](const size_t A,const size_t B)
+       {
+	 for(size_t i=A;i<B;i++)
+	   TLog<<"Msg "<<i<<" == "<<3*i<<" :: "<<i+1<<ELog::endBasic;
+       });
+    ModelSupport::ThreadControl::setThreads(1);
+  }
+
+  std::vector<int> Found(NItem,0);
+  std::ifstream IX(FName.c_str());
+  std::string Line;
+  size_t NLine(0);
+  while(std::getline(IX,Line))
+    {
+      std::istringstream cx(Line);
+      std::string Msg,Eq,Sep;
+      size_t I,J,K;
+      if (!(cx>>Msg>>I>>Eq>>J>>Sep>>K) || Msg!="Msg" || I>=NItem ||
+	  J!=3*I || K!=I+1)
+	{
+	  ELog::EM<<"Bad line : "<<Line<<ELog::endDiag;
+	  IX.close();
+	  std::remove(FName.c_str());
+	  return -1;
+	}
+      Found[I]++;
+      NLine++;
+    }
+  IX.close();
+  std::remove(FName.c_str());
+
+  if (NLine!=NItem ||
+      std::find(Found.begin(),Found.end(),0)!=Found.end())
+    {
+      ELog::EM<<"Lines == "<<NLine<<" / "<<NItem<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testLog::testTrace()
+  /*!
+    Test that with tracing off a RegMethod does not
+    change the stack, that an empty stack [new thread]
+    gives a safe exception location and that an exception
+    keeps the frames it unwinds
+    \retval -1 :: failed
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testLog","testTrace");
+
+  const ELog::NameStack* NS=RegA.getBasePtr();
+  const size_t depth(NS->getDepth());
+  const long int indent(NS->indent());
+  
+  int retFlag(0);
+  std::string Location("None");
+  ELog::RegMethod::setTrace(0);
+  {
+    ELog::RegMethod RegB("testLog","off");
+    ELog::RegMethod RegC(std::string("testLog"),std::string("off"));
+    ELog::RegMethod RegD("testLog","param",3);
+    RegB.incIndent();
+    if (NS->getDepth()!=depth || NS->indent()!=indent ||
+	ELog::RegMethod::getBase()!="testLog::testTrace")
+      retFlag=-1;
+
+    std::thread TX([&Location]()
+      {
+	ELog::RegMethod RegE("testLog","thread");
+	try
+	  {
+	    throw ColErr::ExitAbort("testTrace");
+	  }
+	catch (ColErr::ExitAbort& EA)
+	  {
+	    Location=EA.what();
+	  }
+      });
+    TX.join();
+  }
+  std::string Unwound;
+  try
+    {
+      ELog::RegMethod RegE("testLog","unwindA");
+      ELog::RegMethod RegF(std::string("testLog"),"unwindB",3);
+      throw ColErr::ExitAbort("testTrace");
+    }
+  catch (ColErr::ExitAbort& EA)
+    {
+      Unwound=EA.what();
+    }
+  ELog::RegMethod::setTrace(1);
+  if (retFlag || NS->getDepth()!=depth)
+    {
+      ELog::EM<<"Depth  == "<<NS->getDepth()<<" ("<<depth<<")"<<ELog::endDiag;
+      ELog::EM<<"Indent == "<<NS->indent()<<" ("<<indent<<")"<<ELog::endDiag;
+      ELog::EM<<"Base   == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+      return -1;
+    }
+  if (Location=="None" || Location.find("testLog::thread")!=std::string::npos)
+    {
+      ELog::EM<<"Location == "<<Location<<ELog::endDiag;
+      return -1;
+    }
+  if (Unwound.find("testLog::unwindA\n  testLog<3>::unwindB")==
+      std::string::npos)
+    {
+      ELog::EM<<"Unwound == "<<Unwound<<ELog::endDiag;
+      return -1;
+    }
+  {
+    ELog::RegMethod RegB("testLog","on");
+    if (NS->getDepth()!=depth+1 ||
+	ELog::RegMethod::getBase()!="testLog::on")
+      {
+	ELog::EM<<"Base == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+	return -1;
+      }
+  }
+  return 0;
+}
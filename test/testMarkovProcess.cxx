@@ -0,0 +1,322 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testMarkovProcess.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Mesh3D.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "Rules.h"
+#include "surfIndex.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "Simulation.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "WWGWeight.h"
+#include "WWG.h"
+#include "MarkovProcess.h"
+
+#include "testFunc.h"
+#include "testMarkovProcess.h"
+
+using namespace WeightSystem;
+
+testMarkovProcess::testMarkovProcess() 
+  /*!
+    Constructor
+  */
+{
+  initSim();
+}
+
+testMarkovProcess::~testMarkovProcess() 
+  /*!
+    Destructor
+  */
+{}
+
+void
+testMarkovProcess::initSim()
+  /*!
+    Set all the objects in the simulation:
+  */
+{
+  ASim.resetAll();
+  createSurfaces();
+  createObjects();
+  ASim.createObjSurfMap();
+  return;
+}
+
+void 
+testMarkovProcess::createSurfaces()
+  /*!
+    Create the surface list
+   */
+{
+  ELog::RegMethod RegA("testMarkovProcess","createSurfaces");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(100,"so 100");
+  SurI.createSurface(1,"px -1");
+  SurI.createSurface(2,"px 1");
+  return;
+}
+  
+void
+testMarkovProcess::createObjects()
+  /*!
+    Create a void sphere split by a steel slab [-1<x<1]
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","createObjects");
+
+  std::string Out;
+  int cellIndex(1);
+  const int surIndex(0);
+  Out=ModelSupport::getComposite(surIndex,"100");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Outside void
+
+  Out=ModelSupport::getComposite(surIndex,"-100 -1");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Void
+  Out=ModelSupport::getComposite(surIndex,"-100 1 -2");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,3,0.0,Out));      // steel slab
+  Out=ModelSupport::getComposite(surIndex,"-100 2");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Void
+  
+  ASim.removeComplements();
+  return;
+}
+
+int 
+testMarkovProcess::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Index of test
+    \returns -ve on error 0 on success.
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","applyTest");
+  TestFunc::regSector("testMarkovProcess");
+
+  typedef int (testMarkovProcess::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testMarkovProcess::testMultiply
+    };
+
+  const std::string TestName[]=
+    {
+      "Multiply"
+    };
+
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testMarkovProcess::testMultiply()
+  /*!
+    Test the sparse matrix and power iteration against
+    the dense form on a 2x2 mesh split by a slab. The high 
+    r2Power case drops the diagonal [14.1cm] pairs by distance
+    and the high attenuation case drops them in the slab.
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","testMultiply");
+
+  // slab attenuation per cm : r2Power : nMult : matrix entries
+  typedef std::tuple<double,double,size_t,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(0.0,2.0,3,16),
+      TTYPE(1.0,2.0,3,16),
+      TTYPE(0.0,8.0,2,12),
+      TTYPE(6.5,2.0,2,12)
+    };
+
+  const double steelAttn=
+    ModelSupport::DBMaterial::Instance().getAttnTable()[3];
+  
+  const size_t NE(2);
+  WWG wSet;
+  wSet.getGrid().setMesh({-10.0,10.0},{2},{-10.0,10.0},{2},
+			 {-1.0,1.0},{1});
+  wSet.calcGridMidPoints();
+  const std::vector<Geometry::Vec3D>& midPts=wSet.getMidPoints();
+  const size_t NF(midPts.size());
+
+  WWGWeight WStart(NE,wSet.getGrid());
+  std::vector<double> logScale(NE,-1e38);
+  for(size_t i=0;i<NF;i++)
+    for(size_t e=0;e<NE;e++)
+      {
+	const double V=static_cast<double>(e)-
+	  0.7*static_cast<double>((i+1)*(e+1));
+	WStart.setLogPoint(static_cast<long int>(i),
+			   static_cast<long int>(e),V);
+	logScale[e]=std::max(logScale[e],V);
+      }
+  const double* startData=WStart.getGrid().data();
+  
+  for(const TTYPE& tc : Tests)
+    {
+      const double slabAttn(std::get<0>(tc));
+      const double r2Power(std::get<1>(tc));
+      const size_t nMult(std::get<2>(tc));
+      
+      MarkovProcess MP;
+      MP.initializeData(wSet);
+      MP.computeMatrix(ASim,wSet,slabAttn/steelAttn,1.0,r2Power);
+      MP.setFlux(WStart);
+      MP.multiplyOut(nMult);
+      WWGWeight WOut(NE,wSet.getGrid());
+      MP.rePopulateWWG(WOut);
+
+      // Dense form [track in slab from the x range of the line]
+      std::vector<std::vector<double>> M(NF,std::vector<double>(NF,0.0));
+      for(size_t i=0;i<NF;i++)
+	for(size_t j=0;j<NF;j++)
+	  {
+	    const double DX=midPts[j].X()-midPts[i].X();
+	    const double R=midPts[i].Distance(midPts[j]);
+	    double slabT(0.0);       // fraction of line in slab
+	    if (std::abs(DX)>1e-8)
+	      {
+		const double tA=(-1.0-midPts[i].X())/DX;
+		const double tB=(1.0-midPts[i].X())/DX;
+		slabT=std::min(1.0,std::max(tA,tB))-
+		  std::max(0.0,std::min(tA,tB));
+		if (slabT<0.0) slabT=0.0;
+	      }
+	    const double D=std::max(1.0,R);
+	    const double WFactor= -slabAttn*R*slabT-r2Power*std::log(D);
+	    if (i==j)
+	      M[i][j]=1.0;
+	    else if (WFactor> -20.0)
+	      M[i][j]=std::exp(WFactor);
+	  }
+
+      std::vector<double> F(NF*NE);
+      for(size_t i=0;i<NF;i++)
+	for(size_t e=0;e<NE;e++)
+	  F[i*NE+e]=std::exp(startData[i*NE+e]-logScale[e]);
+      for(size_t index=0;index<nMult;index++)
+	{
+	  std::vector<double> G(NF*NE,0.0);
+	  std::vector<double> maxG(NE,0.0);
+	  for(size_t i=0;i<NF;i++)
+	    for(size_t e=0;e<NE;e++)
+	      {
+		for(size_t j=0;j<NF;j++)
+		  G[i*NE+e]+=M[i][j]*F[j*NE+e];
+		maxG[e]=std::max(maxG[e],G[i*NE+e]);
+	      }
+	  for(size_t i=0;i<NF;i++)
+	    for(size_t e=0;e<NE;e++)
+	      G[i*NE+e]/=maxG[e];
+	  F.swap(G);
+	}
+
+      if (MP.nEntry()!=std::get<3>(tc) ||
+	  MP.getIteration()!=nMult)
+	{
+	  ELog::EM<<"Attn:r2Power == "<<slabAttn<<" : "
+		  <<r2Power<<ELog::endDiag;
+	  ELog::EM<<"Entries   == "<<MP.nEntry()<<" ("
+		  <<std::get<3>(tc)<<")"<<ELog::endDiag;
+	  ELog::EM<<"Iteration == "<<MP.getIteration()<<" ("
+		  <<nMult<<")"<<ELog::endDiag;
+	  return -1;
+	}
+      
+      const double* outData=WOut.getGrid().data();
+      for(size_t i=0;i<NF*NE;i++)
+	{
+	  const double expect=std::log(F[i])+logScale[i % NE];
+	  if (std::abs(outData[i]-expect)>1e-10*(1.0+std::abs(expect)))
+	    {
+	      ELog::EM<<"Attn:r2Power == "<<slabAttn<<" : "
+		      <<r2Power<<ELog::endDiag;
+	      ELog::EM<<"Point["<<i/NE<<"]["<<i%NE<<"] == "
+		      <<outData[i]<<" ("<<expect<<")"<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+    }
+  return 0;
+}
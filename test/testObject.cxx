@@ -48,6 +48,7 @@
 #include "Vec3D.h"
 #include "Transform.h"
 #include "Surface.h"
+#include "SideCache.h"
 #include "Rules.h"
 #include "Debug.h"
 #include "BnId.h"
@@ -55,6 +56,7 @@
 #include "Algebra.h"
 #include "surfIndex.h"
 #include "HeadRule.h"
+#include "RuleProgram.h"
 #include "Object.h"
 #include "Qhull.h"
 #include "neutron.h"
@@ -180,26 +182,32 @@ testObject::applyTest(const int extra)
   typedef int (testObject::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObject::testAddSurfRule,
       &testObject::testCellStr,
       &testObject::testComplement,
       &testObject::testIsValid,
       &testObject::testIsOnSide,
       &testObject::testMakeComplement,
       &testObject::testRemoveComplement,
+      &testObject::testRuleProgram,
       &testObject::testSetObject,
       &testObject::testSetObjectExtra,
+      &testObject::testSideCache,
       &testObject::testTrackCell
     };
   const std::string TestName[]=
     {
+      "AddSurfRule",
       "CellStr",
       "Complement",
       "IsValid",
       "IsOnSide",
       "MakeComplement",
       "RemoveComplement",
+      "RuleProgram",
       "SetObject",
       "SetObjectExtra",
+      "SideCache",
       "TrackCell"
     };
   
@@ -228,6 +236,63 @@ testObject::applyTest(const int extra)
 }
 
 
+int
+testObject::testAddSurfRule()
+  /*!
+    Test the addition of a rule into a populated cell
+    against the string form of the joined cell
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testAddSurfRule");
+
+  createSurfaces();
+
+  typedef std::tuple<std::string,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("11 -12 13 -14 15 -16","-1 : 2 : -3 : 4 : -5 : 6"),
+      TTYPE("(11 -12 13 -14) : (21 -22 -100)","-1 : 2 : -3 : 4"),
+      TTYPE("-100 #(11 -12 13 -14 15 -16)","-21 : 22")
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      Qhull A;
+      A.setObject("4 10 0.05524655 "+std::get<0>(tc));
+      A.populate();
+      A.addSurfRule(HeadRule(std::get<1>(tc)));
+
+      Qhull B;
+      B.setObject("4 10 0.05524655 ("+std::get<0>(tc)+") ("+
+		  std::get<1>(tc)+")");
+      B.populate();
+      if (!A.isPopulated() || !A.getRuleProgram().isCompiled())
+	{
+	  ELog::EM<<"Failed to keep population : "<<cnt<<ELog::endDiag;
+	  return -1;
+	}
+      for(double x= -16.0;x<17.0;x+=1.0)
+	for(double y= -4.0;y<5.0;y+=1.0)
+	  for(double z= -4.0;z<5.0;z+=2.0)
+	    {
+	      const Geometry::Vec3D Pt(x,y,z);
+	      if (A.isValid(Pt)!=B.isValid(Pt))
+		{
+		  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+		  ELog::EM<<"Point == "<<Pt<<ELog::endDiag;
+		  ELog::EM<<"A == "<<A.str()<<ELog::endDiag;
+		  ELog::EM<<"B == "<<B.str()<<ELog::endDiag;
+		  return -1;
+		}
+	    }
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testObject::testCellStr()
   /*!
@@ -280,6 +345,70 @@ testObject::testCellStr()
 }
 
 
+int
+testObject::testRuleProgram()
+  /*!
+    Test the compiled rule against the rule tree
+    for all the point tests
+    \retval -1 :: failed to compile
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testRuleProgram");
+
+  createSurfaces();
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -6",
+      "4 10 0.05524655  -1 : 2 : -3 : 4 : -5 : 6",
+      "4 10 0.05524655  11 -12 13 -14 15 -16 #(1 -2 3 -4 5 -6)",
+      "4 10 0.05524655  (11 -12 (-1:2) 13 -14) : (21 -22 -100) ",
+      "4 10 0.05524655  -100 #((1 -2 3 -4) : (11 -12 5 -6)) 15 -16"
+    };
+  const std::vector<int> SNum({1,-1,2,-2,5,-6,11,-12,21,100,-100,4});
+
+  int cnt(1);
+  for(const std::string& cellStr : Tests)
+    {
+      Qhull A;
+      A.setObject(cellStr);
+      A.populate();
+      const RuleProgram& RP=A.getRuleProgram();
+      const HeadRule& HR=A.getHeadRule();
+      if (!RP.isCompiled())
+	{
+	  ELog::EM<<"Failed to compile test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"Cell == "<<cellStr<<ELog::endDiag;
+	  return -1;
+	}
+      for(double x= -16.0;x<17.0;x+=1.0)
+	for(double y= -4.0;y<5.0;y+=1.0)
+	  for(double z= -4.0;z<5.0;z+=1.0)
+	    {
+	      const Geometry::Vec3D Pt(x,y,z);
+	      bool fail=(RP.isValid(Pt)!=HR.isValid(Pt));
+	      for(const int SN : SNum)
+		{
+		  fail|= (RP.isValid(Pt,SN)!=HR.isValid(Pt,SN));
+		  fail|= (RP.isDirectionValid(Pt,SN)!=
+			  HR.isDirectionValid(Pt,SN));
+		  fail|= (RP.pairValid(SN,Pt)!=HR.pairValid(SN,Pt));
+		}
+	      if (fail)
+		{
+		  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+		  ELog::EM<<"Cell == "<<cellStr<<ELog::endDiag;
+		  ELog::EM<<"Point == "<<Pt<<ELog::endDiag;
+		  ELog::EM<<"Prog == \n"<<RP<<ELog::endDiag;
+		  return -1;
+		}
+	    }
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testObject::testSetObject() 
   /*!
@@ -538,6 +667,85 @@ testObject::testIsOnSide()
   return 0;
 }
 
+int
+testObject::testSideCache()
+  /*!
+    Test the cached surface sides give the same
+    result as the direct calculation and that a moved
+    surface is recalculated in the next scope
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testSideCache");
+
+  createSurfaces();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+
+  Qhull A;
+  A.setObject("4 10 0.05524655  11 -12 13 -14 15 -16 #(1 -2 3 -4 5 -6)");
+  A.populate();
+  const HeadRule& HR=A.getHeadRule();
+  const std::vector<int> SNum({1,-1,2,-2,5,-6,11,-12});
+
+  for(int move=0;move<2;move++)
+    {
+      for(double x= -4.0;x<5.0;x+=0.5)
+	{
+	  const Geometry::Vec3D Pt(x,0.0,0.5);
+	  std::vector<int> Direct;
+	  Direct.push_back(A.isValid(Pt));
+	  for(const int SN : SNum)
+	    {
+	      Direct.push_back(HR.isValid(Pt,SN));
+	      Direct.push_back(HR.isDirectionValid(Pt,SN));
+	      Direct.push_back(HR.pairValid(SN,Pt));
+	    }
+
+	  const Geometry::SideScope SScope;
+	  std::vector<int> Cached;
+	  // second pass uses the cached sides
+	  for(size_t i=0;i<2;i++)
+	    {
+	      Cached.clear();
+	      Cached.push_back(A.isValid(Pt));
+	      for(const int SN : SNum)
+		{
+		  Cached.push_back(HR.isValid(Pt,SN));
+		  Cached.push_back(HR.isDirectionValid(Pt,SN));
+		  Cached.push_back(HR.pairValid(SN,Pt));
+		}
+	    }
+	  if (Cached!=Direct)
+	    {
+	      ELog::EM<<"Failed on point "<<Pt<<" move "<<move<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+      // same point in a new scope must see the moved surface
+      const Geometry::Vec3D Pt(1.25,0.0,0.5);
+      bool before;
+      {
+	const Geometry::SideScope SScope;
+	before=A.isValid(Pt);
+      }
+      SurI.getSurf(2)->displace(Geometry::Vec3D(0.5,0,0));
+      bool after;
+      {
+	const Geometry::SideScope SScope;
+	after=A.isValid(Pt);
+      }
+      if (before==after || after!=A.isValid(Pt))
+	{
+	  ELog::EM<<"Failed on moved surface : "<<before<<" "
+		  <<after<<ELog::endDiag;
+	  return -1;
+	}
+      SurI.getSurf(2)->displace(Geometry::Vec3D(-0.5,0,0));
+    }
+  return 0;
+}
+
 int
 testObject::testTrackCell() 
   /*!
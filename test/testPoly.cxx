@@ -25,6 +25,7 @@
 #include <sstream>
 #include <cmath>
 #include <complex>
+#include <array>
 #include <list>
 #include <vector>
 #include <map>
@@ -40,6 +41,8 @@
 #include "OutputLog.h"
 #include "PolyFunction.h"
 #include "PolyVar.h"
+#include "PolyFix.h"
+#include "polySupport.h"
 
 #include "testFunc.h"
 #include "testPoly.h"
@@ -82,10 +85,12 @@ testPoly::applyTest(const int extra)
       &testPoly::testDurandKernerRoots,
       &testPoly::testEqualTemplate,
       &testPoly::testExpand,
+      &testPoly::testFixedRoots,
       &testPoly::testGetMaxSize,
       &testPoly::testGetVarFlag,
       &testPoly::testMinimalReduction,
       &testPoly::testMultiplication,
+      &testPoly::testQuarticScale,
       &testPoly::testRead,
       &testPoly::testSetComp,
       &testPoly::testSingleVar,
@@ -104,10 +109,12 @@ testPoly::applyTest(const int extra)
       "DurandKernerRoots",
       "EqualTemplate",
       "Expand",
+      "FixedRoots",
       "GetMaxSize",
       "GetVarFlag",
       "MinimalReduction", 
       "Multiplication",
+      "QuarticScale",
       "Read",
       "SetComp",
       "SingleVar",
@@ -524,6 +531,55 @@ testPoly::testExpand()
   return 0;
 }
 
+int
+testPoly::testFixedRoots()
+  /*!
+    Test the real roots of the fixed degree polynominal
+    \return error number / 0 on success
+   */
+{
+  ELog::RegMethod RegA("testPoly","testFixedRoots");
+
+  // Function / Nroots / smallest / largest roots 
+  typedef std::tuple<std::string,size_t,double,double> TTYPE;
+  const std::vector<TTYPE> Tests =
+    {
+      TTYPE("2x-5",1,2.5,2.5),
+      TTYPE("x^2+x-6",2,-3.0,2.0),
+      TTYPE("x^2+1",0,0.0,0.0),
+      TTYPE("x^3-9x^2+26x-24",3,2.0,4.0),
+      TTYPE("x^3+x",1,0.0,0.0),
+      TTYPE("x^4-14x^3+71x^2-154x+120",4,2.0,5.0),
+      TTYPE("x^4-11x^3+44x^2-76x+48",3,2.0,4.0),  // repeat roots
+      TTYPE("x^4-5x^2+4",4,-2.0,2.0),           // biquadratic
+      TTYPE("x^4+x^2+1",0,0.0,0.0),
+      TTYPE("x^5-15x^4+85x^3-225x^2+274x-120",5,1.0,5.0),
+      TTYPE("x^6-1",2,-1.0,1.0)
+    };
+
+  std::array<double,8> Res;
+  for(const TTYPE& tc : Tests)
+    {
+      PolyVar<1> FX;
+      FX.read(std::get<0>(tc));
+      const PolyFix<8> PF(FX);
+      const size_t nSolution=PF.realRoots(Res);
+      const double dA=(nSolution) ? Res[0]-std::get<2>(tc) : 0.0;
+      const double dB=(nSolution) ? Res[nSolution-1]-std::get<3>(tc) : 0.0;
+      
+      if (nSolution!=std::get<1>(tc) ||
+	  std::abs(dA)>1e-6 || std::abs(dB)>1e-6)
+	{
+	  ELog::EM<<"FX == "<<PF<<ELog::endDiag;
+	  for(size_t i=0;i<nSolution;i++)
+	    ELog::EM<<"Res == "<<Res[i]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  
+  return 0;
+}
+
 int
 testPoly::testGetMaxSize()
   /*!
@@ -697,6 +753,63 @@ testPoly::testMultiplication()
   return 0;
 }
 
+int
+testPoly::testQuarticScale()
+  /*!
+    Test the closed form quartic for roots far from
+    unit size : the tolerances must scale with the roots
+    \return error number / 0 on success
+   */
+{
+  ELog::RegMethod RegA("testPoly","testQuarticScale");
+
+  // Roots [unit scale]
+  typedef std::tuple<double,double,double,double> TTYPE;
+  const std::vector<TTYPE> Tests =
+    {
+      TTYPE(1.0,2.0,3.0,5.0),
+      TTYPE(-1.0,1.0,2.0,4.0),
+      TTYPE(-2.0,-1.0,1.0,2.0),      // biquadratic
+      TTYPE(1.0,1.5,2.0,2.5)
+    };
+  const std::vector<double> Scale({1e-6,1e-3,1.0,1e3,1e6});
+
+  std::complex<double> Ans[4];
+  for(const TTYPE& tc : Tests)
+    for(const double S : Scale)
+      {
+	const double R[4]={S*std::get<0>(tc),S*std::get<1>(tc),
+			   S*std::get<2>(tc),S*std::get<3>(tc)};
+	// coefficients of (x-R0)(x-R1)(x-R2)(x-R3)
+	double C[5]={1.0,0.0,0.0,0.0,0.0};
+	for(size_t i=0;i<4;i++)
+	  for(size_t j=i+1;j>0;j--)
+	    C[j]-=R[i]*C[j-1];
+
+	solveQuartic(C,Ans);
+	std::vector<double> Res;
+	for(size_t i=0;i<4;i++)
+	  if (std::abs(Ans[i].imag())<1e-6*S)
+	    Res.push_back(Ans[i].real());
+	std::sort(Res.begin(),Res.end());
+
+	int flag(Res.size()!=4);
+	for(size_t i=0;!flag && i<4;i++)
+	  if (std::abs(Res[i]-R[i])>1e-6*S)
+	    flag=1;
+	if (flag)
+	  {
+	    ELog::EM<<"Scale "<<S<<" : "<<C[0]<<" "<<C[1]<<" "<<C[2]
+		    <<" "<<C[3]<<" "<<C[4]<<ELog::endDiag;
+	    for(size_t i=0;i<4;i++)
+	      ELog::EM<<"Ans["<<i<<"] == "<<Ans[i]<<" ("<<R[i]<<")"
+		      <<ELog::endDiag;
+	    return -1;
+	  }
+      }
+  return 0;
+}
+
 int
 testPoly::testRead()
   /*!
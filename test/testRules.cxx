@@ -33,6 +33,7 @@
 #include <iterator>
 #include <memory>
 #include <tuple>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -50,10 +51,12 @@
 #include "Surface.h"
 #include "Rules.h"
 #include "RuleBinary.h"
+#include "RulePool.h"
 #include "HeadRule.h"
 #include "Object.h"
 #include "surfIndex.h"
 #include "mapIterator.h"
+#include "ThreadControl.h"
 
 #include "testFunc.h"
 #include "testRules.h"
@@ -119,7 +122,8 @@ testRules::applyTest(const int extra)
       &testRules::testIsValid,
       &testRules::testMakeCNF,
       &testRules::testRemoveComplement,
-      &testRules::testRuleBinary
+      &testRules::testRuleBinary,
+      &testRules::testRulePool
     };
   const std::string TestName[]=
     {
@@ -128,7 +132,8 @@ testRules::applyTest(const int extra)
       "IsValid",
       "MakeCNF",
       "RemoveComplement",
-      "RuleBinary"
+      "RuleBinary",
+      "RulePool"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -437,3 +442,84 @@ testRules::testRuleBinary()
   return 0;
 }
 
+
+int
+testRules::testRulePool()
+  /*!
+    Test the pool allocation of the rule nodes. 
+    Nodes released must be reused and nodes can be
+    released by a different thread.
+    \return 0 on success / -ve on error
+  */
+{
+  ELog::RegMethod RegA("testRules","testRulePool");
+
+  createSurfaces();
+  const std::string RStr("(1 -2 3 -4 5 -6) : (11 -12 (13 : -14) 15 -16)");
+  std::unique_ptr<Rule> Master(Rule::procString(RStr));
+  const std::string Ref=Master->display();
+
+  // first pass fills the pool
+  for(size_t i=0;i<10;i++)
+    {
+      std::unique_ptr<Rule> A(Master->clone());
+    }
+  const size_t nChunk(RulePool::nChunk());
+
+  for(size_t i=0;i<1000;i++)
+    {
+      std::unique_ptr<Rule> A(Master->clone());
+    }
+  if (RulePool::nChunk()!=nChunk)
+    {
+      ELog::EM<<"Nodes not reused : "<<nChunk<<" "
+	      <<RulePool::nChunk()<<ELog::endDiag;
+      return -1;
+    }
+
+  // built by threads : released by this thread
+  const size_t NItems(400);
+  std::vector<Rule*> Items(NItems,0);
+  ModelSupport::ThreadControl::setThreads(4);
+  ModelSupport::ThreadControl::runBlocks
+    (NItems,[&Master,&Items](const size_t first,const size_t last)
+     {
+       for(size_t i=first;i<last;i++)
+	 Items[i]=Master->clone();
+     });
+  int retFlag(0);
+  for(Rule* RPtr : Items)
+    {
+      if (!retFlag && RPtr->display()!=Ref)
+	{
+	  ELog::EM<<"Rule    == "<<RPtr->display()<<ELog::endDiag;
+	  ELog::EM<<"Expect  == "<<Ref<<ELog::endDiag;
+	  retFlag= -2;
+	}
+      delete RPtr;
+      RPtr=0;
+    }
+
+  // built by this thread : released by threads
+  for(size_t i=0;i<NItems;i++)
+    Items[i]=Master->clone();
+  ModelSupport::ThreadControl::runBlocks
+    (NItems,[&Items](const size_t first,const size_t last)
+     {
+       for(size_t i=first;i<last;i++)
+	 {
+	   delete Items[i];
+	   Items[i]=0;
+	 }
+     });
+  ModelSupport::ThreadControl::setThreads(1);
+  
+  std::unique_ptr<Rule> A(Master->clone());
+  if (!retFlag && A->display()!=Ref)
+    {
+      ELog::EM<<"Rule    == "<<A->display()<<ELog::endDiag;
+      ELog::EM<<"Expect  == "<<Ref<<ELog::endDiag;
+      retFlag= -3;
+    }
+  return retFlag;
+}
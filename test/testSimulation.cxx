@@ -22,6 +22,8 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <cstdio>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -50,6 +52,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Quaternion.h"
 #include "Transform.h"
 #include "Surface.h"
@@ -73,7 +76,21 @@
 #include "surfRegister.h"
 #include "ModelSupport.h"
 #include "neutron.h"
+#include "Triple.h"
+#include "NList.h"
+#include "NRange.h"
+#include "ModeCard.h"
+#include "PhysCard.h"
+#include "PhysImp.h"
+#include "LSwitchCard.h"
+#include "PhysicsCards.h"
+#include "Tally.h"
+#include "surfaceTally.h"
 #include "Simulation.h"
+#include "SimProcess.h"
+#include "SimValid.h"
+#include "ThreadControl.h"
+#include "version.h"
 
 #include "testFunc.h"
 #include "testSimulation.h"
@@ -188,13 +205,25 @@ testSimulation::applyTest(const int extra)
   typedef int (testSimulation::*testPtr)();
   testPtr TPtr[]=
     {
+      &testSimulation::testCalcAllVertex,
+      &testSimulation::testCellBox,
       &testSimulation::testCreateObjSurfMap,
-      &testSimulation::testInCell
+      &testSimulation::testInCell,
+      &testSimulation::testRenumberChain,
+      &testSimulation::testValidThreads,
+      &testSimulation::testWriteMulti,
+      &testSimulation::testWriteThreads
     };
   const std::string TestName[]=
     {
+      "CalcAllVertex",
+      "CellBox",
       "CreateObjSurfMap",
       "InCell",
+      "RenumberChain",
+      "ValidThreads",
+      "WriteMulti",
+      "WriteThreads"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -221,6 +250,165 @@ testSimulation::applyTest(const int extra)
   return 0;
 }
 
+int
+testSimulation::testCalcAllVertex()
+  /*!
+    Test the threaded/cached vertex calculation against
+    the serial calculation of each cell
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testCalcAllVertex");
+
+  typedef std::map<int,std::vector<Geometry::Vec3D>> VTYPE;
+
+  const Simulation::OTYPE& CellMap=
+    static_cast<const Simulation&>(ASim).getCells();
+
+  // sorted vertex of each cell
+  std::function<VTYPE()> getAll=[&CellMap]()
+    {
+      VTYPE Out;
+      for(const Simulation::OTYPE::value_type& MC : CellMap)
+	{
+	  std::vector<Geometry::Vec3D> VPts=MC.second->getVertex();
+	  std::sort(VPts.begin(),VPts.end(),
+		    [](const Geometry::Vec3D& A,const Geometry::Vec3D& B)
+		    {
+		      // rounded to avoid order change from rounding error
+		      return std::make_tuple(std::round(A[0]*1e5),
+					     std::round(A[1]*1e5),
+					     std::round(A[2]*1e5)) <
+			std::make_tuple(std::round(B[0]*1e5),
+					std::round(B[1]*1e5),
+					std::round(B[2]*1e5));
+		    });
+	  Out.emplace(MC.first,VPts);
+	}
+      return Out;
+    };
+
+  ASim.calcAllVertex(0);
+  const VTYPE Serial=getAll();
+
+  ModelSupport::ThreadControl::setThreads(4);
+  ASim.calcAllVertex(1);
+  ModelSupport::ThreadControl::setThreads(1);
+  const VTYPE Cached=getAll();
+
+  // box cell has 8 corners
+  if (Serial.find(2)->second.size()!=8)
+    {
+      ELog::EM<<"Box cell vertex == "
+	      <<Serial.find(2)->second.size()<<ELog::endDiag;
+      return -1;
+    }
+  for(const VTYPE::value_type& SV : Serial)
+    {
+      const std::vector<Geometry::Vec3D>& CPts=Cached.find(SV.first)->second;
+      bool fail(CPts.size()!=SV.second.size());
+      for(size_t i=0;!fail && i<CPts.size();i++)
+	fail=(CPts[i].Distance(SV.second[i])>1e-6);
+      if (fail)
+	{
+	  ELog::EM<<"Cell "<<SV.first<<" : "<<SV.second.size()
+		  <<" != "<<CPts.size()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testSimulation::testCellBox()
+  /*!
+    Test the cell bounding boxes and the box index
+    used by findCell against a full search. Also check
+    that a slightly tilted plane does not bound the box.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testCellBox");
+
+  ASim.populateCells();
+
+  // cell : low : high [unbounded has low>high]
+  typedef std::tuple<int,Geometry::Vec3D,Geometry::Vec3D> TTYPE;
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE(2,Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(1,1,1)));
+  Tests.push_back(TTYPE(3,Geometry::Vec3D(-3,-3,-3),Geometry::Vec3D(3,3,3)));
+  Tests.push_back(TTYPE(4,Geometry::Vec3D(10,-1,-1),Geometry::Vec3D(15,1,1)));
+  Tests.push_back(TTYPE(5,Geometry::Vec3D(-25,-25,-25),
+			Geometry::Vec3D(25,25,25)));
+  Tests.push_back(TTYPE(1,Geometry::Vec3D(1,0,0),Geometry::Vec3D(-1,0,0)));
+
+  for(const TTYPE& tc : Tests)
+    {
+      const MonteCarlo::Qhull* QH=ASim.findQhull(std::get<0>(tc));
+      const Geometry::BoundBox BBox=QH->getHeadRule().calcBoundBox();
+      const Geometry::Vec3D& LPt=std::get<1>(tc);
+      const Geometry::Vec3D& HPt=std::get<2>(tc);
+      if ((LPt[0]<HPt[0] && (!BBox.isFinite() ||
+			     BBox.getLow().Distance(LPt)>1e-5 ||
+			     BBox.getHigh().Distance(HPt)>1e-5)) ||
+	  (LPt[0]>HPt[0] && BBox.isFinite()))
+	{
+	  ELog::EM<<"Cell "<<std::get<0>(tc)<<" == "<<BBox<<ELog::endDiag;
+	  ELog::EM<<"Expect "<<LPt<<" : "<<HPt<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // Index search must match a full search
+  const Simulation::OTYPE& CellMap=
+    static_cast<const Simulation&>(ASim).getCells();
+  for(double x= -30.05;x<30.0;x+=1.7)
+    for(double y= -30.05;y<30.0;y+=1.3)
+      for(double z= -30.05;z<30.0;z+=2.1)
+	{
+	  const Geometry::Vec3D Pt(x,y,z);
+	  const MonteCarlo::Object* FullPtr(0);
+	  for(const Simulation::OTYPE::value_type& MC : CellMap)
+	    if (MC.second->isValid(Pt))
+	      {
+		FullPtr=MC.second;
+		break;
+	      }
+	  const MonteCarlo::Object* IPtr=ASim.findCell(Pt,0);
+	  if (IPtr!=FullPtr)
+	    {
+	      ELog::EM<<"Failed on point:"<<Pt<<ELog::endDiag;
+	      ELog::EM<<"Index : "<<((IPtr) ? IPtr->getName() : 0)
+		      <<" != "<<((FullPtr) ? FullPtr->getName() : 0)
+		      <<ELog::endDiag;
+	      return -2;
+	    }
+	}
+
+  // Plane tilted by 1e-5 : the cell reaches x=5000.1 at y=-1e4
+  // so the box can not be bounded at the plane distance
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(31,"p 1 1e-5 0 5000");
+  SurI.createSurface(32,"py -10000");
+  SurI.createSurface(33,"py 10000");
+  SurI.createSurface(34,"px 4000");
+  HeadRule TiltRule;
+  TiltRule.procString("34 -31 32 -33");
+  TiltRule.populateSurf();
+  const Geometry::BoundBox TBox=TiltRule.calcBoundBox();
+  const Geometry::Vec3D TPt(5000.09,-9999.0,0.0);
+  const bool tValid=TiltRule.isValid(TPt);
+  for(const int SN : {31,32,33,34})
+    SurI.deleteSurface(SN);
+  if (!tValid || !TBox.isValid(TPt))
+    {
+      ELog::EM<<"Tilted cell box == "<<TBox<<ELog::endDiag;
+      ELog::EM<<"Point "<<TPt<<" valid == "<<tValid<<ELog::endDiag;
+      return -3;
+    }
+  return 0;
+}
+
 int
 testSimulation::testCreateObjSurfMap()
   /*!
@@ -302,3 +490,271 @@ testSimulation::testInCell()
       
   return 0;
 }
+
+int
+testSimulation::testRenumberChain()
+  /*!
+    Test the map renumber of surfaces with a chain [1->2->30]
+    and a swap [3<->4]. Each surface must be changed once in 
+    the cells and the tallies and the geometry must not change.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testRenumberChain");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+
+  tallySystem::surfaceTally STally(0,1);
+  STally.addSurface(1);
+  STally.addSurface(-2);
+  STally.addSurface(3);
+  ASim.addTally(STally);
+
+  const std::vector<Geometry::Vec3D> TPts=
+    { Geometry::Vec3D(0,0,0),Geometry::Vec3D(0.5,0.9,-0.5),
+      Geometry::Vec3D(2,0,0),Geometry::Vec3D(0,-2,0),
+      Geometry::Vec3D(12,0,0),Geometry::Vec3D(12,2,0),
+      Geometry::Vec3D(0,0,20),Geometry::Vec3D(0,0,40) };
+  std::vector<int> cellA;
+  for(const Geometry::Vec3D& Pt : TPts)
+    {
+      const MonteCarlo::Object* OPtr=ASim.findCell(Pt,0);
+      cellA.push_back((OPtr) ? OPtr->getName() : 0);
+    }
+
+  const std::map<int,int> RMap({{1,2},{2,30},{3,4},{4,3}});
+  SurI.renumber(RMap);
+  ASim.substituteAllSurface(RMap);
+
+  int retFlag(0);
+  // Cells : expected rules
+  typedef std::tuple<int,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(2,"2 -30 4 -3 5 -6"),
+      TTYPE(3,"11 -12 13 -14 15 -16 (-2:30:-4:3:-5:6)"),
+      TTYPE(4,"21 -22 4 -3 5 -6")
+    };
+  for(const TTYPE& tc : Tests)
+    {
+      const MonteCarlo::Qhull* QH=ASim.findQhull(std::get<0>(tc));
+      HeadRule HR;
+      HR.procString(std::get<1>(tc));
+      if (!QH || QH->getHeadRule().display()!=HR.display())
+	{
+	  ELog::EM<<"Cell "<<std::get<0>(tc)<<" :"<<ELog::endDiag;
+	  if (QH)
+	    ELog::EM<<"Cell   == "<<QH->getHeadRule().display()<<ELog::endDiag;
+	  ELog::EM<<"Expect == "<<HR.display()<<ELog::endDiag;
+	  retFlag= -1;
+	}
+    }
+
+  // Tally : signs kept
+  tallySystem::surfaceTally ETally(0,1);
+  ETally.addSurface(2);
+  ETally.addSurface(-30);
+  ETally.addSurface(4);
+  std::ostringstream tx,ex;
+  ASim.getTally(1)->write(tx);
+  ETally.write(ex);
+  if (tx.str()!=ex.str())
+    {
+      ELog::EM<<"Tally  == "<<tx.str()<<ELog::endDiag;
+      ELog::EM<<"Expect == "<<ex.str()<<ELog::endDiag;
+      retFlag= -1;
+    }
+
+  // Geometry is unchanged
+  for(size_t i=0;i<TPts.size() && !retFlag;i++)
+    {
+      const MonteCarlo::Object* OPtr=ASim.findCell(TPts[i],0);
+      const int cellB((OPtr) ? OPtr->getName() : 0);
+      if (cellB!=cellA[i])
+	{
+	  ELog::EM<<"Point "<<TPts[i]<<" cell "<<cellA[i]<<" -> "
+		  <<cellB<<ELog::endDiag;
+	  retFlag= -1;
+	}
+    }
+  initSim();
+  return retFlag;
+}
+
+int
+testSimulation::testValidThreads()
+  /*!
+    Test that the failed rays of the validity check do not
+    depend on the number of threads and that repeated start 
+    points are removed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testValidThreads");
+
+  // remove the Gd box to leave a hole in the geometry
+  ASim.removeCell(4);
+  ASim.findQhull(1)->setImp(0);
+  ASim.createObjSurfMap();
+
+  const ModelSupport::SimValid SValid;
+  const std::vector<Geometry::Vec3D> CPts=
+    { Geometry::Vec3D(0,0,0),Geometry::Vec3D(2,0,0),
+      Geometry::Vec3D(8,0,0) };
+  // repeats after the first of each point [order kept]
+  std::vector<Geometry::Vec3D> RPts(CPts);
+  RPts.insert(RPts.begin()+2,CPts[0]);
+  RPts.push_back(CPts[1]);
+
+  const size_t nAngle(1000);
+  const size_t seed(4321);
+  const std::vector<size_t> FailA=
+    SValid.calcFailRays(ASim,CPts,nAngle,seed);
+  ModelSupport::ThreadControl::setThreads(4);
+  const std::vector<size_t> FailB=
+    SValid.calcFailRays(ASim,CPts,nAngle,seed);
+  ModelSupport::ThreadControl::setThreads(3);
+  const std::vector<size_t> FailC=
+    SValid.calcFailRays(ASim,RPts,nAngle,seed);
+  ModelSupport::ThreadControl::setThreads(1);
+  initSim();
+
+  if (FailA.empty() || FailA!=FailB || FailA!=FailC)
+    {
+      ELog::EM<<"Failed rays : "<<FailA.size()<<" "<<FailB.size()
+	      <<" "<<FailC.size()<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testSimulation::testWriteMulti()
+  /*!
+    Test that the single render multi-file write is
+    the same as writing each file in turn
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testWriteMulti");
+
+  const int NFile(12);
+  physicsSystem::PhysicsCards& PC=ASim.getPC();
+
+  // read a file and remove it
+  std::function<std::string(const std::string&,const int)> readFile=
+    [](const std::string& FName,const int index)
+    {
+      std::ostringstream cx;
+      cx<<FName<<index+1<<".x";
+      std::ifstream IX(cx.str().c_str());
+      std::ostringstream OX;
+      OX<<IX.rdbuf();
+      IX.close();
+      std::remove(cx.str().c_str());
+      return OX.str();
+    };
+
+  // seed passes a change in width 
+  version& VInfo=version::Instance();
+  const int vStartA=VInfo.getVersion();
+  PC.setRND(99800);
+  for(int i=0;i<NFile;i++)
+    SimProcess::writeIndexSim(ASim,"testMultiA",i);
+  const long int seedA=PC.getRNDseed();
+
+  const int vStartB=VInfo.getVersion();
+  PC.setRND(99800);
+  ModelSupport::ThreadControl::setThreads(3);
+  SimProcess::writeMultiSim(ASim,"testMultiB",NFile);
+  ModelSupport::ThreadControl::setThreads(1);
+  const long int seedB=PC.getRNDseed();
+  const int vEndB=VInfo.getVersion();
+
+  int retFlag(0);
+  if (seedA!=seedB || vEndB-vStartB!=NFile)
+    {
+      ELog::EM<<"Final seed "<<seedA<<" != "<<seedB<<ELog::endDiag;
+      ELog::EM<<"Version increment "<<vEndB-vStartB<<ELog::endDiag;
+      retFlag= -1;
+    }
+  std::string prevDeck;
+  for(int i=0;i<NFile;i++)
+    {
+      std::string DeckA=readFile("testMultiA",i);
+      const std::string DeckB=readFile("testMultiB",i);
+      if (retFlag) continue;
+      // version line : each file has the next increment
+      const std::string VA=" "+std::to_string(vStartA+i)+" ";
+      const std::string::size_type vPos=DeckA.find("========="+VA);
+      if (vPos!=std::string::npos)
+	DeckA.replace(vPos+9,VA.size(),
+		      " "+std::to_string(vStartB+i)+" ");
+      if (DeckA.empty() || DeckA!=DeckB || DeckA==prevDeck)
+	{
+	  ELog::EM<<"File "<<i+1<<" differs :"<<DeckA.size()
+		  <<" "<<DeckB.size()<<ELog::endDiag;
+	  retFlag= -1;
+	}
+      prevDeck=DeckA;
+    }
+  return retFlag;
+}
+
+int
+testSimulation::testWriteThreads()
+  /*!
+    Test that the block/threaded write is the same as
+    the serial write
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testWriteThreads");
+
+  // many blocks : check the order and the stream format
+  const size_t NItems(5*ModelSupport::ThreadControl::writeBlock+17);
+  std::function<void(const size_t,std::ostream&)> itemWrite=
+    [](const size_t index,std::ostream& OX)
+    {
+      OX<<"item "<<index<<" "<<1.0/static_cast<double>(index+3)<<std::endl;
+    };
+
+  std::ostringstream serialOut;
+  serialOut.precision(12);
+  for(size_t i=0;i<NItems;i++)
+    itemWrite(i,serialOut);
+
+  ASim.prepareWrite();
+  const int vNum=version::Instance().getVersion();
+  std::ostringstream serialDeck;
+  ASim.writeDeck(serialDeck);
+  
+  ModelSupport::ThreadControl::setThreads(4);
+  std::ostringstream threadOut;
+  threadOut.precision(12);
+  ModelSupport::ThreadControl::writeBlocks(threadOut,NItems,itemWrite);
+  std::ostringstream threadDeck;
+  ASim.writeDeck(threadDeck);
+  ModelSupport::ThreadControl::setThreads(1);
+
+  if (serialOut.str()!=threadOut.str())
+    {
+      ELog::EM<<"Items differ : "<<serialOut.str().size()<<" "
+	      <<threadOut.str().size()<<ELog::endDiag;
+      return -1;
+    }
+  // each deck write takes the next version increment
+  std::string SDeck=serialDeck.str();
+  const std::string VA="========= "+std::to_string(vNum)+" ";
+  const std::string::size_type vPos=SDeck.find(VA);
+  if (vPos!=std::string::npos)
+    SDeck.replace(vPos,VA.size(),
+		  "========= "+std::to_string(vNum+1)+" ");
+  if (SDeck!=threadDeck.str())
+    {
+      ELog::EM<<"Serial == "<<serialDeck.str()<<ELog::endDiag;
+      ELog::EM<<"Thread == "<<threadDeck.str()<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
@@ -25,6 +25,7 @@
 #include <sstream>
 #include <cmath>
 #include <complex>
+#include <array>
 #include <list>
 #include <vector>
 #include <map>
@@ -33,6 +34,7 @@
 #include <iterator>
 #include <numeric>
 #include <tuple>
+#include <chrono>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -44,6 +46,7 @@
 #include "Vec3D.h"
 #include "PolyFunction.h"
 #include "PolyVar.h"
+#include "PolyFix.h"
 #include "solveValues.h"
 
 #include "testFunc.h"
@@ -79,15 +82,21 @@ testSolveValues::applyTest(const int extra)
   typedef int (testSolveValues::*testPtr)();
   testPtr TPtr[]=
     {
-      &testSolveValues::testGetSolutions
+      &testSolveValues::testFixedRoots,
+      &testSolveValues::testGetSolutions,
+      // benchmarks : only run when selected
+      &testSolveValues::testFixedRootsTiming
     };
 
   const std::string TestName[]=
     {
-      "GetSolutions"
+      "FixedRoots",
+      "GetSolutions",
+      "FixedRootsTiming"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  const int NTiming(1);
   if (!extra)
     {
       std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
@@ -100,7 +109,7 @@ testSolveValues::applyTest(const int extra)
     }
   for(int i=0;i<TSize;i++)
     {
-      if (extra<0 || extra==i+1)
+      if ((extra<0 && i<TSize-NTiming) || extra==i+1)
         {
 	  TestFunc::regTest(TestName[i]);
 	  const int retValue= (this->*TPtr[i])();
@@ -111,6 +120,151 @@ testSolveValues::applyTest(const int extra)
   return 0;
 }
 
+std::vector<PolyVar<1> >
+testSolveValues::makeTriplePoly()
+  /*!
+    Make the single variable polynominals from quadric 
+    surface triples as made in solveValues::getSolution
+    \return polynominals [degree 1-16]
+  */ 
+{
+  ELog::RegMethod RegA("testSolveValues","makeTriplePoly");
+
+  typedef std::tuple<std::string,std::string,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      // plane / cylinder / cylinder at angle
+      TTYPE("-0.69465837z-0.7193398y-379.108596",
+	    "0.517449748z^2+(-0.999390827y+21.8953305)z+"
+	    "0.482550252y^2-21.1440748y+x^2+52.575x+920.402005",
+	    "0.517780408z^2+(-0.998706012y-0.0363556101x+"
+	    "4.60265241)z+0.482904825y^2+"
+	    "(-0.0376473363x-4.50181022)y+"
+	    "0.999314767x^2+1.5680273x-389.022646"),
+      // three spheres
+      TTYPE("z^2+y^2+x^2-100","z^2+y^2+x^2-20x","z^2+y^2+x^2-20y"),
+      // sphere / cylinder / cone
+      TTYPE("z^2+y^2+x^2-100","y^2+x^2-2x-35","-0.5z^2+y^2+x^2"),
+      // orthogonal cylinders
+      TTYPE("z^2+y^2-25","z^2+x^2-2x-24","y^2+x^2-36")
+    };
+
+  // Single variable polynominals as made in solveValues::getSolution
+  std::vector<PolyVar<1> > OneVar;
+  PolyVar<3> FXYZ,GXYZ,HXYZ;
+  for(const TTYPE& tc : Tests)
+    {
+      FXYZ.read(std::get<0>(tc));
+      GXYZ.read(std::get<1>(tc));
+      HXYZ.read(std::get<2>(tc));
+      const PolyVar<2> AXY=FXYZ.reduce(GXYZ);
+      const PolyVar<2> BXY=FXYZ.reduce(HXYZ);
+      const PolyVar<2> CXY=GXYZ.reduce(HXYZ);
+      for(const PolyVar<1>& PX : 
+	    { AXY.reduce(BXY),AXY.reduce(CXY),BXY.reduce(CXY) })
+	{
+	  PolyVar<1> UX(PX);
+	  UX.unitPrimary(1e-6);
+	  if (UX.getDegree()>0 && UX.getDegree()<=16)
+	    OneVar.push_back(UX);
+	}
+    }
+  return OneVar;
+}
+
+int
+testSolveValues::testFixedRoots()
+  /*!
+    Compare the real roots of PolyFix with the 
+    Durand-Kerner roots of PolyVar<1> for the single variable
+    polynominals from quadric surface triples
+    \retval 0 :: All passed
+  */ 
+{
+  ELog::RegMethod RegA("testSolveValues","testFixedRoots");
+
+  const std::vector<PolyVar<1> > OneVar=makeTriplePoly();
+
+  // Check the real roots agree [PolyFix also finds multiple roots]
+  const double eps(1e-6);
+  std::array<double,16> Roots;
+  for(size_t i=0;i<OneVar.size();i++)
+    {
+      const PolyVar<1>& PV(OneVar[i]);
+      PolyVar<1> PX(PV);
+      std::vector<double> DKRoots;
+      for(const std::complex<double>& CX : PX.calcDurandKernerRoots(eps))
+	if (std::abs(CX.imag())<eps)
+	  DKRoots.push_back(CX.real());
+      
+      const size_t nRoots=PolyFix<16>(PV).realRoots(Roots,eps);
+      int flag(0);
+      for(const double D : DKRoots)
+	{
+	  size_t j;
+	  for(j=0;j<nRoots && 
+		std::abs(Roots[j]-D)>1e-5*(1.0+std::abs(D));j++) ;
+	  if (j==nRoots) flag=1;
+	}
+      for(size_t j=0;j<nRoots;j++)
+	{
+	  double scale(0.0);
+	  for(size_t k=0;k<=PV.getDegree();k++)
+	    scale+=std::abs(PV[k]*std::pow(Roots[j],static_cast<double>(k)));
+	  if (std::abs(PV(Roots[j]))>1e-8*scale)
+	    flag=1;
+	}
+      if (flag)
+	{
+	  ELog::EM<<"Failed on poly "<<i<<" : "<<PV<<ELog::endDiag;
+	  for(const double D : DKRoots)
+	    ELog::EM<<"DK Root == "<<D<<ELog::endDiag;
+	  for(size_t j=0;j<nRoots;j++)
+	    ELog::EM<<"Fix Root == "<<Roots[j]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testSolveValues::testFixedRootsTiming()
+  /*!
+    Time the real roots of PolyFix against the 
+    Durand-Kerner roots of PolyVar<1> for the polynominals
+    from quadric surface triples [benchmark]
+    \return 0
+  */ 
+{
+  ELog::RegMethod RegA("testSolveValues","testFixedRootsTiming");
+
+  const std::vector<PolyVar<1> > OneVar=makeTriplePoly();
+  const double eps(1e-6);
+  std::array<double,16> Roots;
+
+  const size_t NLoop(200);
+  const auto tA=std::chrono::steady_clock::now();
+  for(size_t iL=0;iL<NLoop;iL++)
+    for(const PolyVar<1>& PV : OneVar)
+      {
+	PolyVar<1> PX(PV);
+	PX.calcDurandKernerRoots(eps);
+      }
+  const auto tB=std::chrono::steady_clock::now();
+  for(size_t iL=0;iL<NLoop;iL++)
+    for(const PolyVar<1>& PV : OneVar)
+      PolyFix<16>(PV).realRoots(Roots,eps);
+  const auto tC=std::chrono::steady_clock::now();
+
+  ELog::EM<<"Roots of "<<OneVar.size()<<" polynominals ["<<NLoop
+	  <<"] : PolyVar<1> "
+	  <<std::chrono::duration<double,std::milli>(tB-tA).count()
+	  <<" ms : PolyFix "
+	  <<std::chrono::duration<double,std::milli>(tC-tB).count()
+	  <<" ms"<<ELog::endDiag;
+  return 0;
+}
+
 int
 testSolveValues::testGetSolutions()
   /*!
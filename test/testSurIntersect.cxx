@@ -97,7 +97,8 @@ testSurIntersect::applyTest(const int extra)
       &testSurIntersect::testCylPlaneIntersect,
       &testSurIntersect::testMakePoint_Quad,
       &testSurIntersect::testNearPoint,
-      &testSurIntersect::testProcessPoint
+      &testSurIntersect::testProcessPoint,
+      &testSurIntersect::testProcessKernel
     };
 
   const std::string TestName[]=
@@ -105,7 +106,8 @@ testSurIntersect::applyTest(const int extra)
       "CylPlaneIntersect",
       "MakePoint(quadratic)",
       "nearPoint",
-      "ProcessPoint"
+      "ProcessPoint",
+      "ProcessKernel"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -392,6 +394,101 @@ testSurIntersect::testProcessPoint()
   return 0;
 }
 
+int
+testSurIntersect::testProcessKernel()
+  /*!
+    Tests the closed form kernels in processPoint:
+    sphere/sphere, parallel cylinders, cylinders
+    with the axis in a plane [including a tangent plane]
+    and both sheets of a cone cut by a plane/plane line.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSurInterSect","testProcessKernel");
+
+  std::vector<std::shared_ptr<Geometry::Surface>> SList;
+
+  Geometry::Plane* PPtr=new Geometry::Plane(1,0);
+  PPtr->setSurface("pz 0");
+  SList.push_back(std::shared_ptr<Geometry::Surface>(PPtr));    // 0
+  PPtr=new Geometry::Plane(2,0);
+  PPtr->setSurface("pz 3");
+  SList.push_back(std::shared_ptr<Geometry::Surface>(PPtr));    // 1
+
+  const std::vector<std::string> SphStr=
+    { "so 10","s 10 0 0 10","s 0 10 0 10" };
+  for(const std::string& SN : SphStr)                           // 2,3,4
+    {
+      Geometry::Sphere* SPtr=new Geometry::Sphere(3,0);
+      SPtr->setSurface(SN);
+      SList.push_back(std::shared_ptr<Geometry::Surface>(SPtr));
+    }
+  const std::vector<std::string> CylStr=
+    { "cx 5","cy 5","cz 10","c/z 10 0 10","cz 5","c/z 20 0 5" };
+  for(const std::string& CN : CylStr)                           // 5-10
+    {
+      Geometry::Cylinder* CPtr=new Geometry::Cylinder(4,0);
+      CPtr->setSurface(CN);
+      SList.push_back(std::shared_ptr<Geometry::Surface>(CPtr));
+    }
+  const std::vector<std::string> PlnStr=
+    { "pz 0.4","px 1","py 0" };
+  for(const std::string& PN : PlnStr)                           // 11,12,13
+    {
+      PPtr=new Geometry::Plane(5,0);
+      PPtr->setSurface(PN);
+      SList.push_back(std::shared_ptr<Geometry::Surface>(PPtr));
+    }
+  Geometry::Cylinder* CPtr=new Geometry::Cylinder(6,0);
+  CPtr->setSurface("c/x 0 0.1 0.3");     
+  SList.push_back(std::shared_ptr<Geometry::Surface>(CPtr));   // 14
+  Geometry::Cone* KPtr=new Geometry::Cone(7,0);
+  KPtr->setSurface("k/z 0 0 0 1 1");     
+  SList.push_back(std::shared_ptr<Geometry::Surface>(KPtr));   // 15
+
+  // surf : surf : surf : Number of points 
+  typedef std::tuple<size_t,size_t,size_t,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(2,3,0,2),     // sphere/sphere/plane
+      TTYPE(2,3,4,2),     // three spheres
+      TTYPE(0,5,6,4),     // plane/cx/cy
+      TTYPE(7,8,1,2),     // parallel cylinders/plane
+      TTYPE(9,10,0,0),    // parallel cylinders : no intersect
+      TTYPE(11,14,2,2),   // plane tangent [0.1+0.3 rounds up] to c/x
+      TTYPE(12,13,15,2)   // plane/plane/cone : both sheets
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Surface* aPtr=SList[std::get<0>(tc)].get();
+      const Geometry::Surface* bPtr=SList[std::get<1>(tc)].get();
+      const Geometry::Surface* cPtr=SList[std::get<2>(tc)].get();
+      const std::vector<Geometry::Vec3D> Out=
+	SurInter::processPoint(aPtr,bPtr,cPtr);
+
+      // Sphere::onSurface is exact so use distance
+      int flag(Out.size()!=std::get<3>(tc));
+      for(const Geometry::Vec3D& Pt : Out)
+	if (aPtr->distance(Pt)>1e-6 || bPtr->distance(Pt)>1e-6 ||
+	    cPtr->distance(Pt)>1e-6)
+	  flag=1;
+      if (flag)
+	{
+	  ELog::EM<<"Test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"Out.size == "<<Out.size()<<" ("
+		  <<std::get<3>(tc)<<")"<<ELog::endDiag;
+	  for(const Geometry::Vec3D& Pt : Out)
+	    ELog::EM<<"Pt == "<<Pt<<" :: "<<aPtr->distance(Pt)<<" "
+		    <<bPtr->distance(Pt)<<" "<<cPtr->distance(Pt)<<ELog::endDiag;
+	  return -cnt;
+	}
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testSurIntersect::testCylPlaneIntersect()
   /*!
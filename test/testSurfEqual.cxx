@@ -116,13 +116,15 @@ testSurfEqual::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testSurfEqual::testBasicPair,
-      &testSurfEqual::testEqualSurfNum
+      &testSurfEqual::testEqualSurfNum,
+      &testSurfEqual::testFindEqualSurf
     };
 
   const std::string TestName[]=
     {
       "BasicPair",
-      "EqualSurfNum"
+      "EqualSurfNum",
+      "FindEqualSurf"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -212,3 +214,67 @@ testSurfEqual::testEqualSurfNum()
   return 0;
 }
 
+
+int
+testSurfEqual::testFindEqualSurf()
+  /*!
+    Test the hashed search for equal surfaces in a range
+    and the equal surface of a surface set after createSurf
+    \return -ve on error 
+  */
+{
+  ELog::RegMethod RegA("testSurfEqual","testFindEqualSurf");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+
+  SurI.createSurface(21,"px 1");
+  SurI.createSurface(22,"p -1 0 0 -1");
+  SurI.createSurface(23,"so 5");
+  SurI.createSurface(24,"s 0 0 0 5");
+  SurI.createSurface(25,"cx 3");
+  SurI.createSurface(26,"c/x 0 0 3");
+  SurI.createSurface(27,"so 5.1");
+  
+  std::map<int,Geometry::Surface*> EQMap;
+  SurI.findEqualSurf(21,30,EQMap);
+
+  typedef std::tuple<int,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(21,2),TTYPE(24,23),TTYPE(26,25)
+    };
+
+  int retFlag(0);
+  if (EQMap.size()!=Tests.size())
+    {
+      ELog::EM<<"Equal size :"<<EQMap.size()<<ELog::endDiag;
+      retFlag= -1;
+    }
+  for(const TTYPE& tc : Tests)
+    {
+      std::map<int,Geometry::Surface*>::const_iterator mc=
+	EQMap.find(std::get<0>(tc));
+      if (!retFlag &&
+	  (mc==EQMap.end() || mc->second->getName()!=std::get<1>(tc)))
+	{
+	  ELog::EM<<"Failed :  "<<std::get<0>(tc)<<" "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  retFlag= -2;
+	}
+    }
+
+  // surface set after createSurf
+  Geometry::Plane* PA=SurI.createSurf<Geometry::Plane>(31);
+  PA->setPlane(Geometry::Vec3D(0,0,1),7.0);
+  Geometry::Plane PB(40,0);
+  PB.setPlane(Geometry::Vec3D(0,0,1),7.0);
+  if (!retFlag && ModelSupport::equalSurfNum(&PB)!=31)
+    {
+      ELog::EM<<"Failed createSurf : "
+	      <<ModelSupport::equalSurfNum(&PB)<<ELog::endDiag;
+      retFlag= -3;
+    }
+
+  createSurfaces();
+  return retFlag;
+}
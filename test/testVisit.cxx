@@ -0,0 +1,448 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testVisit.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "Rules.h"
+#include "surfIndex.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "Simulation.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "fileSupport.h"
+#include "ThreadControl.h"
+#include "NList.h"
+#include "NRange.h"
+#include "Tally.h"
+#include "pairRange.h"
+#include "tmeshTally.h"
+#include "inputParam.h"
+#include "MainInputs.h"
+#include "mainJobs.h"
+#include "Visit.h"
+
+#include "testFunc.h"
+#include "testVisit.h"
+
+
+testVisit::testVisit() 
+  /*!
+    Constructor
+  */
+{
+  initSim();
+}
+
+testVisit::~testVisit() 
+  /*!
+    Destructor
+  */
+{}
+
+void
+testVisit::initSim()
+  /*!
+    Set all the objects in the simulation:
+  */
+{
+  ASim.resetAll();
+  createSurfaces();
+  createObjects();
+  return;
+}
+
+void 
+testVisit::createSurfaces()
+  /*!
+    Create the surface list
+   */
+{
+  ELog::RegMethod RegA("testVisit","createSurfaces");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  
+  // First box :
+  SurI.createSurface(1,"px -1");
+  SurI.createSurface(2,"px 1");
+  SurI.createSurface(3,"py -1");
+  SurI.createSurface(4,"py 1");
+  SurI.createSurface(5,"pz -1");
+  SurI.createSurface(6,"pz 1");
+
+  // Second box :
+  SurI.createSurface(11,"px -3");
+  SurI.createSurface(12,"px 3");
+  SurI.createSurface(13,"py -3");
+  SurI.createSurface(14,"py 3");
+  SurI.createSurface(15,"pz -3");
+  SurI.createSurface(16,"pz 3");
+
+  // Far box :
+  SurI.createSurface(21,"px 10");
+  SurI.createSurface(22,"px 15");
+
+  // Sphere :
+  SurI.createSurface(100,"so 25");
+  
+  return;
+}
+  
+void
+testVisit::createObjects()
+  /*!
+    Create Object for test
+  */
+{
+  ELog::RegMethod RegA("testVisit","createObjects");
+
+  std::string Out;
+  int cellIndex(1);
+  const int surIndex(0);
+  Out=ModelSupport::getComposite(surIndex,"100");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Outside void Void
+
+  Out=ModelSupport::getComposite(surIndex,"1 -2 3 -4 5 -6");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,3,0.0,Out));      // steel object
+
+  Out=ModelSupport::getComposite(surIndex,"11 -12 13 -14 15 -16"
+				 " (-1:2:-3:4:-5:6) ");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,5,0.0,Out));      // Al container
+
+  Out=ModelSupport::getComposite(surIndex,"21 -22 3 -4 5 -6");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,8,0.0,Out));      // Gd box 
+
+  Out=ModelSupport::getComposite(surIndex,"-100 (-11:12:-13:14:-15:16)"
+				 " #4");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Void
+  
+  ASim.removeComplements();
+  return;
+}
+
+int 
+testVisit::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Index of test
+    \returns -ve on error 0 on success.
+  */
+{
+  ELog::RegMethod RegA("testVisit","applyTest");
+  TestFunc::regSector("testVisit");
+
+  typedef int (testVisit::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testVisit::testBinaryVTK,
+      &testVisit::testLineForm
+    };
+
+  const std::string TestName[]=
+    {
+      "BinaryVTK",
+      "LineForm"
+    };
+
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testVisit::testBinaryVTK()
+  /*!
+    Test the streamed binary VTK file : the header,
+    the size of each binary block and that the values
+    are the populated mesh [big-endian float]
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testVisit","testBinaryVTK");
+
+  const std::string FName(StrFunc::tempPathName("testVisit.vtk"));
+  const size_t NX(23),NY(7),NZ(5);
+  const size_t nThread(ModelSupport::ThreadControl::getThreads());
+
+  Visit VA;
+  VA.setBox(Geometry::Vec3D(-30,-4,-4),Geometry::Vec3D(30,4,4));
+  VA.setIndex(NX,NY,NZ);
+  VA.populate(&ASim);
+  // more z planes than threads : several groups are written
+  ModelSupport::ThreadControl::setThreads(2);
+  VA.writeBinaryVTK(&ASim,std::set<std::string>(),FName);
+  ModelSupport::ThreadControl::setThreads(nThread);
+
+  std::ifstream IX(FName.c_str(),std::ios::binary);
+  const std::string File((std::istreambuf_iterator<char>(IX)),
+			 std::istreambuf_iterator<char>());
+  IX.close();
+  std::remove(FName.c_str());
+  
+  size_t pos(0);
+  // get next text line [false if missing]
+  auto getLine=[&File,&pos](std::string& Line) -> bool
+    {
+      const size_t index=File.find('\n',pos);
+      if (index==std::string::npos) return 0;
+      Line=File.substr(pos,index-pos);
+      pos=index+1;
+      return 1;
+    };
+  // get N big-endian floats and the trailing newline
+  auto getBlock=[&File,&pos](std::vector<float>& Data,
+			     const size_t N) -> bool
+    {
+      if (pos+4*N+1>File.size() || File[pos+4*N]!='\n')
+	return 0;
+      Data.resize(N);
+      for(size_t i=0;i<N;i++)
+	{
+	  const unsigned char* CPtr=
+	    reinterpret_cast<const unsigned char*>(File.data()+pos+4*i);
+	  const uint32_t Item=(static_cast<uint32_t>(CPtr[0])<<24) |
+	    (static_cast<uint32_t>(CPtr[1])<<16) |
+	    (static_cast<uint32_t>(CPtr[2])<<8) |
+	    static_cast<uint32_t>(CPtr[3]);
+	  std::memcpy(&Data[i],&Item,4);
+	}
+      pos+=4*N+1;
+      return 1;
+    };
+
+  const size_t NPts[3]={NX,NY,NZ};
+  const std::string coordName[3]={"X","Y","Z"};
+  std::vector<std::string> Expect=
+    {
+      "# vtk DataFile Version 2.0",
+      "chipIR Data",
+      "BINARY",
+      "DATASET RECTILINEAR_GRID",
+      "DIMENSIONS "+std::to_string(NX)+" "+
+      std::to_string(NY)+" "+std::to_string(NZ)
+    };
+  std::string Line;
+  std::vector<float> Data;
+  for(const std::string& EItem : Expect)
+    if (!getLine(Line) || Line!=EItem)
+      {
+	ELog::EM<<"Header line :"<<Line<<":"<<ELog::endDiag;
+	ELog::EM<<"Expected    :"<<EItem<<":"<<ELog::endDiag;
+	return -1;
+      }
+  for(size_t index=0;index<3;index++)
+    {
+      const std::string EItem=coordName[index]+"_COORDINATES "+
+	std::to_string(NPts[index])+" float";
+      if (!getLine(Line) || Line!=EItem ||
+	  !getBlock(Data,NPts[index]))
+	{
+	  ELog::EM<<"Coordinate line :"<<Line<<":"<<ELog::endDiag;
+	  ELog::EM<<"Expected        :"<<EItem<<":"<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  Expect=
+    {
+      "POINT_DATA "+std::to_string(NX*NY*NZ),
+      "SCALARS cellID float 1",
+      "LOOKUP_TABLE default"
+    };
+  for(const std::string& EItem : Expect)
+    if (!getLine(Line) || Line!=EItem)
+      {
+	ELog::EM<<"Data line :"<<Line<<":"<<ELog::endDiag;
+	ELog::EM<<"Expected  :"<<EItem<<":"<<ELog::endDiag;
+	return -1;
+      }
+  if (!getBlock(Data,NX*NY*NZ) || pos!=File.size())
+    {
+      ELog::EM<<"Payload size "<<File.size()-pos<<" at "<<pos
+	      <<" [expected "<<4*NX*NY*NZ+1<<"]"<<ELog::endDiag;
+      return -1;
+    }
+
+  const boost::multi_array<double,3>& mesh=VA.getMesh();
+  size_t index(0);
+  for(size_t k=0;k<NZ;k++)
+    for(size_t j=0;j<NY;j++)
+      for(size_t i=0;i<NX;i++)
+	{
+	  if (std::abs(static_cast<double>(Data[index])-mesh[i][j][k])>1e-6)
+	    {
+	      ELog::EM<<"Point["<<i<<"]["<<j<<"]["<<k<<"] == "
+		      <<Data[index]<<" ("<<mesh[i][j][k]<<")"<<ELog::endDiag;
+	      return -1;
+	    }
+	  index++;
+	}
+  return 0;
+}
+
+int
+testVisit::testLineForm()
+  /*!
+    Test that the line tracked rows [-vtkLine through
+    createVTK] give the same mesh as testing each point
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testVisit","testLineForm");
+
+  const std::string FName(StrFunc::tempPathName("testVisitLine.vtk"));
+  mainSystem::inputParam IParam;
+  mainSystem::createInputs(IParam);
+  IParam.setFlag("vtk");
+  IParam.setFlag("vtkLine");
+  IParam.setFlag("vtkBinary");
+  IParam.setFlag("vcell");
+
+  typedef std::tuple<Geometry::Vec3D,Geometry::Vec3D,size_t> TTYPE;
+  // Box corners : x points
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(Geometry::Vec3D(-30,-4,-4),Geometry::Vec3D(30,4,4),61),
+      TTYPE(Geometry::Vec3D(-30,-4,-4),Geometry::Vec3D(30,4,4),37),
+      TTYPE(Geometry::Vec3D(-20,-26,-2),Geometry::Vec3D(20,26,2),17),
+      TTYPE(Geometry::Vec3D(2,0.5,0.5),Geometry::Vec3D(12,0.7,0.7),1)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const size_t NX(std::get<2>(tc)),NY(9),NZ(5);
+      Visit PointForm;
+      PointForm.setBox(std::get<0>(tc),std::get<1>(tc));
+      PointForm.setIndex(NX,NY,NZ);
+      PointForm.populate(&ASim);
+      const boost::multi_array<double,3>& PMesh=PointForm.getMesh();
+
+      tallySystem::tmeshTally TM(1);
+      TM.setCoordinates(std::get<0>(tc),std::get<1>(tc));
+      TM.setIndex(std::array<size_t,3>{{NX,NY,NZ}});
+      ASim.removeAllTally();
+      ASim.addTally(TM);
+      createVTK(IParam,&ASim,FName);
+      ASim.removeAllTally();
+
+      // payload is the last block : big-endian floats + newline
+      std::ifstream IX(FName.c_str(),std::ios::binary);
+      const std::string File((std::istreambuf_iterator<char>(IX)),
+			     std::istreambuf_iterator<char>());
+      IX.close();
+      std::remove(FName.c_str());
+
+      const size_t NPts(NX*NY*NZ);
+      if (File.size()<4*NPts+1)
+	{
+	  ELog::EM<<"VTK file size "<<File.size()<<ELog::endDiag;
+	  return -1;
+	}
+      size_t pos(File.size()-4*NPts-1);
+      int flag(0);
+      for(size_t k=0;k<NZ;k++)
+	for(size_t j=0;j<NY;j++)
+	  for(size_t i=0;i<NX;i++)
+	    {
+	      const unsigned char* CPtr=
+		reinterpret_cast<const unsigned char*>(File.data()+pos);
+	      const uint32_t Item=(static_cast<uint32_t>(CPtr[0])<<24) |
+		(static_cast<uint32_t>(CPtr[1])<<16) |
+		(static_cast<uint32_t>(CPtr[2])<<8) |
+		static_cast<uint32_t>(CPtr[3]);
+	      float LValue;
+	      std::memcpy(&LValue,&Item,4);
+	      pos+=4;
+	      if (std::abs(static_cast<double>(LValue)-PMesh[i][j][k])>1e-6)
+		{
+		  ELog::EM<<"Point["<<i<<"]["<<j<<"]["<<k<<"] == "
+			  <<LValue<<" ("<<PMesh[i][j][k]<<")"<<ELog::endDiag;
+		  flag=1;
+		}
+	    }
+      if (flag)
+	{
+	  ELog::EM<<"Failed on box "<<std::get<0>(tc)<<" : "
+		  <<std::get<1>(tc)<<" ["<<NX<<"]"<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
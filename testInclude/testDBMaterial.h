@@ -36,6 +36,7 @@ private:
 
   //Tests 
   int testCombine();
+  int testSnapshot();
  
 public:
 
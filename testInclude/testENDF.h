@@ -0,0 +1,50 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   testInclude/testENDF.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testENDF_h
+#define testENDF_h 
+
+/*!
+  \class testENDF
+  \brief Tests the ENDF S(alpha,beta) and SE tables
+  \author S. Ansell
+  \date October 2017
+  \version 1.0
+*/
+
+class testENDF
+{
+private:
+
+  //Tests 
+  int testSabBatch();
+  int testSECache();
+
+public:
+  
+  testENDF();
+  ~testENDF();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
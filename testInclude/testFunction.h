@@ -40,6 +40,9 @@ private:
   int testBuiltIn();
   int testCopyVarSet();
   int testEval();
+  int testEvalCache();
+  int testLookup();
+  int testLookupTiming();
   int testString();
   int testVariable();
   int testVec3D();
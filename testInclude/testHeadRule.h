@@ -50,6 +50,7 @@ private:
   int testPartEqual();
   int testRemoveSurf();
   int testReplacePart();
+  int testSubstituteSurf();
   int testSurfSet();
  
 public:
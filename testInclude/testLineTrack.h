@@ -50,7 +50,9 @@ private:
 		  const double) const;
 
   //Tests 
+  int testAttnSum();
   int testLine();
+  int testThreadTrack();
   
 
 public:
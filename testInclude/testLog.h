@@ -38,6 +38,10 @@ private:
 
   //Tests 
   int testENDL();
+  int testRegMethod();
+  int testRegTiming();
+  int testThreadLog();
+  int testTrace();
  
 public:
 
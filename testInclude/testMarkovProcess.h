@@ -1,9 +1,9 @@
 /********************************************************************* 
-  CombLayer : MNCPX Input builder
+  CombLayer : MCNP(X) Input builder
  
- * File:   endfInc/ePrimeFunc.h
-*
- * Copyright (c) 2004-2013 by Stuart Ansell
+ * File:   testInclude/testMarkovProcess.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -19,41 +19,37 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
  *
  ****************************************************************************/
-#ifndef ENDF_ePrimeFunc_h
-#define ENDF_ePrimeFunc_h
-
-namespace ENDF 
-{
+#ifndef testMarkovProcess_h
+#define testMarkovProcess_h 
 
 /*!
-  \class ePrimeFunc
-  \brief Allows integration of the ENDFmaterial ds/dOde
-  \version 1.0
+  \class testMarkovProcess
+  \brief Tests the sparse Markov transfer matrix
   \author S. Ansell
-  \date June 2010
+  \date October 2017
+  \version 1.0
 */
 
-class ePrimeFunc
+class testMarkovProcess
 {
-  private:
+private:
+  
+  Simulation ASim;       ///< Simulation object to build
 
-  const double E;              ///< Energy
-  const double mu;             ///< Mu for calculation
-  const ENDFmaterial& A;       ///< Material object 
+  void initSim();
+  void createSurfaces();
+  void createObjects();
 
- public:
+  //Tests 
+  int testMultiply();
 
-  /// Constructor
-  ePrimeFunc(const ENDFmaterial& EM,const double energy,
-	     const double M) : E(energy),mu(M),A(EM) {}
+public:
+  
+  testMarkovProcess();
+  ~testMarkovProcess();
+  
+  int applyTest(const int);       
 
-  // Output functional
-  double operator()(const double& Eprime)
-    {
-      return A.dSdOdE(E,Eprime,mu);
-    }
 };
 
-} // NAMESPACE ENDF
-
 #endif
@@ -46,14 +46,17 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testAddSurfRule();
   int testCellStr();
   int testComplement();
   int testIsValid();
   int testIsOnSide();
   int testMakeComplement();
   int testRemoveComplement();
+  int testRuleProgram();
   int testSetObject();
   int testSetObjectExtra();
+  int testSideCache();
   int testTrackCell();
 
 public:
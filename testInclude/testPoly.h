@@ -45,10 +45,12 @@ private:
   int testDurandKernerRoots();
   int testEqualTemplate();
   int testExpand();
+  int testFixedRoots();
   int testGetMaxSize();
   int testGetVarFlag();
   int testMinimalReduction();
   int testMultiplication();
+  int testQuarticScale();
   int testRead();
   int testSetComp();
   int testSingleVar();
@@ -47,6 +47,7 @@ private:
   int testMakeCNF();
   int testRemoveComplement();
   int testRuleBinary();
+  int testRulePool();
  
 public:
 
@@ -43,8 +43,14 @@ private:
   void createObjects();
 
   //Tests 
+  int testCalcAllVertex();
+  int testCellBox();
   int testCreateObjSurfMap();
   int testInCell();
+  int testRenumberChain();
+  int testValidThreads();
+  int testWriteMulti();
+  int testWriteThreads();
 
 public:
   
@@ -36,7 +36,11 @@ class testSolveValues
 {
 private:
 
+  std::vector<mathLevel::PolyVar<1> > makeTriplePoly();
+
   //Tests 
+  int testFixedRoots();
+  int testFixedRootsTiming();
   int testGetSolutions();
  
 public:
@@ -39,6 +39,7 @@ private:
   int testCylPlaneIntersect();
   int testMakePoint_Quad();
   int testNearPoint();
+  int testProcessKernel();
   int testProcessPoint();
 
 
@@ -0,0 +1,56 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   testInclude/testVisit.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testVisit_h
+#define testVisit_h 
+
+/*!
+  \class testVisit
+  \brief Tests the Visit mesh and VTK output
+  \author S. Ansell
+  \date October 2017
+  \version 1.0
+*/
+
+class testVisit
+{
+private:
+  
+  Simulation ASim;       ///< Simulation object to build
+
+  void initSim();
+  void createSurfaces();
+  void createObjects();
+
+  //Tests 
+  int testBinaryVTK();
+  int testLineForm();
+
+public:
+  
+  testVisit();
+  ~testVisit();
+  
+  int applyTest(const int);       
+
+};
+
+#endif